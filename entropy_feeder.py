@@ -0,0 +1,489 @@
+#!/usr/bin/env python3
+"""
+rngd-style feeder: Entropy Lab UART output into the Linux kernel pool
+
+A reader thread takes the device stream (raw, or framed with health flags),
+runs continuous health tests on every 512-byte block and queues the blocks
+that pass in a ring. The main thread hands blocks to the kernel with the
+RNDADDENTROPY ioctl (root or CAP_SYS_ADMIN), crediting --credit-ratio bits of
+entropy per bit fed. Continuous tests, per block:
+
+    SP 800-90B 4.4.1 repetition count test    runs of one byte value
+    SP 800-90B 4.4.2 adaptive proportion test  one value over-represented
+    FIPS 140-2 continuous test                 16-byte block equal to the last
+
+The kernel is fed one block whenever /dev/random polls writable (it wants
+entropy) and otherwise every --interval seconds.
+
+    sudo python3 entropy_feeder.py /dev/ttyUSB0 --format framed --credit-ratio 0.5
+    python3 entropy_feeder.py capture.bin --sink checked.bin      # file stand-in, no kernel
+    python3 entropy_feeder.py --test 10 --format framed           # simulated device on a pty
+
+Metrics go to stderr every --stats-interval seconds and, with --metrics-file,
+to a Prometheus textfile-collector file.
+"""
+
+import argparse
+import collections
+import fcntl
+import math
+import os
+import pty
+import select
+import signal
+import stat
+import struct
+import sys
+import termios
+import threading
+import time
+import tty
+
+from frame_decoder import FrameDecoder, encode_frame, FLAGS_UNHEALTHY, MAX_PAYLOAD
+from pull_client import BAUD_RATES
+
+RNDADDENTROPY = 0x40085203  # _IOW('R', 0x03, int[2])
+BLOCK_SIZE = 512            # Health test window and kernel feed unit
+CRNGT_BLOCK = 16            # FIPS 140-2 continuous test compares 128-bit blocks
+ALPHA_EXP = 30              # False positive rate 2^-30 per test, within 800-90B's 2^-20..2^-40
+LATENCY_SAMPLES = 1024      # Fed blocks kept for the latency percentiles
+
+
+def apt_cutoff(window, p, alpha):
+    """1 + CRITBINOM(window, p, 1 - alpha): counts above this have probability < alpha"""
+    tail = 0.0
+    for k in range(window, 0, -1):
+        log_pmf = (math.lgamma(window + 1) - math.lgamma(k + 1) - math.lgamma(window - k + 1) +
+                   k * math.log(p) + (window - k) * math.log1p(-p))
+        tail += math.exp(log_pmf)
+        if tail > alpha:
+            return k + 1
+    return 1
+
+
+class ContinuousTests:
+    """The three continuous tests, state carried across blocks"""
+
+    def __init__(self, min_entropy):
+        self.rct_cutoff = 1 + math.ceil(ALPHA_EXP / min_entropy)
+        self.apt_cutoff = apt_cutoff(BLOCK_SIZE, 2.0 ** -min_entropy, 2.0 ** -ALPHA_EXP)
+        self.last_value = None
+        self.run = 0
+        self.last_block = None
+        self.failures = collections.Counter()
+
+    def check(self, block):
+        """Name of the first test the block fails, or None"""
+        failed = None
+
+        run, value = self.run, self.last_value
+        for byte in block:
+            if byte == value:
+                run += 1
+                if run >= self.rct_cutoff and not failed:
+                    failed = "repetition_count"
+            else:
+                value, run = byte, 1
+        self.run, self.last_value = run, value
+
+        if not failed and block.count(block[0]) >= self.apt_cutoff:
+            failed = "adaptive_proportion"
+
+        previous = self.last_block
+        for offset in range(0, len(block) - CRNGT_BLOCK + 1, CRNGT_BLOCK):
+            current = block[offset:offset + CRNGT_BLOCK]
+            if current == previous and not failed:
+                failed = "continuous_block"
+            previous = current
+        self.last_block = previous
+
+        if failed:
+            self.failures[failed] += 1
+            # A stuck run counts once, not again in every block it spans
+            self.run = 0
+        return failed
+
+
+class Ring:
+    """Fixed-size byte ring with the arrival time of each block, for data age"""
+
+    def __init__(self, capacity):
+        self.buffer = bytearray(capacity)
+        self.capacity = capacity
+        self.head = 0
+        self.fill = 0
+        self.arrivals = collections.deque()  # [arrival time, bytes left]
+        self.closed = False
+        self.overflow_bytes = 0
+        self.cond = threading.Condition()
+
+    def push(self, data, now, block=False):
+        """Queue data; a full ring waits if block, else drops the data"""
+        with self.cond:
+            while block and self.capacity - self.fill < len(data) and not self.closed:
+                self.cond.wait(0.5)
+            if self.capacity - self.fill < len(data):
+                self.overflow_bytes += len(data)
+                return False
+            tail = (self.head + self.fill) % self.capacity
+            first = min(len(data), self.capacity - tail)
+            self.buffer[tail:tail + first] = data[:first]
+            self.buffer[:len(data) - first] = data[first:]
+            self.fill += len(data)
+            self.arrivals.append([now, len(data)])
+            self.cond.notify_all()
+            return True
+
+    def pop(self, size, timeout, partial=False):
+        """Up to size bytes and the arrival time of the oldest; waits for a full
+        block unless partial, returns (b"", None) on timeout"""
+        deadline = time.monotonic() + timeout
+        with self.cond:
+            while self.fill < (1 if partial else size) and not self.closed:
+                remaining = deadline - time.monotonic()
+                if remaining <= 0:
+                    return b"", None
+                self.cond.wait(remaining)
+            size = min(size, self.fill)
+            if not size:
+                return b"", None
+            first = min(size, self.capacity - self.head)
+            data = bytes(self.buffer[self.head:self.head + first]) + bytes(self.buffer[:size - first])
+            self.head = (self.head + size) % self.capacity
+            self.fill -= size
+
+            oldest = self.arrivals[0][0]
+            taken = size
+            while taken:
+                entry = self.arrivals[0]
+                step = min(taken, entry[1])
+                entry[1] -= step
+                taken -= step
+                if not entry[1]:
+                    self.arrivals.popleft()
+            self.cond.notify_all()
+            return data, oldest
+
+    def close(self):
+        with self.cond:
+            self.closed = True
+            self.cond.notify_all()
+
+
+class Metrics:
+    """Counters shared by the reader and feeder, plus latency samples"""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.start = time.monotonic()
+        self.bytes_read = 0
+        self.bytes_fed = 0
+        self.bits_credited = 0
+        self.blocks_passed = 0
+        self.blocks_rejected = 0
+        self.flagged_bytes_dropped = 0
+        self.feed_calls = 0
+        self.feed_errors = 0
+        self.data_age = collections.deque(maxlen=LATENCY_SAMPLES)  # Arrival to kernel, seconds
+        self.feed_time = collections.deque(maxlen=LATENCY_SAMPLES)  # Inside the ioctl, seconds
+        self.last_report = (self.start, 0, 0)
+
+    def fed(self, length, bits, age, took):
+        with self.lock:
+            self.bytes_fed += length
+            self.bits_credited += bits
+            self.feed_calls += 1
+            self.data_age.append(age)
+            self.feed_time.append(took)
+
+    @staticmethod
+    def percentile(samples, fraction):
+        if not samples:
+            return 0.0
+        ordered = sorted(samples)
+        return ordered[min(len(ordered) - 1, int(fraction * len(ordered)))]
+
+    def snapshot(self, ring, tests, decoder):
+        with self.lock:
+            now = time.monotonic()
+            last_time, last_read, last_fed = self.last_report
+            span = max(now - last_time, 1e-9)
+            values = {
+                "uptime_seconds": now - self.start,
+                "read_bytes_total": self.bytes_read,
+                "fed_bytes_total": self.bytes_fed,
+                "credited_bits_total": self.bits_credited,
+                "read_bytes_per_second": (self.bytes_read - last_read) / span,
+                "fed_bytes_per_second": (self.bytes_fed - last_fed) / span,
+                "blocks_passed_total": self.blocks_passed,
+                "blocks_rejected_total": self.blocks_rejected,
+                "flagged_bytes_dropped_total": self.flagged_bytes_dropped,
+                "feed_calls_total": self.feed_calls,
+                "feed_errors_total": self.feed_errors,
+                "data_age_p50_seconds": self.percentile(self.data_age, 0.5),
+                "data_age_p99_seconds": self.percentile(self.data_age, 0.99),
+                "feed_latency_p50_seconds": self.percentile(self.feed_time, 0.5),
+                "feed_latency_p99_seconds": self.percentile(self.feed_time, 0.99),
+                "ring_fill_bytes": ring.fill,
+                "ring_overflow_bytes_total": ring.overflow_bytes,
+            }
+            self.last_report = (now, self.bytes_read, self.bytes_fed)
+        for name, count in tests.failures.items():
+            values[f"test_failures_total{{test=\"{name}\"}}"] = count
+        if decoder:
+            values["frames_total"] = decoder.frames
+            values["frames_lost_total"] = decoder.lost_frames
+            values["frame_crc_errors_total"] = decoder.crc_errors
+        return values
+
+
+def open_device(path, baud):
+    """Raw 8N1 for a tty; pipes, files and '-' are read as they are"""
+    if path == "-":
+        return sys.stdin.fileno()
+    fd = os.open(path, os.O_RDONLY | os.O_NOCTTY)
+    if os.isatty(fd):
+        tty.setraw(fd)
+        attrs = termios.tcgetattr(fd)
+        attrs[4] = attrs[5] = BAUD_RATES.get(baud, termios.B115200)
+        attrs[2] |= termios.CLOCAL | termios.CREAD
+        termios.tcsetattr(fd, termios.TCSANOW, attrs)
+        termios.tcflush(fd, termios.TCIFLUSH)
+    return fd
+
+
+def reader(fd, framed, accept_flagged, tests, ring, metrics, decoder, stop):
+    """Device bytes to checked blocks in the ring, until EOF or stop"""
+    # A regular file can wait for the feeder; a live device cannot, so a full ring drops
+    block_when_full = stat.S_ISREG(os.fstat(fd).st_mode)
+    pending = bytearray()
+    while not stop.is_set():
+        ready, _, _ = select.select([fd], [], [], 0.5)
+        if not ready:
+            continue
+        try:
+            chunk = os.read(fd, 4096)
+        except OSError:
+            chunk = b""  # A pty reports EIO once the other end has gone
+        if not chunk:
+            break
+        now = time.monotonic()
+        with metrics.lock:
+            metrics.bytes_read += len(chunk)
+
+        if framed:
+            for frame in decoder.feed(chunk):
+                # The device flags frames made while a source was failing its own health tests
+                if frame.flags & FLAGS_UNHEALTHY and not accept_flagged:
+                    with metrics.lock:
+                        metrics.flagged_bytes_dropped += len(frame.payload)
+                    continue
+                pending.extend(frame.payload)
+        else:
+            pending.extend(chunk)
+
+        while len(pending) >= BLOCK_SIZE:
+            block = bytes(pending[:BLOCK_SIZE])
+            del pending[:BLOCK_SIZE]
+            passed = tests.check(block) is None
+            with metrics.lock:
+                if passed:
+                    metrics.blocks_passed += 1
+                else:
+                    metrics.blocks_rejected += 1
+            if passed:
+                ring.push(block, now, block=block_when_full)
+    ring.close()
+
+
+def add_entropy(fd, data, bits):
+    """struct rand_pool_info {int entropy_count; int buf_size; __u32 buf[];}"""
+    fcntl.ioctl(fd, RNDADDENTROPY, struct.pack("ii", bits, len(data)) + data)
+
+
+def simulate_device(master_fd, framed, baud, stuck_every, stop):
+    """Test stand-in: random bytes paced to baud, with a stuck run every stuck_every blocks"""
+    seq = 0
+    blocks = 0
+    byte_time = 10.0 / baud  # 8N1
+    next_time = time.monotonic()
+    while not stop.is_set():
+        payload = bytearray(os.urandom(MAX_PAYLOAD))
+        blocks += 1
+        if stuck_every and blocks % stuck_every == 0:
+            payload[100:164] = bytes(64)
+        data = encode_frame(seq, 0, bytes(payload)) if framed else bytes(payload)
+        seq += 1
+        try:
+            os.write(master_fd, data)
+        except OSError:
+            return
+        next_time += len(data) * byte_time
+        delay = next_time - time.monotonic()
+        if delay > 0:
+            time.sleep(delay)
+
+
+def write_metrics_file(path, values):
+    """Prometheus textfile format, replaced atomically"""
+    lines = [f"entropylab_feeder_{name} {value:.6g}" for name, value in values.items()]
+    tmp = path + ".tmp"
+    with open(tmp, "w") as f:
+        f.write("\n".join(lines) + "\n")
+    os.replace(tmp, path)
+
+
+def report(values):
+    print(f"read {values['read_bytes_per_second']:.0f} B/s, fed {values['fed_bytes_per_second']:.0f} B/s "
+          f"({values['fed_bytes_total']} bytes, {values['credited_bits_total']} bits credited), "
+          f"blocks {values['blocks_passed_total']} ok / {values['blocks_rejected_total']} rejected, "
+          f"ring {values['ring_fill_bytes']} B, "
+          f"age p50 {values['data_age_p50_seconds'] * 1000:.1f} ms p99 {values['data_age_p99_seconds'] * 1000:.1f} ms, "
+          f"ioctl p99 {values['feed_latency_p99_seconds'] * 1e6:.0f} us", file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Feed Entropy Lab output into the Linux entropy pool")
+    parser.add_argument("device", nargs="?", help="serial device, pty, capture file, or - for stdin")
+    parser.add_argument("-b", "--baud", type=int, default=115200, help="serial baud rate")
+    parser.add_argument("-f", "--format", choices=["raw", "framed"], default="raw",
+                        help="device UART Format setting")
+    parser.add_argument("-c", "--credit-ratio", type=float, default=0.5,
+                        help="entropy bits credited per bit fed, 0 to 1 (default 0.5)")
+    parser.add_argument("-H", "--min-entropy", type=float, default=7.0,
+                        help="assumed min-entropy per byte for the health test cutoffs (default 7)")
+    parser.add_argument("-r", "--ring-size", type=int, default=1 << 20, help="ring capacity in bytes")
+    parser.add_argument("-i", "--interval", type=float, default=1.0,
+                        help="seconds between feeds while the kernel is not asking")
+    parser.add_argument("--accept-flagged", action="store_true",
+                        help="feed framed payload the device flagged as unhealthy")
+    parser.add_argument("--sink", help="write checked blocks here instead of the kernel (test mode)")
+    parser.add_argument("--test", type=float, metavar="SECONDS",
+                        help="run against a simulated device on a pty for this long")
+    parser.add_argument("--stats-interval", type=float, default=10.0, help="seconds between stderr reports")
+    parser.add_argument("--metrics-file", help="Prometheus textfile to rewrite every report")
+    args = parser.parse_args()
+
+    if not 0.0 <= args.credit_ratio <= 1.0:
+        parser.error("--credit-ratio must be between 0 and 1")
+    if not 0.0 < args.min_entropy <= 8.0:
+        parser.error("--min-entropy must be in (0, 8]")
+    if args.ring_size < BLOCK_SIZE:
+        parser.error(f"--ring-size must be at least {BLOCK_SIZE}")
+    if not args.device and args.test is None:
+        parser.error("a device is required unless --test is given")
+
+    stop = threading.Event()
+    signal.signal(signal.SIGTERM, lambda *_: stop.set())
+    signal.signal(signal.SIGINT, lambda *_: stop.set())
+
+    framed = args.format == "framed"
+    simulator = None
+    if args.test is not None:
+        # The simulator drives the master, the feeder reads the slave like a serial port
+        master_fd, slave_fd = pty.openpty()
+        tty.setraw(slave_fd)
+        simulator = threading.Thread(target=simulate_device,
+                                     args=(master_fd, framed, args.baud, 50, stop), daemon=True)
+        fd = slave_fd
+        deadline = time.monotonic() + args.test
+    else:
+        fd = open_device(args.device, args.baud)
+        deadline = None
+
+    sink = None
+    random_fd = None
+    if args.sink:
+        sink = sys.stdout.buffer if args.sink == "-" else open(args.sink, "wb")
+    elif args.test is None:
+        try:
+            random_fd = os.open("/dev/random", os.O_RDWR)
+        except OSError as e:
+            print(f"Error: cannot open /dev/random: {e}", file=sys.stderr)
+            return 1
+
+    tests = ContinuousTests(args.min_entropy)
+    ring = Ring(args.ring_size)
+    metrics = Metrics()
+    decoder = FrameDecoder() if framed else None
+    print(f"health test cutoffs: repetition {tests.rct_cutoff}, "
+          f"adaptive proportion {tests.apt_cutoff}/{BLOCK_SIZE} at H={args.min_entropy}", file=sys.stderr)
+
+    reader_thread = threading.Thread(target=reader, daemon=True,
+                                     args=(fd, framed, args.accept_flagged, tests, ring, metrics, decoder, stop))
+    reader_thread.start()
+    if simulator:
+        simulator.start()
+
+    next_report = time.monotonic() + args.stats_interval
+    status = 0
+    try:
+        while not stop.is_set():
+            if deadline and time.monotonic() >= deadline:
+                break
+            if random_fd is None:
+                # Sink or test: take every block as soon as it is checked
+                data, oldest = ring.pop(BLOCK_SIZE, 0.5)
+            else:
+                # Feed when the kernel asks for entropy, and otherwise once per interval
+                poller = select.poll()
+                poller.register(random_fd, select.POLLOUT)
+                poller.poll(args.interval * 1000)
+                data, oldest = ring.pop(BLOCK_SIZE, 0.0, partial=True)
+
+            if data:
+                bits = int(len(data) * 8 * args.credit_ratio)
+                start = time.monotonic()
+                try:
+                    if random_fd is not None:
+                        add_entropy(random_fd, data, bits)
+                    elif sink:
+                        sink.write(data)
+                    metrics.fed(len(data), bits, start - oldest, time.monotonic() - start)
+                except OSError as e:
+                    with metrics.lock:
+                        metrics.feed_errors += 1
+                    if random_fd is not None and metrics.feed_errors == 1:
+                        print(f"RNDADDENTROPY failed: {e} (needs root or CAP_SYS_ADMIN)", file=sys.stderr)
+                        status = 1
+                        break
+            elif ring.closed:
+                break
+
+            if time.monotonic() >= next_report:
+                values = metrics.snapshot(ring, tests, decoder)
+                report(values)
+                if args.metrics_file:
+                    write_metrics_file(args.metrics_file, values)
+                next_report += args.stats_interval
+    finally:
+        stop.set()
+        ring.close()
+        reader_thread.join(1.0)
+        if simulator:
+            simulator.join(1.0)
+        if sink and sink is not sys.stdout.buffer:
+            sink.close()
+        if random_fd is not None:
+            os.close(random_fd)
+
+    # Final report: rates over the whole run
+    metrics.last_report = (metrics.start, 0, 0)
+    values = metrics.snapshot(ring, tests, decoder)
+    report(values)
+    if args.metrics_file:
+        write_metrics_file(args.metrics_file, values)
+    if decoder:
+        print(decoder.summary(), file=sys.stderr)
+    if tests.failures:
+        print("continuous test failures: " +
+              ", ".join(f"{name} {count}" for name, count in sorted(tests.failures.items())), file=sys.stderr)
+    if args.test is not None and not (values["fed_bytes_total"] and tests.failures):
+        # The simulator injects stuck runs, so a healthy test run both feeds and rejects
+        print("test mode: expected both fed bytes and rejected stuck runs", file=sys.stderr)
+        status = 1
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,687 @@
+#!/usr/bin/env python3
+"""
+Local entropy server: one process owns the Entropy Lab serial port and shares
+its output with any number of local clients over a Unix domain socket
+
+A source thread reads the device (raw, framed or pull), runs the same
+continuous health tests as entropy_feeder.py on every 512-byte block and
+fills a large in-memory reservoir. A single-threaded epoll loop answers
+clients, sending straight out of the reservoir with sendmsg() (no copy in
+this process, the ring's two halves as two iovecs). Every byte goes to
+exactly one client.
+
+Protocol, all integers little-endian:
+
+    request   [command u8][count u32]
+    response  [status u8][length u32] then length bytes
+
+    READ      wait for count bytes (count <= 1 MiB); they may arrive in pieces
+    TRY_READ  answer at once with what can be spared, status LOW when the
+              reservoir is under its low-water mark
+    STATS     length bytes of JSON
+
+Backpressure when the reservoir runs low: TRY_READ gets nothing, idle clients'
+sockets are not read (new requests wait in the kernel), and pending READs are
+served a quantum at a time in turn so no client starves the rest. In pull
+format the device is only asked for more while the reservoir is below its
+high-water mark.
+
+    python3 entropy_server.py /dev/ttyUSB0 -f framed -b 921600
+    python3 entropy_server.py --test 10 --clients 300     # simulated device, 300 client threads
+
+Clients: EntropyClient below, or --socket in viz.py, hex_art.py and test_rng.py.
+"""
+
+import argparse
+import collections
+import errno
+import json
+import os
+import pty
+import random
+import select
+import selectors
+import signal
+import socket
+import stat
+import struct
+import sys
+import threading
+import time
+import tty
+
+from entropy_feeder import BLOCK_SIZE, ContinuousTests, Metrics, open_device, simulate_device
+from frame_decoder import FrameDecoder, FLAGS_UNHEALTHY
+from pull_client import PullClient, PullError
+
+DEFAULT_SOCKET = os.path.join(os.environ.get("XDG_RUNTIME_DIR", "/tmp"), "entropylab.sock")
+
+REQUEST = struct.Struct("<BI")
+RESPONSE = struct.Struct("<BI")
+
+CMD_READ = 0x01
+CMD_TRY_READ = 0x02
+CMD_STATS = 0x03
+
+STATUS_OK = 0
+STATUS_LOW = 1  # TRY_READ under the low-water mark: length is 0
+STATUS_BAD = 2  # Unknown command or count over MAX_REQUEST
+
+MAX_REQUEST = 1 << 20
+QUANTUM = 4096           # Bytes per client per turn while others are waiting
+PULL_CHUNK = 16384       # Bytes per pull request to the device
+LATENCY_SAMPLES = 4096   # Completed READs kept for the latency percentiles
+
+
+class Reservoir:
+    """Single-producer, single-consumer ring; the consumer sends from it in place"""
+
+    def __init__(self, capacity, low_water, high_water):
+        self.buffer = bytearray(capacity)
+        self.view = memoryview(self.buffer)
+        self.capacity = capacity
+        self.low_water = low_water
+        self.high_water = high_water
+        self.head = 0
+        self.fill = 0
+        self.overflow_bytes = 0
+        self.cond = threading.Condition()
+
+    @property
+    def low(self):
+        return self.fill < self.low_water
+
+    def push(self, data):
+        """Producer side: all of data or, when it does not fit, none of it"""
+        with self.cond:
+            if self.capacity - self.fill < len(data):
+                self.overflow_bytes += len(data)
+                return False
+            tail = (self.head + self.fill) % self.capacity
+        # Only the producer writes the free region, so the copy needs no lock
+        first = min(len(data), self.capacity - tail)
+        self.buffer[tail:tail + first] = data[:first]
+        self.buffer[:len(data) - first] = data[first:]
+        with self.cond:
+            self.fill += len(data)
+        return True
+
+    def wait_for_space(self, size, stop):
+        """Producer side, pull format: block until under the high-water mark with room for size"""
+        with self.cond:
+            while not stop.is_set() and (self.fill >= self.high_water or self.capacity - self.fill < size):
+                self.cond.wait(0.5)
+            return self.capacity - self.fill
+
+    def peek(self, size):
+        """Consumer side: up to size bytes as one or two views into the ring"""
+        with self.cond:
+            size = min(size, self.fill)
+            head = self.head
+        first = min(size, self.capacity - head)
+        views = [self.view[head:head + first]]
+        if size > first:
+            views.append(self.view[:size - first])
+        return views, size
+
+    def consume(self, size):
+        with self.cond:
+            self.head = (self.head + size) % self.capacity
+            self.fill -= size
+            self.cond.notify_all()
+
+
+class Client:
+    def __init__(self, sock):
+        self.sock = sock
+        self.inbuf = bytearray()
+        self.header = b""     # Response header still to send
+        self.remaining = 0    # READ bytes still owed
+        self.started = 0.0
+        self.blocked = False  # Socket buffer full, waiting for EVENT_WRITE
+        self.events = 0
+
+    @property
+    def busy(self):
+        return bool(self.header) or self.remaining > 0
+
+
+class EntropyServer:
+    def __init__(self, path, reservoir, tests, source_stats, mode):
+        self.path = path
+        self.reservoir = reservoir
+        self.tests = tests
+        self.source_stats = source_stats
+        self.selector = selectors.DefaultSelector()
+        self.clients = {}
+        self.waiting = collections.deque()  # Clients owed READ bytes, served in turn
+        self.start = time.monotonic()
+        self.requests = collections.Counter()
+        self.bytes_served = 0
+        self.clients_total = 0
+        self.peak_clients = 0
+        self.latency = collections.deque(maxlen=LATENCY_SAMPLES)
+        self.was_low = False
+
+        self.listener = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.listener.bind(path)
+        os.chmod(path, mode)
+        self.listener.listen(1024)
+        self.listener.setblocking(False)
+        self.selector.register(self.listener, selectors.EVENT_READ)
+
+        # The source thread writes a byte here after filling, to wake waiting clients
+        self.wake_r, self.wake_w = os.pipe()
+        os.set_blocking(self.wake_r, False)
+        os.set_blocking(self.wake_w, False)
+        self.selector.register(self.wake_r, selectors.EVENT_READ)
+
+    def wake(self):
+        try:
+            os.write(self.wake_w, b"\0")
+        except OSError:
+            pass  # Already pending, or the server has shut down
+
+    def close(self):
+        for client in list(self.clients.values()):
+            self.drop(client)
+        self.selector.close()
+        self.listener.close()
+        os.close(self.wake_r)
+        os.close(self.wake_w)
+        try:
+            os.unlink(self.path)
+        except FileNotFoundError:
+            pass
+
+    def set_events(self, client, events):
+        if events == client.events:
+            return
+        if not client.events:
+            self.selector.register(client.sock, events, client)
+        elif not events:
+            self.selector.unregister(client.sock)
+        else:
+            self.selector.modify(client.sock, events, client)
+        client.events = events
+
+    def update_events(self, client):
+        if client.blocked:
+            events = selectors.EVENT_WRITE
+        elif client.busy or self.reservoir.low:
+            # One request at a time, and none at all while the reservoir is low
+            events = 0
+        else:
+            events = selectors.EVENT_READ
+        self.set_events(client, events)
+
+    def drop(self, client):
+        self.set_events(client, 0)
+        self.clients.pop(client.sock.fileno(), None)
+        client.remaining = 0
+        client.sock.close()
+
+    def accept(self):
+        while True:
+            try:
+                sock, _ = self.listener.accept()
+            except (BlockingIOError, InterruptedError):
+                return
+            except OSError as e:
+                if e.errno in (errno.EMFILE, errno.ENFILE):
+                    print(f"entropy_server: out of file descriptors ({len(self.clients)} clients)", file=sys.stderr)
+                    return
+                raise
+            sock.setblocking(False)
+            client = Client(sock)
+            self.clients[sock.fileno()] = client
+            self.clients_total += 1
+            self.peak_clients = max(self.peak_clients, len(self.clients))
+            self.update_events(client)
+
+    def receive(self, client):
+        try:
+            data = client.sock.recv(64)
+        except (BlockingIOError, InterruptedError):
+            return
+        except OSError:
+            data = b""
+        if not data:
+            self.drop(client)
+            return
+        client.inbuf.extend(data)
+        self.next_request(client)
+
+    def next_request(self, client):
+        """Start the next buffered request once the client is idle; pipelined
+        requests wait in inbuf until the one before them is answered"""
+        if client.busy or client.blocked or self.reservoir.low:
+            return
+        if client.sock.fileno() < 0 or len(client.inbuf) < REQUEST.size:
+            return
+        command, count = REQUEST.unpack_from(client.inbuf)
+        del client.inbuf[:REQUEST.size]
+        self.handle(client, command, count)
+
+    def handle(self, client, command, count):
+        self.requests[command] += 1
+        if command == CMD_READ and count <= MAX_REQUEST:
+            client.header = RESPONSE.pack(STATUS_OK, count)
+            client.remaining = count
+            client.started = time.monotonic()
+            self.waiting.append(client)
+        elif command == CMD_TRY_READ and count <= MAX_REQUEST:
+            if self.reservoir.low:
+                client.header = RESPONSE.pack(STATUS_LOW, 0)
+            else:
+                # Never dig into the reserve kept for blocking readers
+                spare = self.reservoir.fill - self.reservoir.low_water
+                count = min(count, spare)
+                client.header = RESPONSE.pack(STATUS_OK, count)
+                client.remaining = count
+                client.started = time.monotonic()
+            self.waiting.append(client)
+        elif command == CMD_STATS:
+            payload = json.dumps(self.stats()).encode()
+            client.header = RESPONSE.pack(STATUS_OK, len(payload)) + payload
+            self.waiting.append(client)
+        else:
+            client.header = RESPONSE.pack(STATUS_BAD, 0)
+            self.waiting.append(client)
+        self.update_events(client)
+
+    def send(self, client):
+        """One turn for a client: its header, then up to a quantum from the reservoir.
+        False once the reservoir has nothing left for it"""
+        try:
+            if client.header:
+                sent = client.sock.send(client.header)
+                client.header = client.header[sent:]
+                if client.header:
+                    client.blocked = True
+                    return True
+            if client.remaining:
+                # Only share out in quanta when someone else is also waiting
+                limit = client.remaining if len(self.waiting) <= 1 else min(client.remaining, QUANTUM)
+                views, size = self.reservoir.peek(limit)
+                if not size:
+                    return False
+                sent = client.sock.sendmsg(views)
+                for view in views:
+                    view.release()
+                self.reservoir.consume(sent)
+                self.bytes_served += sent
+                client.remaining -= sent
+                if sent < size:
+                    client.blocked = True
+                    return True
+                if not client.remaining:
+                    self.latency.append(time.monotonic() - client.started)
+            return True
+        except (BlockingIOError, InterruptedError):
+            client.blocked = True
+            return True
+        except OSError:
+            self.drop(client)
+            return True
+
+    def serve(self):
+        """Round-robin over waiting clients until each is done, blocked or starved"""
+        progress = True
+        while self.waiting and progress:
+            progress = False
+            for _ in range(len(self.waiting)):
+                client = self.waiting.popleft()
+                if client.sock.fileno() < 0 or client.blocked:
+                    continue
+                if not self.send(client):
+                    self.waiting.append(client)
+                    continue
+                if client.sock.fileno() < 0:
+                    continue
+                if client.busy and not client.blocked:
+                    self.waiting.append(client)
+                progress = True
+                self.update_events(client)
+                self.next_request(client)
+
+    def run(self, stop, deadline=None, report_interval=10.0):
+        next_report = time.monotonic() + report_interval
+        while not stop.is_set():
+            if deadline and time.monotonic() >= deadline:
+                break
+            for key, events in self.selector.select(0.5):
+                if key.fileobj is self.listener:
+                    self.accept()
+                elif key.fileobj == self.wake_r:
+                    try:
+                        os.read(self.wake_r, 4096)
+                    except BlockingIOError:
+                        pass
+                else:
+                    client = key.data
+                    if events & selectors.EVENT_WRITE:
+                        client.blocked = False
+                        self.waiting.append(client)
+                        self.update_events(client)
+                    if events & selectors.EVENT_READ and client.sock.fileno() >= 0:
+                        self.receive(client)
+            self.serve()
+
+            # Leaving the low state: idle clients may send requests again
+            low = self.reservoir.low
+            if low != self.was_low:
+                self.was_low = low
+                for client in list(self.clients.values()):
+                    self.update_events(client)
+                    self.next_request(client)
+
+            if time.monotonic() >= next_report:
+                self.report()
+                next_report += report_interval
+
+    def stats(self):
+        latency = sorted(self.latency)
+
+        def percentile(fraction):
+            return latency[min(len(latency) - 1, int(fraction * len(latency)))] if latency else 0.0
+
+        source = self.source_stats
+        with source.lock:
+            values = {
+                "uptime_seconds": time.monotonic() - self.start,
+                "clients": len(self.clients),
+                "clients_peak": self.peak_clients,
+                "clients_total": self.clients_total,
+                "waiting_clients": len(self.waiting),
+                "requests": {name: self.requests[cmd] for name, cmd in
+                             (("read", CMD_READ), ("try_read", CMD_TRY_READ), ("stats", CMD_STATS))},
+                "bytes_served": self.bytes_served,
+                "bytes_read": source.bytes_read,
+                "blocks_passed": source.blocks_passed,
+                "blocks_rejected": source.blocks_rejected,
+                "flagged_bytes_dropped": source.flagged_bytes_dropped,
+                "test_failures": dict(self.tests.failures),
+                "reservoir_fill": self.reservoir.fill,
+                "reservoir_capacity": self.reservoir.capacity,
+                "reservoir_low": self.reservoir.low,
+                "reservoir_overflow_bytes": self.reservoir.overflow_bytes,
+                "read_latency_p50_seconds": percentile(0.5),
+                "read_latency_p99_seconds": percentile(0.99),
+            }
+        return values
+
+    def report(self):
+        s = self.stats()
+        print(f"{s['clients']} clients (peak {s['clients_peak']}), {s['bytes_served']} bytes served, "
+              f"reservoir {s['reservoir_fill']}/{s['reservoir_capacity']}{' LOW' if s['reservoir_low'] else ''}, "
+              f"blocks {s['blocks_passed']} ok / {s['blocks_rejected']} rejected, "
+              f"READ p50 {s['read_latency_p50_seconds'] * 1000:.1f} ms p99 {s['read_latency_p99_seconds'] * 1000:.1f} ms",
+              file=sys.stderr)
+
+
+def accept_blocks(data, pending, tests, reservoir, stats, server):
+    """Health-test whole blocks out of pending and move the passing ones into the reservoir"""
+    pending.extend(data)
+    pushed = False
+    while len(pending) >= BLOCK_SIZE:
+        block = bytes(pending[:BLOCK_SIZE])
+        del pending[:BLOCK_SIZE]
+        passed = tests.check(block) is None
+        with stats.lock:
+            if passed:
+                stats.blocks_passed += 1
+            else:
+                stats.blocks_rejected += 1
+        if passed:
+            pushed |= reservoir.push(block)
+    if pushed:
+        server.wake()
+
+
+def stream_source(fd, framed, tests, reservoir, stats, server, stop):
+    """Raw or framed device output; the device does not wait, so a full reservoir drops"""
+    decoder = FrameDecoder() if framed else None
+    pending = bytearray()
+    while not stop.is_set():
+        ready, _, _ = select.select([fd], [], [], 0.5)
+        if not ready:
+            continue
+        try:
+            chunk = os.read(fd, 4096)
+        except OSError:
+            chunk = b""
+        if not chunk:
+            break
+        with stats.lock:
+            stats.bytes_read += len(chunk)
+        if framed:
+            data = bytearray()
+            for frame in decoder.feed(chunk):
+                if frame.flags & FLAGS_UNHEALTHY:
+                    with stats.lock:
+                        stats.flagged_bytes_dropped += len(frame.payload)
+                    continue
+                data.extend(frame.payload)
+            chunk = data
+        accept_blocks(chunk, pending, tests, reservoir, stats, server)
+    stop.set()
+
+
+def pull_source(path, baud, tests, reservoir, stats, server, stop):
+    """Pull format: ask the device for more only while the reservoir is under high water"""
+    pending = bytearray()
+    try:
+        with PullClient(path, baud) as client:
+            while not stop.is_set():
+                room = reservoir.wait_for_space(PULL_CHUNK, stop)
+                if stop.is_set():
+                    break
+                data = client.read(min(PULL_CHUNK, room))
+                with stats.lock:
+                    stats.bytes_read += len(data)
+                    if client.last_flags & FLAGS_UNHEALTHY:
+                        stats.flagged_bytes_dropped += len(data)
+                        continue
+                accept_blocks(data, pending, tests, reservoir, stats, server)
+    except (OSError, PullError) as e:
+        print(f"entropy_server: pull source stopped: {e}", file=sys.stderr)
+    stop.set()
+
+
+class EntropyClient:
+    """Blocking client; read() behaves like serial.Serial.read() for the existing tools"""
+
+    def __init__(self, path=DEFAULT_SOCKET, timeout=None):
+        self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.sock.settimeout(timeout)
+        self.sock.connect(path)
+
+    def close(self):
+        self.sock.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def _recv_exact(self, size):
+        data = bytearray()
+        while len(data) < size:
+            chunk = self.sock.recv(size - len(data))
+            if not chunk:
+                raise ConnectionError("entropy server closed the connection")
+            data.extend(chunk)
+        return bytes(data)
+
+    def _request(self, command, count):
+        self.sock.sendall(REQUEST.pack(command, count))
+        status, length = RESPONSE.unpack(self._recv_exact(RESPONSE.size))
+        if status == STATUS_BAD:
+            raise ValueError(f"entropy server rejected command {command} count {count}")
+        return status, self._recv_exact(length)
+
+    def read(self, count):
+        """Exactly count random bytes, waiting for the reservoir if need be"""
+        data = bytearray()
+        while len(data) < count:
+            _, chunk = self._request(CMD_READ, min(count - len(data), MAX_REQUEST))
+            data.extend(chunk)
+        return bytes(data)
+
+    def try_read(self, count):
+        """Up to count bytes without waiting; empty while the reservoir is low"""
+        return self._request(CMD_TRY_READ, min(count, MAX_REQUEST))[1]
+
+    def stats(self):
+        return json.loads(self._request(CMD_STATS, 0)[1])
+
+
+def claim_socket(path):
+    """Remove a stale socket file; refuse if another server is answering on it"""
+    if not os.path.exists(path):
+        return True
+    if not stat.S_ISSOCK(os.stat(path).st_mode):
+        return False
+    probe = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    try:
+        probe.connect(path)
+        return False
+    except OSError:
+        os.unlink(path)
+        return True
+    finally:
+        probe.close()
+
+
+def test_clients(path, count, stop, results):
+    """Stand-in clients: random-sized READs, a few TRY_READs, until stopped"""
+    def run(rng):
+        try:
+            with EntropyClient(path, timeout=30) as client:
+                while not stop.is_set():
+                    size = rng.choice((32, 64, 256, 1024, 4096))
+                    start = time.monotonic()
+                    if rng.random() < 0.1:
+                        data = client.try_read(size)
+                        ok = len(data) <= size
+                    else:
+                        data = client.read(size)
+                        ok = len(data) == size
+                    with results["lock"]:
+                        results["requests"] += 1
+                        results["bytes"] += len(data)
+                        results["errors"] += not ok
+                        results["latency"].append(time.monotonic() - start)
+        except OSError as e:
+            with results["lock"]:
+                results["errors"] += 1
+                results["failures"].append(str(e))
+
+    threads = [threading.Thread(target=run, args=(random.Random(i),), daemon=True) for i in range(count)]
+    for thread in threads:
+        thread.start()
+    return threads
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Share Entropy Lab output with local clients over a Unix socket")
+    parser.add_argument("device", nargs="?", help="serial device, pty, capture file, or - for stdin")
+    parser.add_argument("-b", "--baud", type=int, default=115200, help="serial baud rate")
+    parser.add_argument("-f", "--format", choices=["raw", "framed", "pull"], default="raw",
+                        help="device UART Format setting")
+    parser.add_argument("-s", "--socket", default=DEFAULT_SOCKET, help=f"socket path (default {DEFAULT_SOCKET})")
+    parser.add_argument("--mode", type=lambda v: int(v, 8), default=0o660, help="socket permissions (octal)")
+    parser.add_argument("-r", "--reservoir", type=int, default=4 << 20, help="reservoir size in bytes")
+    parser.add_argument("--low-water", type=float, default=0.0625,
+                        help="fraction of the reservoir below which backpressure applies")
+    parser.add_argument("--high-water", type=float, default=0.9,
+                        help="fraction of the reservoir pull format tops up to")
+    parser.add_argument("-H", "--min-entropy", type=float, default=7.0,
+                        help="assumed min-entropy per byte for the health test cutoffs")
+    parser.add_argument("--stats-interval", type=float, default=10.0, help="seconds between stderr reports")
+    parser.add_argument("--test", type=float, metavar="SECONDS",
+                        help="run against a simulated device on a pty with --clients client threads")
+    parser.add_argument("--clients", type=int, default=100, help="client threads in --test")
+    args = parser.parse_args()
+
+    if args.reservoir < 4 * BLOCK_SIZE:
+        parser.error(f"--reservoir must be at least {4 * BLOCK_SIZE}")
+    if not 0.0 <= args.low_water < args.high_water <= 1.0:
+        parser.error("need 0 <= --low-water < --high-water <= 1")
+    if not args.device and args.test is None:
+        parser.error("a device is required unless --test is given")
+    if args.test is not None and args.format == "pull":
+        parser.error("--test simulates raw or framed output only")
+    if not claim_socket(args.socket):
+        print(f"Error: {args.socket} is in use by another server or is not a socket", file=sys.stderr)
+        return 1
+
+    stop = threading.Event()
+    signal.signal(signal.SIGTERM, lambda *_: stop.set())
+    signal.signal(signal.SIGINT, lambda *_: stop.set())
+
+    reservoir = Reservoir(args.reservoir, int(args.reservoir * args.low_water), int(args.reservoir * args.high_water))
+    tests = ContinuousTests(args.min_entropy)
+    source_stats = Metrics()
+    server = EntropyServer(args.socket, reservoir, tests, source_stats, args.mode)
+    framed = args.format == "framed"
+
+    simulator = None
+    deadline = None
+    if args.test is not None:
+        master_fd, slave_fd = pty.openpty()
+        tty.setraw(slave_fd)
+        baud = args.baud if args.baud != 115200 else 4000000  # Enough to keep hundreds of clients busy
+        simulator = threading.Thread(target=simulate_device,
+                                     args=(master_fd, framed, baud, 0, stop), daemon=True)
+        source = threading.Thread(target=stream_source, daemon=True,
+                                  args=(slave_fd, framed, tests, reservoir, source_stats, server, stop))
+        deadline = time.monotonic() + args.test
+    elif args.format == "pull":
+        source = threading.Thread(target=pull_source, daemon=True,
+                                  args=(args.device, args.baud, tests, reservoir, source_stats, server, stop))
+    else:
+        fd = open_device(args.device, args.baud)
+        source = threading.Thread(target=stream_source, daemon=True,
+                                  args=(fd, framed, tests, reservoir, source_stats, server, stop))
+
+    print(f"entropy_server: {args.format} from {args.device or 'simulator'} on {args.socket}, "
+          f"{args.reservoir} byte reservoir", file=sys.stderr)
+    source.start()
+    results = None
+    client_threads = []
+    if simulator:
+        simulator.start()
+        results = {"lock": threading.Lock(), "requests": 0, "bytes": 0, "errors": 0, "latency": [], "failures": []}
+        client_threads = test_clients(args.socket, args.clients, stop, results)
+
+    try:
+        server.run(stop, deadline, args.stats_interval)
+    finally:
+        stop.set()
+        server.report()
+        # Clients blocked on a READ see the socket close and stop
+        server.close()
+        for thread in client_threads:
+            thread.join(2.0)
+        source.join(1.0)
+
+    if results is None:
+        return 0
+    latency = sorted(results["latency"])
+    p99 = latency[int(0.99 * (len(latency) - 1))] if latency else 0.0
+    print(f"test: {args.clients} clients, {results['requests']} requests, {results['bytes']} bytes "
+          f"({results['bytes'] / args.test:.0f} B/s), request p99 {p99 * 1000:.1f} ms, "
+          f"peak {server.peak_clients} connected", file=sys.stderr)
+    # Disconnects at shutdown are expected; anything before that is a failure
+    failed = results["errors"] - len(results["failures"])
+    if failed or server.peak_clients < args.clients or not results["requests"]:
+        print(f"test: FAILED ({failed} bad answers)", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -5,6 +5,7 @@
 #include "entropylab_donate.h"
 #include "entropylab_splash.h"
 #include "entropylab_hw_accel.h"
+#include "entropylab_bench.h"
 #include <furi_hal_random.h>
 #include <furi_hal_adc.h>
 #include <furi_hal_power.h>
@@ -133,27 +134,22 @@ void flipper_rng_ir_callback(void* ctx, InfraredWorkerSignal* signal) {
             FURI_LOG_D(TAG, "IR decoded: proto=%d, addr=0x%lX, cmd=0x%lX", 
                       message->protocol, message->address, message->command);
             
-            // Add to entropy pool directly (8 bits of entropy)
-            flipper_rng_add_entropy(state, local_entropy, 8);
-            state->bits_from_infrared += 8;
+            // Queue for the worker (8 bits of entropy) - never blocks the IR thread
+            flipper_rng_push_sample(state, FlipperRngSourceInfrared, local_entropy, 8);
         }
     } else {
         // Get raw signal timings
         infrared_worker_get_raw_signal(signal, &timings, &timings_cnt);
         
         if(timings_cnt > 0) {
-            // Mix timing values into entropy
-            for(size_t i = 0; i < timings_cnt && i < 32; i++) {
-                local_entropy = (local_entropy << 3) ^ (local_entropy >> 29) ^ timings[i];
-                local_entropy += i * 0x9E3779B9;  // Golden ratio for mixing
-            }
-            
-            FURI_LOG_D(TAG, "IR raw: %zu samples", timings_cnt);
+            // Queue the arrival time and the timings for the worker, which health tests each
+            // timing and hashes those that pass as one batch (more bits for longer raw signals,
+            // scaled to the timings that pass) - never blocks the IR thread
+            uint8_t signal_bits = (timings_cnt > 16) ? 16 : 8;
+            bool queued = flipper_rng_push_raw(
+                state, FlipperRngSourceInfrared, local_entropy, timings, timings_cnt, signal_bits);
             
-            // Add to entropy pool (more bits for raw signals)
-            uint8_t entropy_bits = (timings_cnt > 16) ? 16 : 8;
-            flipper_rng_add_entropy(state, local_entropy, entropy_bits);
-            state->bits_from_infrared += entropy_bits;
+            FURI_LOG_D(TAG, "IR raw: %zu samples%s", timings_cnt, queued ? "" : ", ring full");
         }
     }
     
@@ -213,8 +209,8 @@ void flipper_rng_menu_callback(void* context, uint32_t index) {
             FURI_LOG_I(TAG, "Initializing UART for output...");
             app->state->serial_handle = furi_hal_serial_control_acquire(FuriHalSerialIdUsart);
             if(app->state->serial_handle) {
-                furi_hal_serial_init(app->state->serial_handle, 115200);
-                FURI_LOG_I(TAG, "UART initialized at 115200 baud");
+                furi_hal_serial_init(app->state->serial_handle, app->state->uart_baud);
+                FURI_LOG_I(TAG, "UART initialized at %lu baud", app->state->uart_baud);
             } else {
                 FURI_LOG_E(TAG, "Failed to acquire UART");
             }
@@ -232,6 +228,8 @@ void flipper_rng_menu_callback(void* context, uint32_t index) {
         app->state->bits_from_hw_rng = 0;
         app->state->bits_from_subghz_rssi = 0;
         app->state->bits_from_infrared = 0;
+        flipper_rng_init_health(app->state);
+        flipper_rng_init_estimators(app->state);
         memset(app->state->byte_histogram, 0, sizeof(app->state->byte_histogram));
         
         // Start the worker thread
@@ -404,18 +402,31 @@ FlipperRngApp* flipper_rng_app_alloc(void) {
     }
     app->state->entropy_sources = EntropySourceAll;
     app->state->output_mode = OutputModeNone;  // Default to None (visualization only)
+    app->state->uart_format = UartFormatRaw;  // Raw keeps existing serial readers working
+    app->state->uart_baud = 115200;  // What serial readers expect by default
     app->state->mixing_mode = MixingModeHardware;  // Default to HW AES
     app->state->wordlist_type = PassphraseListEFFLong;  // Default to EFF wordlist
     app->state->poll_interval_ms = 1;  // Maximum performance - 1ms polling
     app->state->visual_refresh_ms = 500;  // Smooth, easy-to-watch visualization
     app->state->mix_frequency = 32;  // Mix pool every 32 iterations (balanced default)
     app->state->mix_counter = 0;  // Initialize mix counter for rotating key positions
+    app->state->full_mix_interval = RNG_FULL_MIX_INTERVAL_DEFAULT;
+    app->state->mixes_since_full = 0;
+    app->state->dirty_regions = RNG_POOL_ALL_REGIONS;  // Initial fill touches the whole pool
     app->state->is_running = false;
-    app->state->entropy_ready = false;  // Not ready until minimum collection time
+    app->state->entropy_ready = false;  // Not ready until RNG_CREDIT_READY_BITS are credited
+    app->state->entropy_credit = 0;
+    app->state->entropy_claimed = 0;
     app->state->entropy_collection_start = 0;  // Will be set when worker starts
     app->state->last_passphrase_generation_time = 0;  // No passphrase generated yet
     app->state->entropy_pool_pos = 0;
     app->state->bytes_generated = 0;
+    memset(&app->state->drbg, 0, sizeof(app->state->drbg));  // Instantiated on first extraction
+    app->state->drbg_seed_mix_counter = 0;
+    app->state->drbg_reserve_len = 0;
+    flipper_rng_init_sample_rings(app->state);
+    flipper_rng_init_health(app->state);
+    flipper_rng_init_estimators(app->state);
     
     // Initialize hardware acceleration
     flipper_rng_hw_accel_init();
@@ -423,6 +434,10 @@ FlipperRngApp* flipper_rng_app_alloc(void) {
     app->state->bits_from_hw_rng = 0;
     app->state->bits_from_subghz_rssi = 0;
     app->state->bits_from_infrared = 0;
+    app->state->file_write_bps = 0;
+    app->state->file_bytes_failed = 0;
+    app->state->uart_tx_bps = 0;
+    app->state->uart_tx_stall_percent = 0;
     memset(app->state->byte_histogram, 0, sizeof(app->state->byte_histogram));
     app->state->entropy_rate = 0.0f;
     app->state->adc_handle = NULL;
@@ -430,6 +445,7 @@ FlipperRngApp* flipper_rng_app_alloc(void) {
     
     // Clear entropy pool with initial random data
     furi_hal_random_fill_buf(app->state->entropy_pool, RNG_POOL_SIZE);
+    flipper_rng_fortuna_init(&app->state->fortuna);
     
     // Initialize GUI
     FURI_LOG_I(TAG, "Opening GUI record...");
@@ -696,6 +712,11 @@ int32_t entropylab_app(void* p) {
     );
     furi_timer_start(app->splash_timer, 100); // Check every 100ms
     
+#ifdef ENTROPYLAB_BENCH
+    // Benchmark build: time the pool hot paths before the worker can start
+    flipper_rng_bench_run_to_file(app->state);
+#endif
+
     FURI_LOG_I(TAG, "App allocated, starting view dispatcher");
     view_dispatcher_run(app->view_dispatcher);
     
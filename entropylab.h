@@ -11,11 +11,30 @@
 #include <infrared_worker.h>
 #include <storage/storage.h>
 #include "entropylab_passphrase_sd.h"
+#include "entropylab_drbg.h"
+#include "entropylab_fortuna.h"
+#include "entropylab_ring.h"
+#include "entropylab_health.h"
+#include "entropylab_estimator.h"
 
 #define FLIPPER_RNG_VERSION "1.0"
 #define RNG_BUFFER_SIZE 256
 #define RNG_POOL_SIZE 4096
+#define RNG_POOL_MASK (RNG_POOL_SIZE - 1)  // Pool size is a power of two
 #define RNG_OUTPUT_CHUNK_SIZE 64
+#define RNG_DRBG_RESERVE_SIZE 64  // Buffered DRBG output for sub-block requests
+#define RNG_HW_BATCH_WORDS 64  // TRNG words folded into the pool per worker iteration
+
+// Dirty-region tracking: only regions written since the last mix get re-mixed
+#define RNG_POOL_REGION_SHIFT 8
+#define RNG_POOL_REGION_SIZE (1 << RNG_POOL_REGION_SHIFT)  // 256 bytes
+#define RNG_POOL_REGIONS (RNG_POOL_SIZE / RNG_POOL_REGION_SIZE)  // 16, one bit each in dirty_regions
+#define RNG_POOL_ALL_REGIONS ((uint16_t)((1u << RNG_POOL_REGIONS) - 1))
+#define RNG_FULL_MIX_INTERVAL_DEFAULT 8  // Every 8th mix sweeps the whole pool
+
+// Entropy credit: sources add their credited bits, credited output debits them
+#define RNG_CREDIT_MAX_BITS (RNG_POOL_SIZE * 8)  // The pool cannot hold more than its size
+#define RNG_CREDIT_READY_BITS 256  // Needed before output, the CTR_DRBG's security strength
 
 // Entropy source flags - High-quality sources only
 typedef enum {
@@ -25,6 +44,23 @@ typedef enum {
     EntropySourceAll = 0x07,                    // All high-quality sources
 } EntropySource;
 
+// Sample producers, one lock-free ring each
+typedef enum {
+    FlipperRngSourceHardwareRNG,
+    FlipperRngSourceSubGhzRSSI,
+    FlipperRngSourceInfrared,
+    FlipperRngSourceCount,
+} FlipperRngSourceId;
+
+// Set in a queued sample's source for digest words whose raw readings were already
+// health tested and estimated; the drain credits them without testing the hash output
+#define FLIPPER_RNG_SOURCE_CONDITIONED 0x80
+
+// Set in the header of a raw group queued by flipper_rng_push_raw(): the header's sample is
+// the reading count and its bits the group's credit, followed by an uncredited seed word and
+// the readings, which the drain health tests and conditions under the lock it already holds
+#define FLIPPER_RNG_SOURCE_RAW 0x40
+
 // Output mode - Visualization is always available, not an exclusive output mode
 typedef enum {
     OutputModeNone,     // No output (visualization only)
@@ -32,10 +68,18 @@ typedef enum {
     OutputModeFile,
 } OutputMode;
 
+// UART byte stream format
+typedef enum {
+    UartFormatRaw,     // Bare random bytes, for ent/dieharder pipelines
+    UartFormatFramed,  // entropylab_frame.h frames with sequence numbers, CRC and health flags
+    UartFormatPull,    // Framed, but only sent in answer to entropylab_pull.h requests
+} UartFormat;
+
 // Mixing mode for entropy pool
 typedef enum {
     MixingModeHardware,  // Force hardware AES only
     MixingModeSoftware,  // Force software XOR mixing only
+    MixingModeFortuna,   // 32 SHA-256 pools with scheduled reseeds instead of the XOR pool
 } MixingMode;
 
 // View IDs
@@ -58,20 +102,44 @@ typedef struct {
     FuriMutex* mutex;
     uint32_t entropy_sources;
     OutputMode output_mode;
+    UartFormat uart_format;
+    uint32_t uart_baud;  // USART line rate, applied when the worker starts
     MixingMode mixing_mode;
     PassphraseListType wordlist_type;  // Selected wordlist for passphrase generation
     uint32_t poll_interval_ms;
     uint32_t visual_refresh_ms;  // Configurable visualization refresh rate
     uint32_t mix_frequency;  // How often to mix entropy pool (iterations between mixes)
     uint32_t mix_counter;  // Counter for rotating AES key derivation positions
+    uint32_t full_mix_interval;  // Mixes between full-pool sweeps (1 = always mix everything)
+    uint32_t mixes_since_full;
+    uint16_t dirty_regions;  // Bit per 256-byte pool region written since the last mix
     bool is_running;
-    bool entropy_ready;  // True when minimum entropy has been collected
+    bool entropy_ready;  // entropy_credit >= RNG_CREDIT_READY_BITS, and in Fortuna mode after the first reseed
+    uint32_t entropy_credit;  // Bits credited by sources and not yet debited by output
+    uint32_t entropy_claimed;  // Credit that waiting debit_entropy_wait callers have claimed
     uint32_t entropy_collection_start;  // Tick when entropy collection started
     uint32_t last_passphrase_generation_time;  // Tick when last passphrase was generated
     uint8_t entropy_pool[RNG_POOL_SIZE];
     size_t entropy_pool_pos;
     uint32_t bytes_generated;
     
+    // CTR_DRBG output stage, reseeded from the pool after every mix
+    FlipperRngDrbg drbg;
+    uint32_t drbg_seed_mix_counter;  // mix_counter at the last (re)seed
+    uint8_t drbg_reserve[RNG_DRBG_RESERVE_SIZE];
+    size_t drbg_reserve_len;
+    
+    // Fortuna pools, fed instead of entropy_pool while mixing_mode is MixingModeFortuna
+    FlipperRngFortuna fortuna;
+    
+    // Raw samples waiting to be folded into the pool by the worker
+    FlipperRngSampleRing sample_rings[FlipperRngSourceCount];
+    
+    // SP 800-90B health tests, run on every raw sample before it is credited
+    FlipperRngHealth health[FlipperRngSourceCount];
+    
+    // Online min-entropy estimates per raw source, published by flipper_rng_update_quality_metric()
+    FlipperRngEstimator estimators[FlipperRngSourceCount];
     
     // Hardware handles
     FuriHalAdcHandle* adc_handle;
@@ -90,6 +158,14 @@ typedef struct {
     uint32_t bits_from_hw_rng;
     uint32_t bits_from_subghz_rssi;
     uint32_t bits_from_infrared;
+    
+    // File output, refreshed by the worker from the SD writer thread
+    uint32_t file_write_bps;      // Sustained bytes/s landed on the card
+    uint32_t file_bytes_failed;  // Output the card did not take (short writes)
+    
+    // UART output, refreshed by the worker from the UART TX thread
+    uint32_t uart_tx_bps;           // Achieved bytes/s on the wire
+    uint8_t uart_tx_stall_percent;  // Share of the run the worker waited on the line
 } FlipperRngState;
 
 // Forward declaration
@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * Portable software AES-256 (encrypt only)
+ * Used by the CTR_DRBG when the AES1 peripheral is unavailable and by the host build.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define FLIPPER_RNG_AES_BLOCK_SIZE 16
+#define FLIPPER_RNG_AES256_KEY_SIZE 32
+#define FLIPPER_RNG_AES256_ROUNDS 14
+
+typedef struct {
+    uint8_t round_keys[(FLIPPER_RNG_AES256_ROUNDS + 1) * FLIPPER_RNG_AES_BLOCK_SIZE];
+} FlipperRngAes256;
+
+void flipper_rng_aes256_init(FlipperRngAes256* ctx, const uint8_t key[FLIPPER_RNG_AES256_KEY_SIZE]);
+void flipper_rng_aes256_encrypt_block(
+    const FlipperRngAes256* ctx,
+    const uint8_t input[FLIPPER_RNG_AES_BLOCK_SIZE],
+    uint8_t output[FLIPPER_RNG_AES_BLOCK_SIZE]);
+void flipper_rng_aes256_wipe(FlipperRngAes256* ctx);
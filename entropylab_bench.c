@@ -0,0 +1,377 @@
+/**
+ * Micro-benchmarks for the entropy pool hot paths
+ * Each stage is timed per iteration so 32-bit cycle counters never wrap
+ * inside a measurement, then accumulated into 64-bit totals.
+ */
+
+#include "entropylab_bench.h"
+#include "entropylab_entropy.h"
+#include "entropylab_hw_accel.h"
+#include <furi.h>
+#include <furi_hal_random.h>
+#include <storage/storage.h>
+
+#define TAG "EntropyLab_Bench"
+
+#ifdef ENTROPYLAB_HOST
+#define BENCH_TARGET "host"
+#else
+#define BENCH_TARGET "stm32wb55"
+#endif
+
+static const char* const bench_stage_names[FlipperRngBenchStageCount] = {
+    [FlipperRngBenchAddEntropy] = "add_entropy",
+    [FlipperRngBenchAddEntropyBatch] = "add_entropy_batch",
+    [FlipperRngBenchMixHardware] = "mix_hardware",
+    [FlipperRngBenchMixSoftware] = "mix_software",
+    [FlipperRngBenchMixHardwareDirty] = "mix_hardware_dirty",
+    [FlipperRngBenchMixSoftwareDirty] = "mix_software_dirty",
+    [FlipperRngBenchExtractBytes] = "extract_bytes",
+    [FlipperRngBenchExtractByte] = "extract_byte",
+    [FlipperRngBenchHealthTest] = "health_test",
+    [FlipperRngBenchAddFortuna] = "add_fortuna",
+    [FlipperRngBenchConditionAdHoc] = "condition_adhoc",
+    [FlipperRngBenchConditionHash] = "condition_hash",
+};
+
+const char* flipper_rng_bench_stage_name(FlipperRngBenchStage stage) {
+    return stage < FlipperRngBenchStageCount ? bench_stage_names[stage] : "unknown";
+}
+
+void flipper_rng_bench_config_default(FlipperRngBenchConfig* config) {
+    static const size_t default_batches[] = {1, 4, 32, 256, 4096};
+
+    memset(config, 0, sizeof(FlipperRngBenchConfig));
+    for(size_t i = 0; i < COUNT_OF(default_batches); i++) {
+        config->batch_sizes[i] = default_batches[i];
+    }
+    config->batch_count = COUNT_OF(default_batches);
+    config->iterations = 64;
+}
+
+size_t flipper_rng_bench_max_results(const FlipperRngBenchConfig* config) {
+    // Two full mixes, then every batch for add/add_batch/add_fortuna/extract/extract_byte/health,
+    // both conditioners and both dirty mixes
+    return 2 + config->batch_count * 10;
+}
+
+// Health test state for the health_test stage, kept apart from the live per-source state
+static FlipperRngHealth bench_health;
+
+// Keeps the condition stages' output live
+static volatile uint32_t bench_sink;
+
+// The per-signal IR timing fold that the conditioner replaced, 32 words at a time
+static uint32_t bench_adhoc_fold(const uint32_t* words, size_t count) {
+    uint32_t local_entropy = 0;
+    for(size_t i = 0; i < count; i++) {
+        local_entropy = (local_entropy << 3) ^ (local_entropy >> 29) ^ words[i];
+        local_entropy += (i % 32) * 0x9E3779B9;
+    }
+    return local_entropy;
+}
+
+// Untimed setup before each iteration: dirty mixes need fresh input to mix,
+// health tests need fresh TRNG words in buffer
+static void bench_stage_prepare(
+    FlipperRngState* state,
+    FlipperRngBenchStage stage,
+    size_t batch,
+    uint8_t* buffer) {
+    if(stage == FlipperRngBenchHealthTest || stage == FlipperRngBenchConditionAdHoc ||
+       stage == FlipperRngBenchConditionHash) {
+        furi_hal_random_fill_buf(buffer, batch);
+        return;
+    }
+    if(stage != FlipperRngBenchMixHardwareDirty && stage != FlipperRngBenchMixSoftwareDirty) return;
+
+    FlipperRngSample samples[RNG_HW_BATCH_WORDS];
+    size_t words = (batch + 3) / 4;
+    for(size_t done = 0; done < words;) {
+        size_t chunk = MIN(words - done, (size_t)RNG_HW_BATCH_WORDS);
+        for(size_t i = 0; i < chunk; i++) {
+            samples[i].sample = furi_hal_random_get();
+            samples[i].bits = 32;
+            samples[i].source = FlipperRngSourceHardwareRNG;
+        }
+        flipper_rng_add_entropy_batch(state, samples, chunk);
+        done += chunk;
+    }
+}
+
+// Run one stage once; returns the number of bytes it processed
+static size_t bench_stage_once(FlipperRngState* state, FlipperRngBenchStage stage, size_t batch, uint8_t* buffer) {
+    switch(stage) {
+    case FlipperRngBenchAddEntropy:
+        for(size_t i = 0; i < batch; i += 4) {
+            flipper_rng_add_entropy(state, furi_hal_random_get(), 32);
+        }
+        return ((batch + 3) / 4) * 4;
+    case FlipperRngBenchAddEntropyBatch: {
+        // Same shape as the worker's TRNG batch, in chunks of RNG_HW_BATCH_WORDS
+        FlipperRngSample samples[RNG_HW_BATCH_WORDS];
+        size_t words = (batch + 3) / 4;
+        for(size_t done = 0; done < words;) {
+            size_t chunk = MIN(words - done, (size_t)RNG_HW_BATCH_WORDS);
+            for(size_t i = 0; i < chunk; i++) {
+                samples[i].sample = furi_hal_random_get();
+                samples[i].bits = 32;
+                samples[i].source = FlipperRngSourceHardwareRNG;
+            }
+            flipper_rng_add_entropy_batch(state, samples, chunk);
+            done += chunk;
+        }
+        return words * 4;
+    }
+    case FlipperRngBenchAddFortuna:
+        return bench_stage_once(state, FlipperRngBenchAddEntropyBatch, batch, buffer);
+    case FlipperRngBenchConditionAdHoc: {
+        size_t words = batch / 4;
+        uint32_t folded = 0;
+        for(size_t offset = 0; offset < words; offset += 32) {
+            folded ^= bench_adhoc_fold((const uint32_t*)buffer + offset, MIN(words - offset, (size_t)32));
+        }
+        bench_sink = folded;
+        return words * 4;
+    }
+    case FlipperRngBenchConditionHash: {
+        FlipperRngConditioner conditioner;
+        uint8_t digest[FLIPPER_RNG_CONDITIONER_OUTPUT];
+        flipper_rng_conditioner_begin(&conditioner);
+        flipper_rng_conditioner_add(&conditioner, buffer, batch, 0);
+        flipper_rng_conditioner_finish(&conditioner, digest);
+        bench_sink = digest[0];
+        return batch;
+    }
+    case FlipperRngBenchMixHardware:
+    case FlipperRngBenchMixSoftware:
+    case FlipperRngBenchMixHardwareDirty:
+    case FlipperRngBenchMixSoftwareDirty:
+        // Reported per pool so full and dirty mixes compare directly
+        flipper_rng_mix_entropy_pool(state);
+        return RNG_POOL_SIZE;
+    case FlipperRngBenchExtractBytes:
+        flipper_rng_extract_random_bytes(state, buffer, batch);
+        return batch;
+    case FlipperRngBenchExtractByte:
+        for(size_t i = 0; i < batch; i++) {
+            buffer[i] = flipper_rng_extract_random_byte(state);
+        }
+        return batch;
+    case FlipperRngBenchHealthTest: {
+        // Whole words only, so a 1-byte batch is not counted as a sample
+        size_t words = batch / 4;
+        for(size_t i = 0; i < words; i++) {
+            uint32_t word;
+            memcpy(&word, &buffer[i * 4], sizeof(word));
+            flipper_rng_health_test(&bench_health, word, 32);
+        }
+        return words * 4;
+    }
+    default:
+        return 0;
+    }
+}
+
+static void bench_measure(
+    FlipperRngState* state,
+    FlipperRngBenchStage stage,
+    size_t batch,
+    uint32_t iterations,
+    uint8_t* buffer,
+    FlipperRngBenchResult* result) {
+    memset(result, 0, sizeof(FlipperRngBenchResult));
+    result->stage = stage;
+    result->batch_size = batch;
+    result->iterations = iterations;
+
+    MixingMode saved_mode = state->mixing_mode;
+    uint32_t saved_full_mix_interval = state->full_mix_interval;
+    if(stage == FlipperRngBenchMixHardware || stage == FlipperRngBenchMixHardwareDirty) {
+        state->mixing_mode = MixingModeHardware;
+    }
+    if(stage == FlipperRngBenchMixSoftware || stage == FlipperRngBenchMixSoftwareDirty) {
+        state->mixing_mode = MixingModeSoftware;
+    }
+    if(stage == FlipperRngBenchAddFortuna) {
+        state->mixing_mode = MixingModeFortuna;
+    }
+    // Full stages sweep the whole pool every time, dirty stages never do
+    if(stage == FlipperRngBenchMixHardware || stage == FlipperRngBenchMixSoftware) {
+        state->full_mix_interval = 1;
+    }
+    if(stage == FlipperRngBenchMixHardwareDirty || stage == FlipperRngBenchMixSoftwareDirty) {
+        state->full_mix_interval = UINT32_MAX;
+        state->mixes_since_full = 0;
+    }
+
+    // Warm-up pass so first-touch costs (AES key setup, caches) are not counted
+    flipper_rng_health_init(&bench_health);
+    bench_stage_prepare(state, stage, batch, buffer);
+    bench_stage_once(state, stage, batch, buffer);
+
+    for(uint32_t i = 0; i < iterations; i++) {
+        bench_stage_prepare(state, stage, batch, buffer);
+
+        uint64_t start_ns = flipper_rng_hw_get_time_ns();
+        uint32_t start_cycles = flipper_rng_hw_get_cycles();
+
+        size_t bytes = bench_stage_once(state, stage, batch, buffer);
+
+        result->cycles += flipper_rng_hw_cycles_elapsed(start_cycles);
+        result->ns += flipper_rng_hw_get_time_ns() - start_ns;
+        result->bytes += bytes;
+    }
+
+    state->mixing_mode = saved_mode;
+    state->full_mix_interval = saved_full_mix_interval;
+}
+
+size_t flipper_rng_bench_run(
+    FlipperRngState* state,
+    const FlipperRngBenchConfig* config,
+    FlipperRngBenchResult* results,
+    size_t max_results) {
+    if(!state || !config || !results) return 0;
+
+    size_t max_batch = 1;
+    for(size_t i = 0; i < config->batch_count; i++) {
+        if(config->batch_sizes[i] > max_batch) max_batch = config->batch_sizes[i];
+    }
+
+    uint8_t* buffer = malloc(max_batch);
+    if(!buffer) {
+        FURI_LOG_E(TAG, "Failed to allocate %u byte bench buffer", (unsigned)max_batch);
+        return 0;
+    }
+
+    size_t count = 0;
+
+    // A full mix always processes the whole pool, so it is measured once
+    for(FlipperRngBenchStage stage = FlipperRngBenchMixHardware; stage <= FlipperRngBenchMixSoftware; stage++) {
+        if(count >= max_results) break;
+        bench_measure(state, stage, RNG_POOL_SIZE, config->iterations, buffer, &results[count++]);
+    }
+
+    static const FlipperRngBenchStage batched_stages[] = {
+        FlipperRngBenchAddEntropy,
+        FlipperRngBenchAddEntropyBatch,
+        FlipperRngBenchAddFortuna,
+        FlipperRngBenchExtractBytes,
+        FlipperRngBenchExtractByte,
+        FlipperRngBenchHealthTest,
+        FlipperRngBenchConditionAdHoc,
+        FlipperRngBenchConditionHash,
+        FlipperRngBenchMixHardwareDirty,
+        FlipperRngBenchMixSoftwareDirty,
+    };
+
+    for(size_t s = 0; s < COUNT_OF(batched_stages); s++) {
+        for(size_t b = 0; b < config->batch_count && count < max_results; b++) {
+            bench_measure(
+                state, batched_stages[s], config->batch_sizes[b], config->iterations, buffer, &results[count++]);
+        }
+    }
+
+    free(buffer);
+    return count;
+}
+
+// Decimal formatting without relying on %llu support in the firmware printf
+static const char* bench_format_u64(char* out, size_t out_size, uint64_t value) {
+    char digits[21];
+    size_t len = 0;
+    do {
+        digits[len++] = (char)('0' + (value % 10));
+        value /= 10;
+    } while(value && len < sizeof(digits));
+
+    size_t i = 0;
+    for(; i < len && i + 1 < out_size; i++) {
+        out[i] = digits[len - 1 - i];
+    }
+    out[i] = '\0';
+    return out;
+}
+
+// numerator/denominator with three decimals, e.g. "12.345"
+static const char* bench_format_ratio(char* out, size_t out_size, uint64_t numerator, uint64_t denominator) {
+    if(denominator == 0) {
+        snprintf(out, out_size, "null");
+        return out;
+    }
+
+    uint64_t milli = (numerator * 1000ULL + denominator / 2) / denominator;
+    char whole[21];
+    bench_format_u64(whole, sizeof(whole), milli / 1000);
+    snprintf(out, out_size, "%s.%03u", whole, (unsigned)(milli % 1000));
+    return out;
+}
+
+void flipper_rng_bench_write_json(
+    const FlipperRngBenchResult* results,
+    size_t count,
+    FlipperRngBenchWriteCallback write,
+    void* context) {
+    char line[320];
+    char bytes[21], ns[21], cycles[21], ns_per_byte[32], cycles_per_byte[32], cycles_per_call[32];
+
+    snprintf(line, sizeof(line), "{\"target\":\"%s\",\"pool_size\":%u,\"results\":[\n", BENCH_TARGET, RNG_POOL_SIZE);
+    write(line, context);
+
+    for(size_t i = 0; i < count; i++) {
+        const FlipperRngBenchResult* r = &results[i];
+        snprintf(
+            line,
+            sizeof(line),
+            "  {\"stage\":\"%s\",\"batch\":%u,\"iterations\":%u,\"bytes\":%s,\"ns\":%s,\"cycles\":%s,"
+            "\"ns_per_byte\":%s,\"cycles_per_byte\":%s,\"cycles_per_call\":%s}%s\n",
+            flipper_rng_bench_stage_name(r->stage),
+            (unsigned)r->batch_size,
+            (unsigned)r->iterations,
+            bench_format_u64(bytes, sizeof(bytes), r->bytes),
+            bench_format_u64(ns, sizeof(ns), r->ns),
+            bench_format_u64(cycles, sizeof(cycles), r->cycles),
+            bench_format_ratio(ns_per_byte, sizeof(ns_per_byte), r->ns, r->bytes),
+            bench_format_ratio(cycles_per_byte, sizeof(cycles_per_byte), r->cycles, r->bytes),
+            bench_format_ratio(cycles_per_call, sizeof(cycles_per_call), r->cycles, r->iterations),
+            (i + 1 < count) ? "," : "");
+        write(line, context);
+    }
+
+    write("]}\n", context);
+}
+
+static void bench_file_write(const char* text, void* context) {
+    storage_file_write((File*)context, text, strlen(text));
+}
+
+bool flipper_rng_bench_run_to_file(FlipperRngState* state) {
+    FlipperRngBenchConfig config;
+    flipper_rng_bench_config_default(&config);
+
+    size_t max_results = flipper_rng_bench_max_results(&config);
+    FlipperRngBenchResult* results = malloc(max_results * sizeof(FlipperRngBenchResult));
+    if(!results) return false;
+
+    FURI_LOG_I(TAG, "Running benchmarks (%lu iterations)", config.iterations);
+    size_t count = flipper_rng_bench_run(state, &config, results, max_results);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_mkdir(storage, "/ext/apps_data/entropylab");
+    File* file = storage_file_alloc(storage);
+
+    bool saved = storage_file_open(file, FLIPPER_RNG_BENCH_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    if(saved) {
+        flipper_rng_bench_write_json(results, count, bench_file_write, file);
+        storage_file_close(file);
+        FURI_LOG_I(TAG, "Benchmark results saved to %s", FLIPPER_RNG_BENCH_PATH);
+    } else {
+        FURI_LOG_E(TAG, "Failed to open %s", FLIPPER_RNG_BENCH_PATH);
+    }
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    free(results);
+    return saved;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "entropylab.h"
+
+/**
+ * Micro-benchmarks for the entropy pool hot paths
+ * Times add/mix/extract with the DWT cycle counter on the device
+ * (TSC + clock_gettime in the host build) and reports results as JSON.
+ */
+
+#define FLIPPER_RNG_BENCH_PATH "/ext/apps_data/entropylab/bench.json"
+#define FLIPPER_RNG_BENCH_MAX_BATCHES 8
+
+typedef enum {
+    FlipperRngBenchAddEntropy,       // flipper_rng_add_entropy, batch = bytes added (4 per call)
+    FlipperRngBenchAddEntropyBatch,  // flipper_rng_add_entropy_batch, batch = bytes added (4 per sample)
+    FlipperRngBenchMixHardware,      // flipper_rng_mix_entropy_pool with MixingModeHardware, full pool
+    FlipperRngBenchMixSoftware,      // flipper_rng_mix_entropy_pool with MixingModeSoftware, full pool
+    FlipperRngBenchMixHardwareDirty, // Hardware mix of dirty regions only, batch = bytes added (untimed) per mix
+    FlipperRngBenchMixSoftwareDirty, // Software mix of dirty regions only, batch = bytes added (untimed) per mix
+    FlipperRngBenchExtractBytes,     // flipper_rng_extract_random_bytes, batch = bytes per call
+    FlipperRngBenchExtractByte,      // flipper_rng_extract_random_byte, batch = calls
+    FlipperRngBenchHealthTest,       // flipper_rng_health_test on TRNG words, batch = bytes tested (4 per sample)
+    FlipperRngBenchAddFortuna,       // flipper_rng_add_entropy_batch with MixingModeFortuna, batch = bytes added
+    FlipperRngBenchConditionAdHoc,   // The shift/golden-ratio fold IR timings used to get, batch = raw bytes
+    FlipperRngBenchConditionHash,    // flipper_rng_conditioner over the whole batch, batch = raw bytes
+    FlipperRngBenchStageCount
+} FlipperRngBenchStage;
+
+typedef struct {
+    size_t batch_sizes[FLIPPER_RNG_BENCH_MAX_BATCHES];
+    size_t batch_count;
+    uint32_t iterations;  // Timed repetitions of each stage/batch pair
+} FlipperRngBenchConfig;
+
+typedef struct {
+    FlipperRngBenchStage stage;
+    size_t batch_size;
+    uint32_t iterations;
+    uint64_t bytes;   // Bytes added, mixed or extracted over all iterations
+    uint64_t ns;
+    uint64_t cycles;
+} FlipperRngBenchResult;
+
+// Receives the JSON output in chunks
+typedef void (*FlipperRngBenchWriteCallback)(const char* text, void* context);
+
+// Default config: worker-sized batches (1, 4, 32, 256, 4096 bytes)
+void flipper_rng_bench_config_default(FlipperRngBenchConfig* config);
+
+// Run every stage for every batch size, returns the number of results written
+// Full mixing stages ignore the batch size and run once per config
+// The worker thread must not be running; the pool contents are overwritten
+size_t flipper_rng_bench_run(
+    FlipperRngState* state,
+    const FlipperRngBenchConfig* config,
+    FlipperRngBenchResult* results,
+    size_t max_results);
+
+const char* flipper_rng_bench_stage_name(FlipperRngBenchStage stage);
+
+// Upper bound on results for a config
+size_t flipper_rng_bench_max_results(const FlipperRngBenchConfig* config);
+
+// Emit {"target":..., "results":[{stage, batch, iterations, bytes, ns, cycles, ns_per_byte, cycles_per_byte,
+// cycles_per_call}]}
+void flipper_rng_bench_write_json(
+    const FlipperRngBenchResult* results,
+    size_t count,
+    FlipperRngBenchWriteCallback write,
+    void* context);
+
+// Run the default config and save JSON to FLIPPER_RNG_BENCH_PATH
+bool flipper_rng_bench_run_to_file(FlipperRngState* state);
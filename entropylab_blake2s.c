@@ -0,0 +1,120 @@
+/**
+ * Portable software BLAKE2s (RFC 7693), unkeyed
+ * Ten rounds of the G function over a 16-word working vector per block.
+ */
+
+#include "entropylab_blake2s.h"
+#include "entropylab_secure.h"
+#include <stdbool.h>
+#include <string.h>
+
+static const uint32_t blake2s_iv[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+};
+
+static const uint8_t blake2s_sigma[10][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+    {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+    {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+    {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+    {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+};
+
+static inline uint32_t blake2s_rotr(uint32_t x, unsigned n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+#define BLAKE2S_G(a, b, c, d, x, y)       \
+    do {                                  \
+        a = a + b + x;                    \
+        d = blake2s_rotr(d ^ a, 16);      \
+        c = c + d;                        \
+        b = blake2s_rotr(b ^ c, 12);      \
+        a = a + b + y;                    \
+        d = blake2s_rotr(d ^ a, 8);       \
+        c = c + d;                        \
+        b = blake2s_rotr(b ^ c, 7);       \
+    } while(0)
+
+static void blake2s_compress(FlipperRngBlake2s* ctx, const uint8_t block[FLIPPER_RNG_BLAKE2S_BLOCK_SIZE], bool last) {
+    uint32_t m[16], v[16];
+    for(size_t i = 0; i < 16; i++) {
+        m[i] = (uint32_t)block[i * 4] | ((uint32_t)block[i * 4 + 1] << 8) | ((uint32_t)block[i * 4 + 2] << 16) |
+               ((uint32_t)block[i * 4 + 3] << 24);
+    }
+    for(size_t i = 0; i < 8; i++) {
+        v[i] = ctx->h[i];
+        v[i + 8] = blake2s_iv[i];
+    }
+    v[12] ^= ctx->t[0];
+    v[13] ^= ctx->t[1];
+    if(last) v[14] = ~v[14];
+
+    for(size_t r = 0; r < 10; r++) {
+        const uint8_t* s = blake2s_sigma[r];
+        BLAKE2S_G(v[0], v[4], v[8], v[12], m[s[0]], m[s[1]]);
+        BLAKE2S_G(v[1], v[5], v[9], v[13], m[s[2]], m[s[3]]);
+        BLAKE2S_G(v[2], v[6], v[10], v[14], m[s[4]], m[s[5]]);
+        BLAKE2S_G(v[3], v[7], v[11], v[15], m[s[6]], m[s[7]]);
+        BLAKE2S_G(v[0], v[5], v[10], v[15], m[s[8]], m[s[9]]);
+        BLAKE2S_G(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+        BLAKE2S_G(v[2], v[7], v[8], v[13], m[s[12]], m[s[13]]);
+        BLAKE2S_G(v[3], v[4], v[9], v[14], m[s[14]], m[s[15]]);
+    }
+
+    for(size_t i = 0; i < 8; i++) ctx->h[i] ^= v[i] ^ v[i + 8];
+    secure_wipe(m, sizeof(m));
+    secure_wipe(v, sizeof(v));
+}
+
+static void blake2s_count(FlipperRngBlake2s* ctx, uint32_t bytes) {
+    ctx->t[0] += bytes;
+    if(ctx->t[0] < bytes) ctx->t[1]++;
+}
+
+void flipper_rng_blake2s_init(FlipperRngBlake2s* ctx, size_t digest_len) {
+    memset(ctx, 0, sizeof(FlipperRngBlake2s));
+    memcpy(ctx->h, blake2s_iv, sizeof(blake2s_iv));
+    ctx->h[0] ^= 0x01010000 ^ (uint32_t)digest_len;  // Fanout and depth 1, no key
+    ctx->digest_len = digest_len;
+}
+
+void flipper_rng_blake2s_update(FlipperRngBlake2s* ctx, const uint8_t* data, size_t length) {
+    // The last block is held back: it has to be compressed with the final flag
+    while(length > 0) {
+        if(ctx->buffer_len == FLIPPER_RNG_BLAKE2S_BLOCK_SIZE) {
+            blake2s_count(ctx, FLIPPER_RNG_BLAKE2S_BLOCK_SIZE);
+            blake2s_compress(ctx, ctx->buffer, false);
+            ctx->buffer_len = 0;
+        }
+        size_t take = FLIPPER_RNG_BLAKE2S_BLOCK_SIZE - ctx->buffer_len;
+        if(take > length) take = length;
+        memcpy(&ctx->buffer[ctx->buffer_len], data, take);
+        ctx->buffer_len += take;
+        data += take;
+        length -= take;
+    }
+}
+
+void flipper_rng_blake2s_final(FlipperRngBlake2s* ctx, uint8_t* digest) {
+    blake2s_count(ctx, (uint32_t)ctx->buffer_len);
+    memset(&ctx->buffer[ctx->buffer_len], 0, FLIPPER_RNG_BLAKE2S_BLOCK_SIZE - ctx->buffer_len);
+    blake2s_compress(ctx, ctx->buffer, true);
+
+    for(size_t i = 0; i < ctx->digest_len; i++) {
+        digest[i] = (uint8_t)(ctx->h[i / 4] >> ((i % 4) * 8));
+    }
+    secure_wipe(ctx, sizeof(FlipperRngBlake2s));
+}
+
+void flipper_rng_blake2s(const uint8_t* data, size_t length, uint8_t digest[FLIPPER_RNG_BLAKE2S_DIGEST_SIZE]) {
+    FlipperRngBlake2s ctx;
+    flipper_rng_blake2s_init(&ctx, FLIPPER_RNG_BLAKE2S_DIGEST_SIZE);
+    flipper_rng_blake2s_update(&ctx, data, length);
+    flipper_rng_blake2s_final(&ctx, digest);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+/**
+ * Portable software BLAKE2s (RFC 7693), unkeyed
+ * 32-bit arithmetic throughout, which suits the Cortex-M4 better than SHA-256's
+ * message schedule; used as the default raw sample conditioner.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define FLIPPER_RNG_BLAKE2S_BLOCK_SIZE 64
+#define FLIPPER_RNG_BLAKE2S_DIGEST_SIZE 32
+
+typedef struct {
+    uint32_t h[8];
+    uint32_t t[2];  // Byte counter
+    uint8_t buffer[FLIPPER_RNG_BLAKE2S_BLOCK_SIZE];
+    size_t buffer_len;
+    size_t digest_len;
+} FlipperRngBlake2s;
+
+// digest_len is 1-32 bytes
+void flipper_rng_blake2s_init(FlipperRngBlake2s* ctx, size_t digest_len);
+void flipper_rng_blake2s_update(FlipperRngBlake2s* ctx, const uint8_t* data, size_t length);
+void flipper_rng_blake2s_final(FlipperRngBlake2s* ctx, uint8_t* digest);
+void flipper_rng_blake2s(const uint8_t* data, size_t length, uint8_t digest[FLIPPER_RNG_BLAKE2S_DIGEST_SIZE]);
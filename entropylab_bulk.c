@@ -0,0 +1,232 @@
+#include "entropylab_bulk.h"
+#include "entropylab_entropy.h"
+#include "entropylab_passphrase.h"
+#include "entropylab_secure.h"
+#include <furi.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAG "EntropyLab_Bulk"
+
+#define BULK_WORD_SIZE sizeof(((PassphraseSDContext*)0)->current_word)
+#define BULK_MAX_WORDS (FLIPPER_RNG_BULK_BATCH * PASSPHRASE_MAX_WORDS)
+
+typedef struct {
+    uint16_t indices[BULK_MAX_WORDS];
+    uint32_t order[BULK_MAX_WORDS];  // (word index << 16) | slot, sorted to read in list order
+    char words[BULK_MAX_WORDS][BULK_WORD_SIZE];
+    uint8_t key[FLIPPER_RNG_BULK_BATCH * FLIPPER_RNG_BULK_MAX_KEY_BYTES];
+    uint8_t chunk[FLIPPER_RNG_BULK_CHUNK];
+    size_t chunk_fill;
+} BulkScratch;
+
+static int bulk_compare_order(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void bulk_flush(BulkScratch* scratch, FlipperRngBulkWriteCallback write, void* context, FlipperRngBulkStats* stats) {
+    if(scratch->chunk_fill == 0) return;
+    write(scratch->chunk, scratch->chunk_fill, context);
+    stats->bytes_out += scratch->chunk_fill;
+    scratch->chunk_fill = 0;
+}
+
+// Reserve room for one line, flushing first if it would not fit
+static char* bulk_line(
+    BulkScratch* scratch,
+    size_t length,
+    FlipperRngBulkWriteCallback write,
+    void* context,
+    FlipperRngBulkStats* stats) {
+    if(scratch->chunk_fill + length > sizeof(scratch->chunk)) {
+        bulk_flush(scratch, write, context, stats);
+    }
+    char* line = (char*)&scratch->chunk[scratch->chunk_fill];
+    scratch->chunk_fill += length;
+    return line;
+}
+
+// Look the batch's words up in ascending index order, which is file offset order
+static bool bulk_fetch_words(PassphraseSDContext* sd_context, BulkScratch* scratch, size_t total) {
+    for(size_t i = 0; i < total; i++) {
+        scratch->order[i] = ((uint32_t)scratch->indices[i] << 16) | i;
+    }
+    qsort(scratch->order, total, sizeof(uint32_t), bulk_compare_order);
+
+    for(size_t i = 0; i < total; i++) {
+        uint16_t slot = scratch->order[i] & 0xFFFF;
+        const char* word = flipper_rng_passphrase_sd_get_word_indexed(sd_context, scratch->order[i] >> 16);
+        if(!word) return false;
+        strlcpy(scratch->words[slot], word, BULK_WORD_SIZE);
+    }
+    return true;
+}
+
+static size_t bulk_hex(const uint8_t* key, size_t key_bytes, char* out) {
+    static const char digits[] = "0123456789abcdef";
+    for(size_t i = 0; i < key_bytes; i++) {
+        out[2 * i] = digits[key[i] >> 4];
+        out[2 * i + 1] = digits[key[i] & 0x0F];
+    }
+    return 2 * key_bytes;
+}
+
+static size_t bulk_base32(const uint8_t* key, size_t key_bytes, char* out) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+    size_t length = 0;
+    uint32_t buffer = 0;
+    uint8_t bits = 0;
+    for(size_t i = 0; i < key_bytes; i++) {
+        buffer = (buffer << 8) | key[i];
+        bits += 8;
+        while(bits >= 5) {
+            out[length++] = alphabet[(buffer >> (bits - 5)) & 0x1F];
+            bits -= 5;
+        }
+    }
+    if(bits > 0) {
+        out[length++] = alphabet[(buffer << (5 - bits)) & 0x1F];
+    }
+    return length;
+}
+
+// Entropy credit one batch debits: index bits per word, or every key bit
+static uint32_t bulk_batch_bits(const FlipperRngBulkConfig* config, uint16_t word_count, size_t batch) {
+    if(config->format != FlipperRngBulkPassphrase) return (uint32_t)(batch * config->key_bytes * 8);
+    return (uint32_t)(batch * config->num_words) * flipper_rng_passphrase_index_bits(word_count);
+}
+
+static size_t bulk_key_chars(FlipperRngBulkFormat format, size_t key_bytes) {
+    return format == FlipperRngBulkHex ? 2 * key_bytes : (key_bytes * 8 + 4) / 5;
+}
+
+void flipper_rng_bulk_config_default(FlipperRngBulkConfig* config) {
+    memset(config, 0, sizeof(FlipperRngBulkConfig));
+    config->format = FlipperRngBulkPassphrase;
+    config->count = FLIPPER_RNG_BULK_DEFAULT_COUNT;
+    config->num_words = PASSPHRASE_DEFAULT_WORDS;
+    config->key_bytes = FLIPPER_RNG_BULK_KEY_BYTES;
+}
+
+const char* flipper_rng_bulk_format_name(FlipperRngBulkFormat format) {
+    switch(format) {
+    case FlipperRngBulkPassphrase:
+        return "passphrases";
+    case FlipperRngBulkHex:
+        return "hex keys";
+    case FlipperRngBulkBase32:
+        return "base32 keys";
+    default:
+        return "items";
+    }
+}
+
+bool flipper_rng_bulk_generate(
+    FlipperRngState* state,
+    PassphraseSDContext* sd_context,
+    const FlipperRngBulkConfig* config,
+    FlipperRngBulkWriteCallback write,
+    void* context,
+    FlipperRngBulkStats* stats) {
+    memset(stats, 0, sizeof(FlipperRngBulkStats));
+    if(!state || !config || !write) return false;
+
+    bool passphrases = config->format == FlipperRngBulkPassphrase;
+    if(passphrases &&
+       (!flipper_rng_passphrase_sd_is_indexed(sd_context) || config->num_words < PASSPHRASE_MIN_WORDS ||
+        config->num_words > PASSPHRASE_MAX_WORDS)) {
+        FURI_LOG_E(TAG, "Passphrases need an indexed wordlist and %d-%d words", PASSPHRASE_MIN_WORDS, PASSPHRASE_MAX_WORDS);
+        return false;
+    }
+    if(!passphrases && (config->key_bytes == 0 || config->key_bytes > FLIPPER_RNG_BULK_MAX_KEY_BYTES)) {
+        FURI_LOG_E(TAG, "Key size must be 1-%d bytes", FLIPPER_RNG_BULK_MAX_KEY_BYTES);
+        return false;
+    }
+
+    // About 9 KB, too much for any thread stack
+    BulkScratch* scratch = malloc(sizeof(BulkScratch));
+    if(!scratch) {
+        FURI_LOG_E(TAG, "Failed to allocate %zu byte scratch", sizeof(BulkScratch));
+        return false;
+    }
+    scratch->chunk_fill = 0;
+
+    bool ok = true;
+    uint32_t start = furi_get_tick();
+
+    while(stats->generated < config->count) {
+        if(config->cancel && atomic_load(config->cancel)) break;
+        size_t batch = MIN(config->count - stats->generated, (uint32_t)FLIPPER_RNG_BULK_BATCH);
+        
+        // The whole batch's credit is spent before any of it is drawn
+        uint32_t bits = bulk_batch_bits(config, passphrases ? sd_context->word_count : 0, batch);
+        if(!flipper_rng_debit_entropy_wait(state, bits, config->wait_for_credit ? FuriWaitForever : 0, config->cancel)) {
+            if(config->cancel && atomic_load(config->cancel)) break;
+            FURI_LOG_E(TAG, "Out of entropy credit after %lu items", stats->generated);
+            ok = false;
+            break;
+        }
+
+        if(passphrases) {
+            size_t total = batch * config->num_words;
+            flipper_rng_passphrase_draw_indices(state, scratch->indices, total, sd_context->word_count);
+            if(!bulk_fetch_words(sd_context, scratch, total)) {
+                FURI_LOG_E(TAG, "Word lookup failed after %lu items", stats->generated);
+                ok = false;
+                break;
+            }
+
+            for(size_t item = 0; item < batch; item++) {
+                const char(*words)[BULK_WORD_SIZE] = &scratch->words[item * config->num_words];
+                size_t length = 0;
+                for(uint8_t w = 0; w < config->num_words; w++) {
+                    length += strlen(words[w]) + 1;
+                }
+                char* line = bulk_line(scratch, length, write, context, stats);
+                for(uint8_t w = 0; w < config->num_words; w++) {
+                    size_t word_length = strlen(words[w]);
+                    memcpy(line, words[w], word_length);
+                    line[word_length] = (w + 1 < config->num_words) ? ' ' : '\n';
+                    line += word_length + 1;
+                }
+            }
+        } else {
+            flipper_rng_extract_random_bytes(state, scratch->key, batch * config->key_bytes);
+            size_t chars = bulk_key_chars(config->format, config->key_bytes);
+            for(size_t item = 0; item < batch; item++) {
+                const uint8_t* key = &scratch->key[item * config->key_bytes];
+                char* line = bulk_line(scratch, chars + 1, write, context, stats);
+                if(config->format == FlipperRngBulkHex) {
+                    bulk_hex(key, config->key_bytes, line);
+                } else {
+                    bulk_base32(key, config->key_bytes, line);
+                }
+                line[chars] = '\n';
+            }
+        }
+
+        stats->generated += batch;
+    }
+
+    bulk_flush(scratch, write, context, stats);
+    stats->elapsed_ms = furi_get_tick() - start;
+    stats->per_sec = stats->elapsed_ms ? (uint32_t)((uint64_t)stats->generated * 1000 / stats->elapsed_ms) : 0;
+
+    // Every buffer here held credentials
+    secure_wipe(scratch, sizeof(BulkScratch));
+    free(scratch);
+    if(passphrases) {
+        flipper_rng_passphrase_sd_wipe_cache(sd_context);
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "Generated %lu %s in %lu ms (%lu/s)",
+        stats->generated,
+        flipper_rng_bulk_format_name(config->format),
+        stats->elapsed_ms,
+        stats->per_sec);
+    return ok;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+/**
+ * Bulk credential generation
+ * Produces many passphrases or raw keys per run and streams them, one per
+ * line, through a write callback (UART or the SD file writer on the device,
+ * stdout in the host build). Items are made FLIPPER_RNG_BULK_BATCH at a time:
+ * all of a batch's random bytes come from one draw, and a batch's word
+ * lookups are done in wordlist order so SD-backed reads only move forward.
+ * Every batch debits the entropy credit it uses before any of it is drawn,
+ * keys and passphrases alike. With wait_for_credit set it waits for that
+ * credit, holding a claim streaming output cannot take, so output never
+ * outruns the sources; without it the run stops early, returning false,
+ * once credit runs out.
+ */
+
+#include "entropylab.h"
+#include "entropylab_passphrase_sd.h"
+#include <stdatomic.h>
+
+#define FLIPPER_RNG_BULK_BATCH 16           // Items per random draw and per sorted lookup pass
+#define FLIPPER_RNG_BULK_CHUNK 512          // Bytes handed to the write callback at a time
+#define FLIPPER_RNG_BULK_DEFAULT_COUNT 1000
+#define FLIPPER_RNG_BULK_KEY_BYTES 32       // Default key size, 256 bits
+#define FLIPPER_RNG_BULK_MAX_KEY_BYTES 64
+#define FLIPPER_RNG_BULK_FILE_PATH "/ext/apps_data/entropylab/bulk.txt"
+
+typedef enum {
+    FlipperRngBulkPassphrase,  // Space-separated words from the loaded wordlist
+    FlipperRngBulkHex,         // Lowercase hex key
+    FlipperRngBulkBase32,      // RFC 4648 base32 key, no padding
+} FlipperRngBulkFormat;
+
+typedef struct {
+    FlipperRngBulkFormat format;
+    uint32_t count;        // Items to generate
+    uint8_t num_words;     // Passphrase length, PASSPHRASE_MIN_WORDS..PASSPHRASE_MAX_WORDS
+    uint16_t key_bytes;    // Key length, 1..FLIPPER_RNG_BULK_MAX_KEY_BYTES
+    atomic_bool* cancel;   // Optional, stops the run at the next batch when set
+    bool wait_for_credit;  // Hold each batch until the pool has credit for it
+} FlipperRngBulkConfig;
+
+typedef struct {
+    uint32_t generated;
+    uint32_t bytes_out;
+    uint32_t elapsed_ms;
+    uint32_t per_sec;      // Items per second
+} FlipperRngBulkStats;
+
+// Receives output in chunks of whole lines
+typedef void (*FlipperRngBulkWriteCallback)(const uint8_t* data, size_t length, void* context);
+
+void flipper_rng_bulk_config_default(FlipperRngBulkConfig* config);
+
+const char* flipper_rng_bulk_format_name(FlipperRngBulkFormat format);
+
+// Generate config->count items; passphrases need an indexed wordlist in sd_context
+// Returns false on bad arguments, allocation or lookup failure; stats covers what was written
+bool flipper_rng_bulk_generate(
+    FlipperRngState* state,
+    PassphraseSDContext* sd_context,
+    const FlipperRngBulkConfig* config,
+    FlipperRngBulkWriteCallback write,
+    void* context,
+    FlipperRngBulkStats* stats);
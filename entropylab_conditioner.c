@@ -0,0 +1,51 @@
+#include "entropylab_conditioner.h"
+#include "entropylab_secure.h"
+
+#ifdef FLIPPER_RNG_CONDITIONER_SHA256
+#define conditioner_hash_init(hash) flipper_rng_sha256_init(hash)
+#define conditioner_hash_update(hash, data, length) flipper_rng_sha256_update(hash, data, length)
+#define conditioner_hash_final(hash, digest) flipper_rng_sha256_final(hash, digest)
+#define CONDITIONER_NAME "sha256"
+#else
+#define conditioner_hash_init(hash) flipper_rng_blake2s_init(hash, FLIPPER_RNG_BLAKE2S_DIGEST_SIZE)
+#define conditioner_hash_update(hash, data, length) flipper_rng_blake2s_update(hash, data, length)
+#define conditioner_hash_final(hash, digest) flipper_rng_blake2s_final(hash, digest)
+#define CONDITIONER_NAME "blake2s"
+#endif
+
+void flipper_rng_conditioner_begin(FlipperRngConditioner* conditioner) {
+    conditioner_hash_init(&conditioner->hash);
+    conditioner->raw_bits = 0;
+    conditioner->raw_bytes = 0;
+}
+
+void flipper_rng_conditioner_add(FlipperRngConditioner* conditioner, const void* raw, size_t length, uint32_t bits) {
+    conditioner_hash_update(&conditioner->hash, (const uint8_t*)raw, length);
+    conditioner->raw_bits += bits;
+    conditioner->raw_bytes += length;
+}
+
+void flipper_rng_conditioner_add_word(FlipperRngConditioner* conditioner, uint32_t raw, uint32_t bits) {
+    uint8_t bytes[4] = {(uint8_t)raw, (uint8_t)(raw >> 8), (uint8_t)(raw >> 16), (uint8_t)(raw >> 24)};
+    flipper_rng_conditioner_add(conditioner, bytes, sizeof(bytes), bits);
+    secure_wipe(bytes, sizeof(bytes));
+}
+
+void flipper_rng_conditioner_credit(FlipperRngConditioner* conditioner, uint32_t bits) {
+    conditioner->raw_bits += bits;
+}
+
+uint32_t flipper_rng_conditioner_finish(
+    FlipperRngConditioner* conditioner,
+    uint8_t digest[FLIPPER_RNG_CONDITIONER_OUTPUT]) {
+    conditioner_hash_final(&conditioner->hash, digest);
+    uint32_t bits = conditioner->raw_bits;
+    if(bits > FLIPPER_RNG_CONDITIONER_OUTPUT * 8) bits = FLIPPER_RNG_CONDITIONER_OUTPUT * 8;
+    conditioner->raw_bits = 0;
+    conditioner->raw_bytes = 0;
+    return bits;
+}
+
+const char* flipper_rng_conditioner_name(void) {
+    return CONDITIONER_NAME;
+}
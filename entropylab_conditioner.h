@@ -0,0 +1,50 @@
+#pragma once
+
+/**
+ * Vetted conditioning for raw SubGHz and IR measurements (SP 800-90B 3.1.5.1)
+ * Producers hash a whole batch of raw readings (one frequency's RSSI/LQI
+ * samples, one IR signal's timings) and queue the digest instead of folding
+ * each reading in with shifts and constants, so the hash cost is paid once
+ * per batch rather than per reading. flipper_rng_condition_raw(), or the drain
+ * for readings queued with flipper_rng_push_raw(), health tests and estimates
+ * every reading first and hashes only those that pass, since the digest would
+ * hide a stuck source from the tests.
+ *
+ * The backend is chosen at compile time: BLAKE2s by default, SHA-256 with
+ * FLIPPER_RNG_CONDITIONER_SHA256 defined (cdefines in application.fam, or
+ * CONDITIONER=sha256 for the host build).
+ */
+
+#include "entropylab_sha256.h"
+#include "entropylab_blake2s.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#define FLIPPER_RNG_CONDITIONER_OUTPUT 32  // Digest bytes, both backends
+
+typedef struct {
+#ifdef FLIPPER_RNG_CONDITIONER_SHA256
+    FlipperRngSha256 hash;
+#else
+    FlipperRngBlake2s hash;
+#endif
+    uint32_t raw_bits;  // Entropy credited to the raw input so far
+    uint32_t raw_bytes;
+} FlipperRngConditioner;
+
+void flipper_rng_conditioner_begin(FlipperRngConditioner* conditioner);
+
+// Absorb raw bytes assessed at bits of entropy
+void flipper_rng_conditioner_add(FlipperRngConditioner* conditioner, const void* raw, size_t length, uint32_t bits);
+void flipper_rng_conditioner_add_word(FlipperRngConditioner* conditioner, uint32_t raw, uint32_t bits);
+
+// Credit bits to input already absorbed, for batches assessed after the fact
+void flipper_rng_conditioner_credit(FlipperRngConditioner* conditioner, uint32_t bits);
+
+// Write the digest, returns the bits it carries: the raw credit, capped at the output size
+uint32_t flipper_rng_conditioner_finish(
+    FlipperRngConditioner* conditioner,
+    uint8_t digest[FLIPPER_RNG_CONDITIONER_OUTPUT]);
+
+// "blake2s" or "sha256"
+const char* flipper_rng_conditioner_name(void);
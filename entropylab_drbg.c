@@ -0,0 +1,138 @@
+/**
+ * NIST SP 800-90A CTR_DRBG (AES-256, no derivation function)
+ * Counter blocks for a whole request are built first and encrypted in one
+ * call, so the AES1 key is loaded once per update/generate instead of per block.
+ */
+
+#include "entropylab_drbg.h"
+#include "entropylab_aes.h"
+#include "entropylab_hw_accel.h"
+#include "entropylab_secure.h"
+#include <string.h>
+
+// Counter blocks encrypted per AES call (bounds stack use for large requests)
+#define DRBG_CHUNK_BLOCKS 16
+
+// V = (V + 1) mod 2^128, big-endian
+static void drbg_increment_v(uint8_t v[FLIPPER_RNG_DRBG_BLOCK_SIZE]) {
+    for(int i = FLIPPER_RNG_DRBG_BLOCK_SIZE - 1; i >= 0; i--) {
+        if(++v[i] != 0) break;
+    }
+}
+
+static void drbg_encrypt_blocks(const uint8_t* key, uint8_t* blocks, size_t count) {
+    if(flipper_rng_hw_aes_encrypt_blocks(key, blocks, blocks, count)) return;
+
+    FlipperRngAes256 aes;
+    flipper_rng_aes256_init(&aes, key);
+    for(size_t i = 0; i < count; i++) {
+        uint8_t* block = &blocks[i * FLIPPER_RNG_AES_BLOCK_SIZE];
+        flipper_rng_aes256_encrypt_block(&aes, block, block);
+    }
+    flipper_rng_aes256_wipe(&aes);
+}
+
+// CTR_DRBG_Update: derive the next Key and V, XORing in provided_data (seedlen bytes or NULL)
+static void drbg_update(FlipperRngDrbg* drbg, const uint8_t* provided_data, size_t provided_len) {
+    uint8_t temp[FLIPPER_RNG_DRBG_SEED_SIZE];
+
+    for(size_t i = 0; i < FLIPPER_RNG_DRBG_SEED_SIZE; i += FLIPPER_RNG_DRBG_BLOCK_SIZE) {
+        drbg_increment_v(drbg->v);
+        memcpy(&temp[i], drbg->v, FLIPPER_RNG_DRBG_BLOCK_SIZE);
+    }
+    drbg_encrypt_blocks(drbg->key, temp, FLIPPER_RNG_DRBG_SEED_SIZE / FLIPPER_RNG_DRBG_BLOCK_SIZE);
+
+    // Shorter inputs are zero-padded to seedlen, which leaves the tail unchanged
+    for(size_t i = 0; i < provided_len && i < FLIPPER_RNG_DRBG_SEED_SIZE; i++) {
+        temp[i] ^= provided_data[i];
+    }
+
+    memcpy(drbg->key, temp, FLIPPER_RNG_DRBG_KEY_SIZE);
+    memcpy(drbg->v, &temp[FLIPPER_RNG_DRBG_KEY_SIZE], FLIPPER_RNG_DRBG_BLOCK_SIZE);
+    secure_wipe(temp, sizeof(temp));
+}
+
+static void drbg_seed(
+    FlipperRngDrbg* drbg,
+    const uint8_t* entropy_input,
+    const uint8_t* extra,
+    size_t extra_len) {
+    uint8_t seed_material[FLIPPER_RNG_DRBG_SEED_SIZE];
+    memcpy(seed_material, entropy_input, FLIPPER_RNG_DRBG_SEED_SIZE);
+    for(size_t i = 0; extra && i < extra_len && i < FLIPPER_RNG_DRBG_SEED_SIZE; i++) {
+        seed_material[i] ^= extra[i];
+    }
+
+    drbg_update(drbg, seed_material, sizeof(seed_material));
+    drbg->reseed_counter = 1;
+    secure_wipe(seed_material, sizeof(seed_material));
+}
+
+void flipper_rng_drbg_instantiate(
+    FlipperRngDrbg* drbg,
+    const uint8_t* entropy_input,
+    const uint8_t* personalization,
+    size_t personalization_len) {
+    memset(drbg->key, 0, sizeof(drbg->key));
+    memset(drbg->v, 0, sizeof(drbg->v));
+    drbg_seed(drbg, entropy_input, personalization, personalization_len);
+    drbg->instantiated = true;
+}
+
+void flipper_rng_drbg_reseed(
+    FlipperRngDrbg* drbg,
+    const uint8_t* entropy_input,
+    const uint8_t* additional,
+    size_t additional_len) {
+    drbg_seed(drbg, entropy_input, additional, additional_len);
+}
+
+bool flipper_rng_drbg_needs_reseed(const FlipperRngDrbg* drbg) {
+    return !drbg->instantiated || drbg->reseed_counter > FLIPPER_RNG_DRBG_RESEED_INTERVAL;
+}
+
+bool flipper_rng_drbg_generate(
+    FlipperRngDrbg* drbg,
+    uint8_t* output,
+    size_t length,
+    const uint8_t* additional,
+    size_t additional_len) {
+    if(flipper_rng_drbg_needs_reseed(drbg) || length > FLIPPER_RNG_DRBG_MAX_REQUEST) {
+        return false;
+    }
+
+    if(additional && additional_len > 0) {
+        drbg_update(drbg, additional, additional_len);
+    } else {
+        additional_len = 0;
+    }
+
+    uint8_t blocks[DRBG_CHUNK_BLOCKS * FLIPPER_RNG_DRBG_BLOCK_SIZE];
+    size_t offset = 0;
+    while(offset < length) {
+        size_t remaining = length - offset;
+        size_t count = (remaining + FLIPPER_RNG_DRBG_BLOCK_SIZE - 1) / FLIPPER_RNG_DRBG_BLOCK_SIZE;
+        if(count > DRBG_CHUNK_BLOCKS) count = DRBG_CHUNK_BLOCKS;
+
+        for(size_t i = 0; i < count; i++) {
+            drbg_increment_v(drbg->v);
+            memcpy(&blocks[i * FLIPPER_RNG_DRBG_BLOCK_SIZE], drbg->v, FLIPPER_RNG_DRBG_BLOCK_SIZE);
+        }
+        drbg_encrypt_blocks(drbg->key, blocks, count);
+
+        size_t produced = count * FLIPPER_RNG_DRBG_BLOCK_SIZE;
+        if(produced > remaining) produced = remaining;
+        memcpy(&output[offset], blocks, produced);
+        offset += produced;
+    }
+    secure_wipe(blocks, sizeof(blocks));
+
+    // Backtracking resistance: rekey after every request
+    drbg_update(drbg, additional_len ? additional : NULL, additional_len);
+    drbg->reseed_counter++;
+    return true;
+}
+
+void flipper_rng_drbg_wipe(FlipperRngDrbg* drbg) {
+    secure_wipe(drbg, sizeof(FlipperRngDrbg));
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+/**
+ * NIST SP 800-90A CTR_DRBG, AES-256, no derivation function
+ * Block encryption uses the AES1 peripheral when it is free and the portable
+ * software AES otherwise, so output is identical on device and host.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define FLIPPER_RNG_DRBG_KEY_SIZE 32
+#define FLIPPER_RNG_DRBG_BLOCK_SIZE 16
+#define FLIPPER_RNG_DRBG_SEED_SIZE 48          // seedlen = keylen + blocklen
+#define FLIPPER_RNG_DRBG_MAX_REQUEST 65536     // 2^19 bits per generate call
+#define FLIPPER_RNG_DRBG_RESEED_INTERVAL 4096  // Generate calls before a reseed is forced
+
+typedef struct {
+    uint8_t key[FLIPPER_RNG_DRBG_KEY_SIZE];
+    uint8_t v[FLIPPER_RNG_DRBG_BLOCK_SIZE];
+    uint32_t reseed_counter;
+    bool instantiated;
+} FlipperRngDrbg;
+
+// entropy_input is seedlen bytes; personalization/additional input may be NULL and is at most seedlen bytes
+void flipper_rng_drbg_instantiate(
+    FlipperRngDrbg* drbg,
+    const uint8_t* entropy_input,
+    const uint8_t* personalization,
+    size_t personalization_len);
+void flipper_rng_drbg_reseed(
+    FlipperRngDrbg* drbg,
+    const uint8_t* entropy_input,
+    const uint8_t* additional,
+    size_t additional_len);
+
+// Returns false without producing output if the DRBG needs (re)seeding or the request is too large
+bool flipper_rng_drbg_generate(
+    FlipperRngDrbg* drbg,
+    uint8_t* output,
+    size_t length,
+    const uint8_t* additional,
+    size_t additional_len);
+
+bool flipper_rng_drbg_needs_reseed(const FlipperRngDrbg* drbg);
+void flipper_rng_drbg_wipe(FlipperRngDrbg* drbg);
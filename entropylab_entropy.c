@@ -1,5 +1,8 @@
 #include "entropylab_entropy.h"
 #include "entropylab_hw_accel.h"
+#include "entropylab_drbg.h"
+#include "entropylab_secure.h"
+#include "entropylab_subghz.h"
 #include <furi.h>
 #include <furi_hal.h>
 #include <furi_hal_random.h>
@@ -7,14 +10,14 @@
 #include <furi_hal_infrared.h>
 #include <furi_hal_subghz.h>
 #include <furi_hal_light.h>
-#include <lib/subghz/devices/cc1101_configs.h>
-#include <lib/drivers/cc1101_regs.h>
 #include <infrared.h>
 #include <infrared_worker.h>
 #include <infrared_transmit.h>
 
 #define TAG "EntropyLab"
 
+_Static_assert(FLIPPER_RNG_FORTUNA_SOURCES == FlipperRngSourceCount + 1, "One Fortuna slot per source plus untagged");
+
 // Initialize entropy sources - High quality only
 void flipper_rng_init_entropy_sources(FlipperRngState* state) {
     FURI_LOG_I(TAG, "Initializing high-quality entropy sources: 0x%02lX", (unsigned long)state->entropy_sources);
@@ -28,19 +31,16 @@ void flipper_rng_init_entropy_sources(FlipperRngState* state) {
 }
 
 void flipper_rng_deinit_entropy_sources(FlipperRngState* state) {
-    UNUSED(state);
-    
-    // Clean up SubGHz mutex if allocated
-    extern FuriMutex* subghz_mutex;
-    if(subghz_mutex) {
-        // Make sure mutex is not locked before freeing
-        // Try to release in case it's stuck locked
-        furi_mutex_release(subghz_mutex);  // Safe even if not locked
-        furi_mutex_free(subghz_mutex);
-        subghz_mutex = NULL;
-        FURI_LOG_I(TAG, "SubGHz mutex freed");
+    // Don't leave DRBG key material behind in freed memory
+    if(state) {
+        flipper_rng_drbg_wipe(&state->drbg);
+        secure_wipe(state->drbg_reserve, sizeof(state->drbg_reserve));
+        state->drbg_reserve_len = 0;
     }
     
+    // Abort any sweep in progress and free the SubGHz mutex
+    flipper_rng_subghz_sweep_deinit();
+    
     // Reset Sub-GHz to clean state for other apps
     // This ensures we don't leave the radio in a modified state
     furi_hal_subghz_reset();
@@ -120,6 +120,53 @@ uint32_t flipper_rng_get_temperature_noise(void) {
     return (temp_conv.i & 0xFFFF) ^ (charge << 8) ^ (furi_get_tick() << 16);
 }
 
+// In Fortuna mode the DRBG only counts as seeded after its first reseed from the Fortuna pools;
+// until then no credit can be spent, so nothing is generated for output
+// Caller must hold state->mutex
+static bool flipper_rng_seeded(FlipperRngState* state) {
+    return state->mixing_mode != MixingModeFortuna || state->fortuna.reseed_count > 0;
+}
+
+// Ready once the credit covers the CTR_DRBG's strength and the DRBG is seeded
+// Caller must hold state->mutex
+static void flipper_rng_update_ready(FlipperRngState* state) {
+    state->entropy_ready = state->entropy_credit >= RNG_CREDIT_READY_BITS && flipper_rng_seeded(state);
+}
+
+// Add credited bits, capped at what the pool can hold - caller must hold state->mutex
+static void flipper_rng_credit_entropy(FlipperRngState* state, uint32_t bits) {
+    uint32_t room = RNG_CREDIT_MAX_BITS - state->entropy_credit;
+    state->entropy_credit += (bits < room) ? bits : room;
+    flipper_rng_update_ready(state);
+}
+
+// XOR up to 4 bytes of a sample into the pool at the write position
+// Caller must hold state->mutex
+static void flipper_rng_pool_add(FlipperRngState* state, uint32_t entropy, uint8_t bits) {
+    if(state->mixing_mode == MixingModeFortuna) {
+        // Untagged input gets its own Fortuna slot
+        flipper_rng_fortuna_add(&state->fortuna, FlipperRngSourceCount, entropy, bits);
+        bits = (bits > 32) ? (bits - 32) : 0;
+    } else {
+        // Add entropy bytes to pool
+        for(int i = 0; i < 4 && bits > 0; i++) {
+            uint8_t byte = (entropy >> (i * 8)) & 0xFF;
+            
+            // XOR with existing pool data
+            state->entropy_pool[state->entropy_pool_pos] ^= byte;
+            state->dirty_regions |= (uint16_t)(1u << (state->entropy_pool_pos >> RNG_POOL_REGION_SHIFT));
+            
+            // Rotate through pool
+            state->entropy_pool_pos = (state->entropy_pool_pos + 1) % RNG_POOL_SIZE;
+            
+            bits = (bits > 8) ? (bits - 8) : 0;
+        }
+    }
+    
+    state->samples_collected++;
+    state->last_entropy_bits = bits;
+}
+
 // Add entropy to the pool
 void flipper_rng_add_entropy(FlipperRngState* state, uint32_t entropy, uint8_t bits) {
     if(!state || !state->mutex) {
@@ -133,26 +180,425 @@ void flipper_rng_add_entropy(FlipperRngState* state, uint32_t entropy, uint8_t b
         return;
     }
     
-    // Add entropy bytes to pool
-    for(int i = 0; i < 4 && bits > 0; i++) {
-        uint8_t byte = (entropy >> (i * 8)) & 0xFF;
+    flipper_rng_pool_add(state, entropy, bits);
+    flipper_rng_credit_entropy(state, bits);
+    
+    furi_mutex_release(state->mutex);
+}
+
+// Per-source bit counter for a FlipperRngSourceId, NULL for unknown sources
+static uint32_t* flipper_rng_source_bits(FlipperRngState* state, uint8_t source) {
+    switch(source) {
+    case FlipperRngSourceHardwareRNG:
+        return &state->bits_from_hw_rng;
+    case FlipperRngSourceSubGhzRSSI:
+        return &state->bits_from_subghz_rssi;
+    case FlipperRngSourceInfrared:
+        return &state->bits_from_infrared;
+    default:
+        return NULL;
+    }
+}
+
+// Estimate and health test one raw sample, false if it must be discarded
+// Caller must hold state->mutex
+static bool flipper_rng_test_sample(FlipperRngState* state, uint8_t source, uint32_t sample, uint8_t bits) {
+    flipper_rng_estimator_add(&state->estimators[source], sample, bits);
+    FlipperRngHealthResult health = flipper_rng_health_test(&state->health[source], sample, bits);
+    if(health == FlipperRngHealthFailed) {
+        FURI_LOG_W(
+            TAG,
+            "Source %u failed health tests (RCT %lu, APT %lu), quarantined",
+            source,
+            state->health[source].rct_failures,
+            state->health[source].apt_failures);
+    }
+    return health == FlipperRngHealthPass;
+}
+
+// Fold a batch into the pool and credit each source - caller must hold state->mutex
+// Samples that fail the health tests, or arrive while their source is quarantined, are skipped
+// Same byte layout as flipper_rng_pool_add(), with the position kept in a local
+static uint32_t flipper_rng_pool_add_batch(FlipperRngState* state, const FlipperRngSample* samples, size_t count) {
+    bool fortuna = state->mixing_mode == MixingModeFortuna;
+    size_t pos = state->entropy_pool_pos;
+    uint32_t credited = 0;
+    uint8_t last_bits = 0;
+    uint16_t dirty = state->dirty_regions;
+    
+    size_t accepted = 0;
+    
+    for(size_t i = 0; i < count; i++) {
+        uint32_t entropy = samples[i].sample;
+        uint8_t bits = samples[i].bits;
+        uint8_t source = samples[i].source & ~FLIPPER_RNG_SOURCE_CONDITIONED;
+        bool conditioned = samples[i].source & FLIPPER_RNG_SOURCE_CONDITIONED;
         
-        // XOR with existing pool data
-        state->entropy_pool[state->entropy_pool_pos] ^= byte;
+        // Raw samples are estimated and health tested before any of their bytes reach the pool;
+        // conditioned digests were tested as raw readings by flipper_rng_condition_raw() or the drain
+        if(source < FlipperRngSourceCount && !conditioned &&
+           !flipper_rng_test_sample(state, source, entropy, bits)) {
+            continue;
+        }
         
-        // Rotate through pool
-        state->entropy_pool_pos = (state->entropy_pool_pos + 1) % RNG_POOL_SIZE;
+        uint32_t* source_bits = flipper_rng_source_bits(state, source);
+        if(source_bits) *source_bits += bits;
+        credited += bits;
+        accepted++;
         
-        bits = (bits > 8) ? (bits - 8) : 0;
+        if(fortuna) {
+            flipper_rng_fortuna_add(&state->fortuna, source, entropy, bits);
+            last_bits = (bits > 32) ? (bits - 32) : 0;
+            continue;
+        }
+        
+        for(int b = 0; b < 4 && bits > 0; b++) {
+            state->entropy_pool[pos] ^= (uint8_t)(entropy >> (b * 8));
+            dirty |= (uint16_t)(1u << (pos >> RNG_POOL_REGION_SHIFT));
+            if(++pos == RNG_POOL_SIZE) pos = 0;
+            bits = (bits > 8) ? (bits - 8) : 0;
+        }
+        last_bits = bits;
     }
     
-    state->samples_collected++;
-    state->last_entropy_bits = bits;
+    state->entropy_pool_pos = pos;
+    state->dirty_regions = dirty;
+    state->samples_collected += accepted;
+    if(accepted) state->last_entropy_bits = last_bits;
+    flipper_rng_credit_entropy(state, credited);
+    return credited;
+}
+
+uint32_t flipper_rng_add_entropy_batch(FlipperRngState* state, const FlipperRngSample* samples, size_t count) {
+    if(!state || !state->mutex || !samples) {
+        FURI_LOG_E(TAG, "add_entropy_batch: Invalid state or samples");
+        return 0;
+    }
+    if(count == 0) return 0;
+    
+    if(furi_mutex_acquire(state->mutex, 100) != FuriStatusOk) {
+        FURI_LOG_W(TAG, "add_entropy_batch: Could not acquire mutex, %zu samples discarded", count);
+        return 0;
+    }
+    
+    uint32_t credited = flipper_rng_pool_add_batch(state, samples, count);
+    
+    furi_mutex_release(state->mutex);
+    return credited;
+}
+
+void flipper_rng_set_mixing_mode(FlipperRngState* state, MixingMode mode) {
+    if(!state || !state->mutex) return;
+    furi_mutex_acquire(state->mutex, FuriWaitForever);
+    state->mixing_mode = mode;
+    flipper_rng_update_ready(state);
+    furi_mutex_release(state->mutex);
+}
+
+bool flipper_rng_debit_entropy_wait(
+    FlipperRngState* state,
+    uint32_t bits,
+    uint32_t timeout_ms,
+    const atomic_bool* cancel) {
+    if(!state || !state->mutex || bits > RNG_CREDIT_MAX_BITS) return false;
+    
+    uint32_t start = furi_get_tick();
+    bool claimed = false;
+    bool debited = false;
+    
+    while(true) {
+        if(furi_mutex_acquire(state->mutex, 100) == FuriStatusOk) {
+            // Credit other waiters have claimed is theirs; streaming also leaves the ready reserve
+            uint32_t held = state->entropy_claimed - (claimed ? bits : 0);
+            if(timeout_ms == 0) held += RNG_CREDIT_READY_BITS;
+            debited = flipper_rng_seeded(state) && state->entropy_credit >= held &&
+                      state->entropy_credit - held >= bits;
+            if(debited) {
+                state->entropy_credit -= bits;
+                flipper_rng_update_ready(state);
+            }
+            
+            bool give_up = !debited && ((furi_get_tick() - start >= timeout_ms) ||
+                                        (cancel && atomic_load(cancel)));
+            if(!debited && !give_up && !claimed) {
+                state->entropy_claimed += bits;
+                claimed = true;
+            } else if((debited || give_up) && claimed) {
+                state->entropy_claimed -= bits;
+                claimed = false;
+            }
+            furi_mutex_release(state->mutex);
+            if(debited || give_up) break;
+        } else if(!claimed && furi_get_tick() - start >= timeout_ms) {
+            // A claim can only be dropped under the mutex, so only give up without one
+            break;
+        }
+        furi_delay_ms(1);
+    }
+    return debited;
+}
+
+void flipper_rng_init_sample_rings(FlipperRngState* state) {
+    for(size_t i = 0; i < FlipperRngSourceCount; i++) {
+        flipper_rng_ring_init(&state->sample_rings[i]);
+    }
+}
+
+void flipper_rng_init_health(FlipperRngState* state) {
+    for(size_t i = 0; i < FlipperRngSourceCount; i++) {
+        flipper_rng_health_init(&state->health[i]);
+    }
+}
+
+void flipper_rng_init_estimators(FlipperRngState* state) {
+    for(size_t i = 0; i < FlipperRngSourceCount; i++) {
+        flipper_rng_estimator_init(&state->estimators[i]);
+    }
+}
+
+// Queue a sample without taking the pool mutex - safe from any single producer thread per source
+bool flipper_rng_push_sample(FlipperRngState* state, FlipperRngSourceId source, uint32_t sample, uint8_t bits) {
+    if(!state || source >= FlipperRngSourceCount) return false;
+    return flipper_rng_ring_push(&state->sample_rings[source], sample, bits, (uint8_t)source);
+}
+
+size_t flipper_rng_condition_raw(
+    FlipperRngState* state,
+    FlipperRngSourceId source,
+    FlipperRngConditioner* conditioner,
+    const uint32_t* readings,
+    size_t count,
+    uint8_t bits) {
+    if(!state || !state->mutex || source >= FlipperRngSourceCount) return 0;
+    if(furi_mutex_acquire(state->mutex, 100) != FuriStatusOk) return 0;
+    
+    size_t passed = 0;
+    for(size_t i = 0; i < count; i++) {
+        if(flipper_rng_test_sample(state, source, readings[i], bits)) {
+            flipper_rng_conditioner_add(conditioner, &readings[i], sizeof(readings[i]), 0);
+            passed++;
+        }
+    }
+    
+    furi_mutex_release(state->mutex);
+    return passed;
+}
+
+// Same producer-thread rule as flipper_rng_push_sample(); the seed and readings are published as one group
+bool flipper_rng_push_raw(
+    FlipperRngState* state,
+    FlipperRngSourceId source,
+    uint32_t seed,
+    const uint32_t* readings,
+    size_t count,
+    uint8_t bits) {
+    if(!state || !readings || count == 0 || source >= FlipperRngSourceCount) return false;
+    if(count > FLIPPER_RNG_RAW_MAX_READINGS) count = FLIPPER_RNG_RAW_MAX_READINGS;
+    
+    FlipperRngSample group[FLIPPER_RNG_RAW_MAX_READINGS + 2];
+    group[0] = (FlipperRngSample){(uint32_t)count, bits, (uint8_t)source | FLIPPER_RNG_SOURCE_RAW};
+    group[1] = (FlipperRngSample){seed, 0, (uint8_t)source};
+    for(size_t i = 0; i < count; i++) {
+        group[i + 2] = (FlipperRngSample){readings[i], 0, (uint8_t)source};
+    }
+    
+    bool queued = flipper_rng_ring_push_batch(&state->sample_rings[source], group, (unsigned)count + 2);
+    secure_wipe(group, sizeof(group));
+    return queued;
+}
+
+// Finish a conditioner into digest words flagged FLIPPER_RNG_SOURCE_CONDITIONED, until the credit is spent
+static size_t flipper_rng_conditioned_words(
+    FlipperRngConditioner* conditioner,
+    uint8_t source,
+    FlipperRngSample words[FLIPPER_RNG_CONDITIONER_OUTPUT / sizeof(uint32_t)]) {
+    uint8_t digest[FLIPPER_RNG_CONDITIONER_OUTPUT];
+    uint32_t bits = flipper_rng_conditioner_finish(conditioner, digest);
+    uint32_t assigned = 0;
+    size_t count = 0;
+    
+    for(size_t offset = 0; offset < sizeof(digest) && assigned < bits; offset += sizeof(uint32_t)) {
+        memcpy(&words[count].sample, &digest[offset], sizeof(words[count].sample));
+        words[count].bits = (uint8_t)MIN(bits - assigned, 32u);
+        words[count].source = source | FLIPPER_RNG_SOURCE_CONDITIONED;
+        assigned += words[count].bits;
+        count++;
+    }
+    
+    secure_wipe(digest, sizeof(digest));
+    return count;
+}
+
+// Same producer-thread rule as flipper_rng_push_sample(); words go out until the credit is spent
+uint32_t flipper_rng_push_conditioned(FlipperRngState* state, FlipperRngSourceId source, FlipperRngConditioner* conditioner) {
+    FlipperRngSample words[FLIPPER_RNG_CONDITIONER_OUTPUT / sizeof(uint32_t)];
+    size_t count = flipper_rng_conditioned_words(conditioner, (uint8_t)source, words);
+    uint32_t queued = 0;
+    
+    for(size_t i = 0; i < count; i++) {
+        if(!state || source >= FlipperRngSourceCount ||
+           !flipper_rng_ring_push(&state->sample_rings[source], words[i].sample, words[i].bits, words[i].source)) {
+            break;
+        }
+        queued += words[i].bits;
+    }
+    
+    secure_wipe(words, sizeof(words));
+    return queued;
+}
+
+// Health test and condition one group queued by flipper_rng_push_raw(), whose header was just
+// popped, and fold its digest into the pool - caller must hold state->mutex
+// The group was published whole, so its seed and readings are already in the ring
+static uint32_t flipper_rng_pool_add_raw(FlipperRngState* state, FlipperRngSampleRing* ring, const FlipperRngSample* header) {
+    uint8_t source = header->source & ~FLIPPER_RNG_SOURCE_RAW;
+    size_t count = header->sample;
+    if(count == 0) return 0;
+    uint8_t reading_bits = (uint8_t)((header->bits + count - 1) / count);
+    FlipperRngSample reading;
+    
+    FlipperRngConditioner conditioner;
+    flipper_rng_conditioner_begin(&conditioner);
+    if(flipper_rng_ring_pop(ring, &reading)) {
+        flipper_rng_conditioner_add_word(&conditioner, reading.sample, 0);
+    }
+    
+    size_t passed = 0;
+    for(size_t i = 0; i < count && flipper_rng_ring_pop(ring, &reading); i++) {
+        if(flipper_rng_test_sample(state, source, reading.sample, reading_bits)) {
+            flipper_rng_conditioner_add_word(&conditioner, reading.sample, 0);
+            passed++;
+        }
+    }
+    secure_wipe(&reading, sizeof(reading));
+    
+    FURI_LOG_D(TAG, "Raw group from source %u: %zu readings, %zu healthy", source, count, passed);
+    if(passed == 0) {
+        secure_wipe(&conditioner, sizeof(conditioner));
+        return 0;
+    }
+    
+    flipper_rng_conditioner_credit(&conditioner, header->bits * passed / count);
+    FlipperRngSample words[FLIPPER_RNG_CONDITIONER_OUTPUT / sizeof(uint32_t)];
+    size_t word_count = flipper_rng_conditioned_words(&conditioner, source, words);
+    uint32_t credited = flipper_rng_pool_add_batch(state, words, word_count);
+    secure_wipe(words, sizeof(words));
+    return credited;
+}
+
+// Fold every queued sample into the pool in one critical section
+// If the mutex is busy the samples simply wait in their rings for the next drain
+uint32_t flipper_rng_drain_samples(FlipperRngState* state) {
+    if(!state || !state->mutex) {
+        FURI_LOG_E(TAG, "drain_samples: Invalid state or mutex");
+        return 0;
+    }
+    
+    if(furi_mutex_acquire(state->mutex, 100) != FuriStatusOk) {
+        FURI_LOG_W(TAG, "drain_samples: Could not acquire mutex, samples kept queued");
+        return 0;
+    }
+    
+    // Pop into a small stack batch (worker stack is only 4KB) and fold with the batch path
+    uint32_t credited = 0;
+    FlipperRngSample batch[16];
+    for(size_t source = 0; source < FlipperRngSourceCount; source++) {
+        size_t count;
+        do {
+            count = 0;
+            while(count < COUNT_OF(batch) && flipper_rng_ring_pop(&state->sample_rings[source], &batch[count])) {
+                if(batch[count].source & FLIPPER_RNG_SOURCE_RAW) {
+                    credited += flipper_rng_pool_add_raw(state, &state->sample_rings[source], &batch[count]);
+                    continue;
+                }
+                count++;
+            }
+            credited += flipper_rng_pool_add_batch(state, batch, count);
+        } while(count == COUNT_OF(batch));
+    }
     
     furi_mutex_release(state->mutex);
+    return credited;
+}
+
+uint32_t flipper_rng_samples_dropped(FlipperRngState* state) {
+    uint32_t dropped = 0;
+    for(size_t i = 0; i < FlipperRngSourceCount; i++) {
+        dropped += flipper_rng_ring_dropped(&state->sample_rings[i]);
+    }
+    return dropped;
+}
+
+// Software mixing over pool32[start..end) words - caller must hold state->mutex
+// Neighbour diffusion reads across region edges, so mixing every region in one
+// call is identical to mixing the whole pool
+static void flipper_rng_sw_mix_words(uint32_t* pool32, size_t start, size_t end, uint32_t* hw_mix, uint32_t* hw_mix2) {
+    const size_t pool32_size = RNG_POOL_SIZE / sizeof(uint32_t);
+    
+    // Fast mixing using hardware random and rotation
+    for(size_t i = start; i < end; i++) {
+        // Mix with hardware random
+        pool32[i] ^= *hw_mix;
+        
+        // Use hardware-optimized rotation
+        *hw_mix = flipper_rng_hw_rotate_left(*hw_mix, 1);
+        *hw_mix ^= *hw_mix2;
+        *hw_mix2 = flipper_rng_hw_rotate_right(*hw_mix2, 1);
+        
+        // Additional diffusion with adjacent values
+        if(i > 0) {
+            pool32[i] ^= pool32[i - 1] >> 3;
+        }
+        if(i < pool32_size - 1) {
+            pool32[i] ^= pool32[i + 1] << 5;
+        }
+    }
+}
+
+// Final byte-level diffusion pass over pool[start..end)
+static void flipper_rng_sw_mix_bytes(uint8_t* pool, size_t start, size_t end) {
+    if(start < 1) start = 1;
+    if(end > RNG_POOL_SIZE - 1) end = RNG_POOL_SIZE - 1;
+    for(size_t i = start; i < end; i++) {
+        pool[i] ^= (pool[i - 1] >> 1) ^ (pool[i + 1] << 1);
+    }
+}
+
+// Find the next run of consecutive set bits at or after *region
+// Returns false when there are none left
+static bool flipper_rng_next_region_run(uint16_t regions, size_t* region, size_t* run_length) {
+    while(*region < RNG_POOL_REGIONS && !(regions & (1u << *region))) (*region)++;
+    if(*region >= RNG_POOL_REGIONS) return false;
+    
+    *run_length = 0;
+    while(*region + *run_length < RNG_POOL_REGIONS && (regions & (1u << (*region + *run_length)))) {
+        (*run_length)++;
+    }
+    return true;
 }
 
+// AES-mix each run of regions, retrying a failed run once
+static bool flipper_rng_hw_mix_regions(FlipperRngState* state, uint16_t regions, uint32_t* aes_key) {
+    size_t region = 0, run = 0;
+    while(flipper_rng_next_region_run(regions, &region, &run)) {
+        uint8_t* start = &state->entropy_pool[region * RNG_POOL_REGION_SIZE];
+        size_t length = run * RNG_POOL_REGION_SIZE;
+        if(!flipper_rng_hw_aes_mix_pool(start, length, aes_key)) {
+            FURI_LOG_E(TAG, "Hardware AES mixing failed - this should not happen!");
+            if(!flipper_rng_hw_aes_mix_pool(start, length, aes_key)) {
+                return false;
+            }
+        }
+        region += run;
+    }
+    return true;
+}
+
+static void flipper_rng_drbg_seed_from_pool(FlipperRngState* state);
+
 // Mix entropy pool - HARDWARE ACCELERATED with AES
+// Only the 256-byte regions written since the last mix are mixed, plus a
+// full-pool sweep every full_mix_interval mixes
 void flipper_rng_mix_entropy_pool(FlipperRngState* state) {
     if(!state || !state->mutex) {
         FURI_LOG_E(TAG, "mix_pool: Invalid state or mutex");
@@ -165,6 +611,30 @@ void flipper_rng_mix_entropy_pool(FlipperRngState* state) {
         return;
     }
     
+    // Fortuna pools are hash chains with nothing to mix; reseed the DRBG on schedule instead
+    if(state->mixing_mode == MixingModeFortuna) {
+        if(flipper_rng_fortuna_reseed_due(&state->fortuna, furi_get_tick())) {
+            state->mix_counter++;
+            flipper_rng_drbg_seed_from_pool(state);
+        }
+        furi_mutex_release(state->mutex);
+        return;
+    }
+    
+    // Decide what to mix: dirty regions, or everything when a sweep is due
+    uint16_t regions = state->dirty_regions;
+    state->mixes_since_full++;
+    if(state->full_mix_interval <= 1 || state->mixes_since_full >= state->full_mix_interval) {
+        regions = RNG_POOL_ALL_REGIONS;
+        state->mixes_since_full = 0;
+    }
+    
+    if(regions == 0) {
+        // Nothing new since the last mix
+        furi_mutex_release(state->mutex);
+        return;
+    }
+    
     // Try hardware AES mixing first (ultra-fast)
     uint32_t aes_key[8];
     uint32_t* pool32 = (uint32_t*)state->entropy_pool;
@@ -200,6 +670,7 @@ void flipper_rng_mix_entropy_pool(FlipperRngState* state) {
     
     // Increment counter for next mix (will rotate through different positions)
     state->mix_counter++;
+    state->dirty_regions = 0;
     
     // Choose mixing method based on configuration
     bool use_hardware_aes = false;
@@ -218,56 +689,40 @@ void flipper_rng_mix_entropy_pool(FlipperRngState* state) {
     
     bool hardware_success = false;
     if(use_hardware_aes) {
-        hardware_success = flipper_rng_hw_aes_mix_pool(state->entropy_pool, RNG_POOL_SIZE, aes_key);
+        hardware_success = flipper_rng_hw_mix_regions(state, regions, aes_key);
         if(hardware_success) {
-            FURI_LOG_D(TAG, "Pool mixed with hardware AES");
+            FURI_LOG_D(TAG, "Pool mixed with hardware AES (regions 0x%04X)", regions);
         } else if(state->mixing_mode == MixingModeHardware) {
-            FURI_LOG_E(TAG, "Hardware AES mixing failed - this should not happen!");
-            // Try once more for hardware-only mode
-            hardware_success = flipper_rng_hw_aes_mix_pool(state->entropy_pool, RNG_POOL_SIZE, aes_key);
-            if(!hardware_success) {
-                FURI_LOG_E(TAG, "Hardware AES mixing failed twice - hardware error detected!");
-                // We should stop the generator and show error to user
-                state->is_running = false;
-                furi_mutex_release(state->mutex);
-                return;  // Exit without mixing - this will cause the generator to stop
-            }
+            FURI_LOG_E(TAG, "Hardware AES mixing failed twice - hardware error detected!");
+            // We should stop the generator and show error to user
+            state->is_running = false;
+            furi_mutex_release(state->mutex);
+            return;  // Exit without mixing - this will cause the generator to stop
         }
     }
     
     if(!hardware_success && state->mixing_mode == MixingModeSoftware) {
         // Use software mixing (either by choice or as fallback)
-        size_t pool32_size = RNG_POOL_SIZE / sizeof(uint32_t);
-        
         // Get fresh hardware random for mixing
         uint32_t hw_mix = furi_hal_random_get();
         uint32_t hw_mix2 = furi_hal_random_get();
         
-        // Fast mixing using hardware random and rotation
-        for(size_t i = 0; i < pool32_size; i++) {
-            // Mix with hardware random
-            pool32[i] ^= hw_mix;
-            
-            // Use hardware-optimized rotation
-            hw_mix = flipper_rng_hw_rotate_left(hw_mix, 1);
-            hw_mix ^= hw_mix2;
-            hw_mix2 = flipper_rng_hw_rotate_right(hw_mix2, 1);
-            
-            // Additional diffusion with adjacent values
-            if(i > 0) {
-                pool32[i] ^= pool32[i - 1] >> 3;
-            }
-            if(i < pool32_size - 1) {
-                pool32[i] ^= pool32[i + 1] << 5;
-            }
+        const size_t region_words = RNG_POOL_REGION_SIZE / sizeof(uint32_t);
+        size_t region = 0, run = 0;
+        while(flipper_rng_next_region_run(regions, &region, &run)) {
+            flipper_rng_sw_mix_words(pool32, region * region_words, (region + run) * region_words, &hw_mix, &hw_mix2);
+            region += run;
         }
         
         // Final pass with byte-level diffusion for thorough mixing
-        for(size_t i = 1; i < RNG_POOL_SIZE - 1; i++) {
-            state->entropy_pool[i] ^= (state->entropy_pool[i - 1] >> 1) ^ (state->entropy_pool[i + 1] << 1);
+        region = 0;
+        while(flipper_rng_next_region_run(regions, &region, &run)) {
+            flipper_rng_sw_mix_bytes(
+                state->entropy_pool, region * RNG_POOL_REGION_SIZE, (region + run) * RNG_POOL_REGION_SIZE);
+            region += run;
         }
         
-        FURI_LOG_D(TAG, "Pool mixed with optimized software mixing");
+        FURI_LOG_D(TAG, "Pool mixed with optimized software mixing (regions 0x%04X)", regions);
     }
     
     furi_mutex_release(state->mutex);
@@ -280,7 +735,124 @@ uint8_t flipper_rng_extract_random_byte(FlipperRngState* state) {
     return result;
 }
 
-// Batch extract multiple random bytes from the pool - OPTIMIZED
+// Tap offsets for good distribution across the pool (primes near multiples of 512)
+static const uint16_t pool_read_taps[8] = {0, 511, 1023, 1531, 2047, 2557, 3067, 3583};
+
+static inline uint32_t pool_read_tap_xor(const uint8_t* pool, size_t pos) {
+    return pool[pos] ^ pool[(pos + pool_read_taps[1]) & RNG_POOL_MASK] ^
+           pool[(pos + pool_read_taps[2]) & RNG_POOL_MASK] ^ pool[(pos + pool_read_taps[3]) & RNG_POOL_MASK] ^
+           pool[(pos + pool_read_taps[4]) & RNG_POOL_MASK] ^ pool[(pos + pool_read_taps[5]) & RNG_POOL_MASK] ^
+           pool[(pos + pool_read_taps[6]) & RNG_POOL_MASK] ^ pool[(pos + pool_read_taps[7]) & RNG_POOL_MASK];
+}
+
+// Jitter bits left over from the current TRNG word
+typedef struct {
+    const uint32_t* words;
+    uint32_t bits;
+    uint32_t left;
+} PoolReadJitter;
+
+// Advance by 1 + the next 3 jitter bits; one TRNG word covers ten advances
+static inline size_t pool_read_advance(size_t pos, PoolReadJitter* jitter) {
+    if(jitter->left == 0) {
+        jitter->bits = *jitter->words++;
+        jitter->left = RNG_POOL_READ_JITTERS_PER_WORD;
+    }
+    pos = (pos + 1 + (jitter->bits & 0x7)) & RNG_POOL_MASK;
+    jitter->bits >>= 3;
+    jitter->left--;
+    return pos;
+}
+
+void flipper_rng_pool_read_kernel(
+    const uint8_t* pool,
+    size_t* pos,
+    uint8_t* out,
+    size_t count,
+    const uint32_t* jitter_words) {
+    PoolReadJitter jitter = {.words = jitter_words, .bits = 0, .left = 0};
+    size_t p = *pos & RNG_POOL_MASK;
+    
+    // Four output bytes per step, stored from one 32-bit accumulator
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        uint32_t word = pool_read_tap_xor(pool, p);
+        p = pool_read_advance(p, &jitter);
+        word |= pool_read_tap_xor(pool, p) << 8;
+        p = pool_read_advance(p, &jitter);
+        word |= pool_read_tap_xor(pool, p) << 16;
+        p = pool_read_advance(p, &jitter);
+        word |= pool_read_tap_xor(pool, p) << 24;
+        p = pool_read_advance(p, &jitter);
+        
+        out[i] = (uint8_t)word;
+        out[i + 1] = (uint8_t)(word >> 8);
+        out[i + 2] = (uint8_t)(word >> 16);
+        out[i + 3] = (uint8_t)(word >> 24);
+    }
+    for(; i < count; i++) {
+        out[i] = (uint8_t)pool_read_tap_xor(pool, p);
+        p = pool_read_advance(p, &jitter);
+    }
+    
+    *pos = p;
+}
+
+// Read count bytes from the pool at entropy_pool_pos with TRNG position jitter
+// Jitter makes it harder for an attacker to predict which pool bytes are extracted next
+// Caller must hold state->mutex
+static void flipper_rng_pool_read(FlipperRngState* state, uint8_t* buffer, size_t count) {
+    uint32_t jitter_words[16];
+    const size_t chunk_bytes = COUNT_OF(jitter_words) * RNG_POOL_READ_JITTERS_PER_WORD;
+    
+    for(size_t offset = 0; offset < count; offset += chunk_bytes) {
+        size_t chunk = MIN(count - offset, chunk_bytes);
+        size_t words = (chunk + RNG_POOL_READ_JITTERS_PER_WORD - 1) / RNG_POOL_READ_JITTERS_PER_WORD;
+        for(size_t w = 0; w < words; w++) {
+            jitter_words[w] = furi_hal_random_get();
+        }
+        flipper_rng_pool_read_kernel(
+            state->entropy_pool, &state->entropy_pool_pos, &buffer[offset], chunk, jitter_words);
+    }
+    secure_wipe(jitter_words, sizeof(jitter_words));
+}
+
+// (Re)seed the CTR_DRBG with seedlen bytes read from the pool, or from the
+// scheduled Fortuna pools in MixingModeFortuna once a reseed is due
+// Caller must hold state->mutex
+static void flipper_rng_drbg_seed_from_pool(FlipperRngState* state) {
+    uint8_t seed[FLIPPER_RNG_DRBG_SEED_SIZE];
+    uint32_t now = furi_get_tick();
+    if(state->mixing_mode != MixingModeFortuna) {
+        flipper_rng_pool_read(state, seed, sizeof(seed));
+    } else if(flipper_rng_fortuna_reseed_due(&state->fortuna, now)) {
+        flipper_rng_fortuna_reseed(&state->fortuna, seed, sizeof(seed), now);
+        flipper_rng_update_ready(state);
+    } else {
+        // Pool 0 is short of its minimum, or this is the DRBG's request limit between
+        // scheduled reseeds. Fortuna mode never writes the XOR pool, so this seed is
+        // TRNG words only; draining pool 0 early would seed from next to nothing.
+        furi_hal_random_fill_buf(seed, sizeof(seed));
+    }
+    
+    if(state->drbg.instantiated) {
+        flipper_rng_drbg_reseed(&state->drbg, seed, NULL, 0);
+    } else {
+        static const char personalization[] = "EntropyLab CTR_DRBG";
+        flipper_rng_drbg_instantiate(
+            &state->drbg, seed, (const uint8_t*)personalization, sizeof(personalization) - 1);
+    }
+    secure_wipe(seed, sizeof(seed));
+    
+    // Output buffered under the old key must not outlive a reseed
+    secure_wipe(state->drbg_reserve, sizeof(state->drbg_reserve));
+    state->drbg_reserve_len = 0;
+    state->drbg_seed_mix_counter = state->mix_counter;
+}
+
+// Batch extract random bytes through the CTR_DRBG - OPTIMIZED
+// Output comes in whole AES blocks; requests smaller than a block are served
+// from a small buffer so byte-at-a-time callers don't pay a full generate each
 void flipper_rng_extract_random_bytes(FlipperRngState* state, uint8_t* buffer, size_t count) {
     if(!buffer || count == 0) return;
     
@@ -296,34 +868,38 @@ void flipper_rng_extract_random_bytes(FlipperRngState* state, uint8_t* buffer, s
         return;
     }
     
-    // Prime offsets for good distribution across the pool
-    const size_t prime_offsets[8] = {
-        511, 1023, 1531, 2047, 2557, 3067, 3583, 4093
-    };
+    // Reseed whenever the pool has been mixed since the last seed
+    if(flipper_rng_drbg_needs_reseed(&state->drbg) || state->drbg_seed_mix_counter != state->mix_counter) {
+        flipper_rng_drbg_seed_from_pool(state);
+    }
     
-    // Extract all bytes in a single critical section
-    for(size_t byte_idx = 0; byte_idx < count; byte_idx++) {
-        uint8_t result = 0;
-        size_t base_pos = state->entropy_pool_pos;
-        
-        // Mix bytes from 8 different pool positions
-        // Unrolled for better performance
-        result ^= state->entropy_pool[base_pos];
-        result ^= state->entropy_pool[(base_pos + prime_offsets[0]) % RNG_POOL_SIZE];
-        result ^= state->entropy_pool[(base_pos + prime_offsets[1]) % RNG_POOL_SIZE];
-        result ^= state->entropy_pool[(base_pos + prime_offsets[2]) % RNG_POOL_SIZE];
-        result ^= state->entropy_pool[(base_pos + prime_offsets[3]) % RNG_POOL_SIZE];
-        result ^= state->entropy_pool[(base_pos + prime_offsets[4]) % RNG_POOL_SIZE];
-        result ^= state->entropy_pool[(base_pos + prime_offsets[5]) % RNG_POOL_SIZE];
-        result ^= state->entropy_pool[(base_pos + prime_offsets[6]) % RNG_POOL_SIZE];
+    size_t offset = 0;
+    if(count < FLIPPER_RNG_DRBG_BLOCK_SIZE) {
+        if(state->drbg_reserve_len < count) {
+            if(flipper_rng_drbg_needs_reseed(&state->drbg)) {
+                flipper_rng_drbg_seed_from_pool(state);
+            }
+            flipper_rng_drbg_generate(&state->drbg, state->drbg_reserve, RNG_DRBG_RESERVE_SIZE, NULL, 0);
+            state->drbg_reserve_len = RNG_DRBG_RESERVE_SIZE;
+        }
         
-        buffer[byte_idx] = result;
+        // Hand out from the end and wipe what was used
+        uint8_t* reserve = &state->drbg_reserve[state->drbg_reserve_len - count];
+        memcpy(buffer, reserve, count);
+        secure_wipe(reserve, count);
+        state->drbg_reserve_len -= count;
+        offset = count;
+    }
+    
+    while(offset < count) {
+        size_t chunk = count - offset;
+        if(chunk > FLIPPER_RNG_DRBG_MAX_REQUEST) chunk = FLIPPER_RNG_DRBG_MAX_REQUEST;
         
-        // Advance position for next byte with random jitter
-        // Mix in hardware RNG to prevent position prediction
-        // This makes it harder for an attacker to predict which pool bytes will be extracted next
-        uint32_t jitter = furi_hal_random_get() & 0x7;  // 0-7 random advance
-        state->entropy_pool_pos = (state->entropy_pool_pos + 1 + jitter) % RNG_POOL_SIZE;
+        if(flipper_rng_drbg_needs_reseed(&state->drbg)) {
+            flipper_rng_drbg_seed_from_pool(state);
+        }
+        flipper_rng_drbg_generate(&state->drbg, &buffer[offset], chunk, NULL, 0);
+        offset += chunk;
     }
     
     state->bytes_generated += count;
@@ -357,10 +933,16 @@ bool von_neumann_extract(VonNeumannExtractor* extractor, uint8_t input_bit, uint
 }
 
 
-// Update quality metric (no longer used, kept for compatibility)
+// Publish per-source min-entropy estimates from the counters the batch path keeps
 void flipper_rng_update_quality_metric(FlipperRngState* state) {
-    // Quality calculation removed - now handled by test function
-    UNUSED(state);
+    if(!state || !state->mutex) return;
+    if(furi_mutex_acquire(state->mutex, 100) != FuriStatusOk) return;
+    
+    for(size_t i = 0; i < FlipperRngSourceCount; i++) {
+        flipper_rng_estimator_update(&state->estimators[i]);
+    }
+    
+    furi_mutex_release(state->mutex);
 }
 
 // Main entropy collection function
@@ -375,444 +957,7 @@ void flipper_rng_collect_hardware_rng(FlipperRngState* state) {
 // ADC, battery, and temperature sources removed - too predictable
 // Now focusing only on high-quality sources: HW RNG, SubGHz RSSI, Infrared
 
-// Static mutex for SubGHz access protection
-static FuriMutex* subghz_mutex = NULL;
-static uint32_t subghz_error_count = 0;  // Track consecutive errors for recovery
-static uint32_t subghz_last_success = 0;  // Last successful collection time
-
-// Get SubGHz RSSI noise - Enhanced hardware implementation with improved entropy
-uint32_t flipper_rng_get_subghz_rssi_noise_ex(FlipperRngState* state) {
-    uint32_t entropy = 0;
-    
-    // Early exit if we're stopping
-    if(state && !state->is_running) {
-        return 0;
-    }
-    
-    // Create mutex on first use
-    if(!subghz_mutex) {
-        subghz_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
-    }
-    
-    // Try to acquire SubGHz access (with timeout to prevent deadlock)
-    if(furi_mutex_acquire(subghz_mutex, 100) != FuriStatusOk) {
-        FURI_LOG_W(TAG, "SubGHz RSSI: Could not acquire mutex, skipping");
-        subghz_error_count++;
-        return 0;
-    }
-    
-    FURI_LOG_D(TAG, "SubGHz RSSI: Starting enhanced hardware RSSI collection");
-    
-    // If we've had too many consecutive errors, force a reset
-    if(subghz_error_count > 10) {
-        FURI_LOG_W(TAG, "SubGHz RSSI: Too many errors (%lu), forcing reset", subghz_error_count);
-        furi_hal_subghz_reset();
-        subghz_error_count = 0;
-    }
-    
-    // Optimized frequency set based on regional validation
-    // Focus on frequencies that work globally without blocks
-    uint32_t frequencies[] = {
-        // 300-348 MHz band (most regions allow these)
-        300000000,  // 300 MHz - Band edge
-        310000000,  // 310 MHz 
-        315000000,  // 315 MHz - ISM band (US/Asia)
-        318000000,  // 318 MHz - UK SRD
-        330000000,  // 330 MHz
-        345000000,  // 345 MHz - Near band edge
-        
-        // 387-464 MHz band (check region)
-        390000000,  // 390 MHz
-        410000000,  // 410 MHz
-        418000000,  // 418 MHz
-        
-        // 433 MHz region - most universally accepted
-        433050000,  // 433.05 MHz - LPD433 start
-        433175000,  // 433.175 MHz - LPD433
-        433300000,  // 433.3 MHz - LPD433
-        433420000,  // 433.42 MHz - Amateur
-        433620000,  // 433.62 MHz
-        433920000,  // 433.92 MHz - ISM Global
-        434420000,  // 434.42 MHz - SRD
-        434790000,  // 434.79 MHz - LPD433 end
-        
-        // 440-450 MHz (region dependent)
-        440000000,  // 440 MHz
-        446000000,  // 446 MHz - PMR446
-        450000000,  // 450 MHz
-        
-        // 460-464 MHz (often blocked)
-        460000000,  // 460 MHz
-        462562500,  // 462.5625 MHz - FRS/GMRS
-        464000000,  // 464 MHz - Band edge
-        
-        // 902-928 MHz ISM (Americas/AU only)
-        902000000,  // 902 MHz
-        905000000,  // 905 MHz
-        910000000,  // 910 MHz
-        915000000,  // 915 MHz - ISM center
-        920000000,  // 920 MHz
-        925000000,  // 925 MHz
-        
-        // Note: Removed 784, 903, 928 MHz as they often fail
-        // Note: 868 MHz removed - EU only
-    };
-    
-    // Try to prepare SubGHz for RX
-    bool subghz_available = false;
-    bool init_success = false;
-    
-    // Check if SubGHz is already in use by trying to acquire it
-    // We'll use the frequency test as our availability check instead
-    
-    // CRITICAL FIX: Wrap all SubGHz operations in error handling
-    // to prevent crashes from bad hardware states
-    FURI_CRITICAL_ENTER();  // Disable interrupts during state transition
-    
-    // Ensure we're in a clean state
-    furi_hal_subghz_sleep();
-    
-    // Check if we should abort early
-    if(state && !state->is_running) {
-        FURI_CRITICAL_EXIT();
-        furi_mutex_release(subghz_mutex);
-        return 0;
-    }
-    
-    furi_hal_subghz_idle();
-    
-    FURI_CRITICAL_EXIT();  // Re-enable interrupts
-    
-    // Load optimized preset for entropy collection
-    // Using OOK 650kHz for wide bandwidth and good sensitivity
-    furi_hal_subghz_load_custom_preset(subghz_device_cc1101_preset_ook_650khz_async_regs);
-    
-    // Configure for optimal RSSI readings (based on spectrum analyzer)
-    // Disable AGC freeze, set optimal gain settings
-    uint8_t agc_settings[][2] = {
-        {CC1101_AGCCTRL0, 0x91}, // Medium hysteresis, 16 samples AGC
-        {CC1101_AGCCTRL2, 0xC0}, // MAX LNA+LNA2, MAIN_TARGET 24 dB
-        {0, 0}
-    };
-    
-    // Load registers (void function, no return value to check)
-    furi_hal_subghz_load_registers(agc_settings[0]);
-    
-    // Put in idle state after configuration
-    furi_hal_subghz_idle();
-    
-    // Check if we can successfully set a frequency (indicates SubGHz is responsive)
-    uint32_t test_freq = furi_hal_subghz_set_frequency(433920000);
-    if(test_freq > 0) {
-        subghz_available = true;
-        init_success = true;
-        FURI_LOG_D(TAG, "SubGHz RSSI: Hardware ready at %lu Hz", test_freq);
-    } else {
-        FURI_LOG_W(TAG, "SubGHz RSSI: Hardware not responding, using timing entropy");
-        subghz_error_count++;
-        
-        // Clean up if initialization failed - with comprehensive reset
-        furi_hal_subghz_idle();
-        furi_hal_subghz_sleep();
-        
-        // If errors are piling up, do a full reset
-        if(subghz_error_count > 5) {
-            FURI_LOG_W(TAG, "SubGHz RSSI: Multiple init failures, forcing reset");
-            furi_hal_subghz_reset();
-            subghz_error_count = 0;
-        }
-        
-        furi_mutex_release(subghz_mutex);
-        return 0;
-    }
-    
-    // Calculate number of frequencies
-    size_t num_freqs = sizeof(frequencies) / sizeof(frequencies[0]);
-    
-    // Pre-filter frequencies to only valid ones for this region
-    // This avoids "frequency blocked" errors
-    uint32_t valid_frequencies[30];  // Increased to handle more frequencies
-    size_t valid_count = 0;
-    
-    for(size_t i = 0; i < num_freqs && valid_count < 30; i++) {  // Increased limit to 30
-        if(furi_hal_subghz_is_frequency_valid(frequencies[i])) {
-            valid_frequencies[valid_count++] = frequencies[i];
-            // Only log debug info for first few frequencies to reduce spam
-            if(valid_count <= 3) {
-                FURI_LOG_D(TAG, "SubGHz: Freq %lu MHz is valid", frequencies[i]/1000000);
-            }
-        }
-    }
-    
-    if(valid_count == 0) {
-        FURI_LOG_W(TAG, "SubGHz: No frequencies valid in this region, using timing entropy");
-        furi_hal_subghz_sleep();
-        furi_mutex_release(subghz_mutex);
-        return DWT->CYCCNT ^ (DWT->CYCCNT << 16);
-    }
-    
-    FURI_LOG_I(TAG, "SubGHz: %zu frequencies valid in this region", valid_count);
-    
-    // We'll collect up to 32 bits of entropy (4 bytes)
-    // Sample a subset of valid frequencies each time for speed
-    uint8_t entropy_bytes[4] = {0};
-    uint8_t byte_idx = 0;
-    
-    // Use hardware RNG to randomize frequency selection for unpredictability
-    uint32_t hw_random = furi_hal_random_get();
-    uint8_t freq_offset = hw_random & 0xFF;
-    
-    // Dynamic sampling based on available frequencies
-    // More frequencies = better entropy but slower collection
-    uint8_t samples_to_take = (uint8_t)valid_count;
-    if(samples_to_take > 12) samples_to_take = 12;  // Increased max for better entropy
-    if(samples_to_take < 6) samples_to_take = 6;     // Increased min for quality
-    
-    FURI_LOG_D(TAG, "SubGHz RSSI: Sampling %u frequencies from %zu valid", 
-              samples_to_take, valid_count);
-    
-    // Non-consecutive frequency hopping with prime-based distribution
-    // This ensures we sample different frequencies each time
-    uint8_t prime_hop = 7;  // Prime number for good distribution
-    
-    // Add timeout protection for the entire sampling loop
-    uint32_t loop_start_time = furi_get_tick();
-    const uint32_t MAX_LOOP_TIME_MS = 500;  // Max 500ms for all sampling
-    
-    for(int i = 0; i < samples_to_take && byte_idx < 4; i++) {
-        // Check if we should stop early
-        if(state && !state->is_running) {
-            FURI_LOG_D(TAG, "SubGHz RSSI: Early exit due to stop request");
-            break;
-        }
-        
-        // Timeout protection - prevent infinite loops
-        if(furi_get_tick() - loop_start_time > MAX_LOOP_TIME_MS) {
-            FURI_LOG_W(TAG, "SubGHz RSSI: Sampling timeout after %lums, collected %u bytes", 
-                      furi_get_tick() - loop_start_time, byte_idx);
-            subghz_error_count++;
-            break;
-        }
-        
-        // Use prime-based hopping for better frequency distribution
-        // This avoids repeating the same frequency too often
-        uint8_t freq_idx;
-        if(valid_count > 1) {
-            // Prime-based hopping with random offset ensures good coverage
-            freq_idx = (freq_offset + (i * prime_hop)) % valid_count;
-        } else {
-            freq_idx = 0;  // Only one frequency available
-        }
-        
-        uint32_t frequency = valid_frequencies[freq_idx];
-        
-        uint8_t noise_byte = 0;
-        uint32_t timing_start = DWT->CYCCNT;
-        
-        // Try to use real RSSI if SubGHz is available
-        if(subghz_available) {
-            // Double-check frequency validity before setting
-            // This avoids "frequency blocked" errors
-            if(!furi_hal_subghz_is_frequency_valid(frequency)) {
-                FURI_LOG_D(TAG, "SubGHz: Freq %lu MHz blocked at runtime, using timing", 
-                          frequency/1000000);
-                uint32_t timing_end = DWT->CYCCNT;
-                noise_byte = (timing_end - timing_start) & 0xFF;
-                entropy_bytes[byte_idx++] = noise_byte;
-                continue;
-            }
-            
-            // Configure and start RX with error checking
-            uint32_t actual_freq = furi_hal_subghz_set_frequency(frequency);
-            
-            if(actual_freq > 0) {
-                // CRITICAL FIX: Wrap RX in critical section to prevent interrupt issues
-                FURI_CRITICAL_ENTER();
-                furi_hal_subghz_rx();
-                FURI_CRITICAL_EXIT();
-                
-                // Spectrum analyzer uses 3ms for RSSI stabilization
-                // This ensures AGC has settled and we get accurate readings
-                furi_delay_ms(3);
-                
-                // Take multiple RSSI samples for better entropy
-                // Sample more times for increased entropy quality
-                float rssi_samples[5];
-                uint8_t lqi_samples[5];
-                bool sample_success = true;
-                
-                for(int j = 0; j < 5; j++) {
-                    // Verify we're still in RX mode before sampling
-                    // This prevents crashes if radio state changed unexpectedly
-                    rssi_samples[j] = furi_hal_subghz_get_rssi();
-                    lqi_samples[j] = furi_hal_subghz_get_lqi();
-                    
-                    // Basic sanity check on RSSI values
-                    if(rssi_samples[j] < -130.0f || rssi_samples[j] > 0.0f) {
-                        FURI_LOG_W(TAG, "SubGHz RSSI: Invalid RSSI value %.1f, using fallback", 
-                                  (double)rssi_samples[j]);
-                        sample_success = false;
-                        break;
-                    }
-                    
-                    furi_delay_us(200);  // 200us between samples for variation
-                }
-                
-                if(sample_success) {
-                    // Calculate RSSI variance (good entropy source)
-                    float rssi_avg = 0;
-                    for(int j = 0; j < 5; j++) {
-                        rssi_avg += rssi_samples[j];
-                    }
-                    rssi_avg /= 5.0f;
-                    
-                    float rssi_variance = 0;
-                    for(int j = 0; j < 5; j++) {
-                        float diff = rssi_samples[j] - rssi_avg;
-                        rssi_variance += diff * diff;
-                    }
-                    rssi_variance /= 5.0f;  // Normalize variance
-                    
-                    // Convert floats to bits for entropy extraction
-                    union { float f; uint32_t i; } rssi_conv = { .f = rssi_samples[0] };
-                    union { float f; uint32_t i; } var_conv = { .f = rssi_variance };
-                    
-                    // Get additional timing entropy
-                    uint32_t timing_end = DWT->CYCCNT;
-                    uint32_t timing_noise = (timing_end - timing_start);
-                    
-                    // Enhanced entropy extraction using multiple sources
-                    // Combine RSSI mantissa bits, variance, LQI changes, and timing
-                    uint8_t rssi_bits = (rssi_conv.i & 0xFF) ^ ((rssi_conv.i >> 8) & 0xFF);
-                    uint8_t var_bits = (var_conv.i & 0xFF) ^ ((var_conv.i >> 16) & 0xFF);
-                    
-                    // XOR all 5 LQI samples for maximum entropy
-                    uint8_t lqi_bits = lqi_samples[0];
-                    for(int j = 1; j < 5; j++) {
-                        lqi_bits ^= lqi_samples[j];
-                    }
-                    
-                    uint8_t timing_bits = (timing_noise & 0xFF) ^ ((timing_noise >> 8) & 0xFF) ^ ((timing_noise >> 16) & 0xFF);
-                    
-                    // Mix all entropy sources with rotation
-                    noise_byte = rssi_bits;
-                    noise_byte = (noise_byte << 1) | (noise_byte >> 7);
-                    noise_byte ^= var_bits;
-                    noise_byte = (noise_byte << 1) | (noise_byte >> 7);
-                    noise_byte ^= lqi_bits;
-                    noise_byte = (noise_byte << 1) | (noise_byte >> 7);
-                    noise_byte ^= timing_bits;
-                    
-                    // Only log detailed info for some samples to reduce spam
-                    if(byte_idx <= 2 || (byte_idx == 3 && i == samples_to_take - 1)) {
-                        FURI_LOG_D(TAG, "SubGHz RSSI: Freq=%lu MHz, RSSI=%.1f dBm (var=%.2f), LQI=%u, byte=0x%02X", 
-                                  frequency/1000000, (double)rssi_avg, (double)rssi_variance, lqi_samples[0], noise_byte);
-                    }
-                } else {
-                    // Sample failed, use timing fallback
-                    uint32_t timing_end = DWT->CYCCNT;
-                    noise_byte = (timing_end - timing_start) & 0xFF;
-                    subghz_error_count++;
-                }
-                
-                // Return to idle between frequencies - with critical section
-                FURI_CRITICAL_ENTER();
-                furi_hal_subghz_idle();
-                FURI_CRITICAL_EXIT();
-            } else {
-                // Failed to set frequency, use timing
-                uint32_t timing_end = DWT->CYCCNT;
-                noise_byte = (timing_end - timing_start) & 0xFF;
-                FURI_LOG_D(TAG, "SubGHz RSSI: Failed to set freq %lu MHz, using timing", 
-                          frequency/1000000);
-            }
-        } else {
-            // SubGHz not available, use timing entropy
-            uint32_t timing_end = DWT->CYCCNT;
-            noise_byte = (timing_end - timing_start) & 0xFF;
-            FURI_LOG_D(TAG, "SubGHz RSSI: Hardware unavailable, using timing=0x%02X", noise_byte);
-        }
-        
-        // Store the entropy byte
-        entropy_bytes[byte_idx++] = noise_byte;
-        
-        // Very small delay to avoid hogging the radio
-        furi_delay_us(5);
-    }
-    
-    // No need for static offset since we randomize with HW RNG each time
-    
-    // Enhanced entropy packing with whitening
-    // Pack entropy bytes into 32-bit return value with mixing
-    uint32_t mixer = 0x9E3779B9;  // Golden ratio for mixing
-    for(int i = 0; i < byte_idx; i++) {
-        entropy = (entropy << 8) | entropy_bytes[i];
-        entropy ^= (entropy >> 16);  // Avalanche effect
-        entropy *= mixer;
-        mixer += 0x6C078965;  // Different constant for each byte
-    }
-    
-    // Final mix with timing
-    entropy ^= DWT->CYCCNT;
-    
-    // Clean shutdown of SubGHz if we used it
-    if(subghz_available && init_success) {
-        // Critical section for state transitions to prevent race conditions
-        FURI_CRITICAL_ENTER();
-        furi_hal_subghz_idle();
-        furi_hal_subghz_sleep();
-        FURI_CRITICAL_EXIT();
-        
-        // Don't reset here - only sleep to save power
-        // Reset should only happen on app exit or after errors
-    } else if(subghz_available) {
-        // Init was not fully successful, force a reset to clean state
-        FURI_LOG_W(TAG, "SubGHz RSSI: Init incomplete, forcing reset");
-        furi_hal_subghz_reset();
-        subghz_error_count++;
-    }
-    
-    // Track successful completion
-    if(entropy != 0 && byte_idx > 0) {
-        subghz_error_count = 0;  // Reset error counter on success
-        subghz_last_success = furi_get_tick();
-    } else {
-        subghz_error_count++;
-        
-        // If we haven't had a success in a long time, force reset
-        uint32_t time_since_success = furi_get_tick() - subghz_last_success;
-        if(time_since_success > 60000) {  // 60 seconds without success
-            FURI_LOG_W(TAG, "SubGHz RSSI: No success in 60s, forcing reset");
-            furi_hal_subghz_reset();
-            subghz_error_count = 0;
-            subghz_last_success = furi_get_tick();
-        }
-    }
-    
-    FURI_LOG_I(TAG, "SubGHz RSSI: Collected %u bytes entropy=0x%08lX (HW:%s, Valid:%zu, Sampled:%u, Errors:%lu)", 
-              byte_idx, entropy, subghz_available ? "Yes" : "No", valid_count, samples_to_take, subghz_error_count);
-    
-    // Release mutex before returning - CRITICAL to prevent deadlock
-    furi_mutex_release(subghz_mutex);
-    
-    return entropy;
-}
-
-// Backward compatibility wrapper
-uint32_t flipper_rng_get_subghz_rssi_noise(void) {
-    return flipper_rng_get_subghz_rssi_noise_ex(NULL);
-}
-
-void flipper_rng_collect_subghz_rssi_entropy(FlipperRngState* state) {
-    if(state->entropy_sources & EntropySourceSubGhzRSSI) {
-        uint32_t rssi_noise = flipper_rng_get_subghz_rssi_noise_ex(state);
-        // Enhanced implementation provides ~16-20 bits of quality entropy
-        // due to RSSI variance, multiple samples, and wider frequency coverage
-        if(rssi_noise != 0) {  // Only add if we got entropy
-            flipper_rng_add_entropy(state, rssi_noise, 16); // Enhanced quality RF noise
-        }
-    }
-}
+// SubGHz RSSI collection lives in entropylab_subghz.c as a non-blocking sweep
 
 
 // Global variables for IR signal capture
@@ -1,12 +1,14 @@
 #pragma once
 
 #include "entropylab.h"
+#include "entropylab_conditioner.h"
 #include <furi_hal_random.h>
 #include <furi_hal_adc.h>
 #include <furi_hal_power.h>
 #include <furi_hal_cortex.h>
 #include <furi_hal_infrared.h>
 #include <infrared_worker.h>
+#include <stdatomic.h>
 
 // Entropy mixing constants (based on LFSR)
 #define ENTROPY_MIX_TAP1 0x80200003
@@ -36,20 +38,85 @@ uint32_t flipper_rng_get_hardware_random(void);
 uint32_t flipper_rng_get_adc_noise(FuriHalAdcHandle* handle);
 uint32_t flipper_rng_get_battery_noise(void);
 uint32_t flipper_rng_get_temperature_noise(void);
-uint32_t flipper_rng_get_subghz_rssi_noise(void);
-uint32_t flipper_rng_get_subghz_rssi_noise_ex(FlipperRngState* state);
 uint32_t flipper_rng_get_infrared_noise(void);
 
 // Entropy processing
 void flipper_rng_add_entropy(FlipperRngState* state, uint32_t entropy, uint8_t bits);
+// Fold (sample, bits, source) tuples into the pool under one lock, crediting bits_from_* per source
+// Returns the bits credited, 0 if the mutex could not be taken
+uint32_t flipper_rng_add_entropy_batch(FlipperRngState* state, const FlipperRngSample* samples, size_t count);
+
+// Lock-free sample queueing: producers push, the worker drains all rings under one lock
+void flipper_rng_init_sample_rings(FlipperRngState* state);
+bool flipper_rng_push_sample(FlipperRngState* state, FlipperRngSourceId source, uint32_t sample, uint8_t bits);
+// Health test and estimate count raw readings of source, each credited with bits,
+// and add the ones that pass to the conditioner; returns how many passed
+// Takes state->mutex, so only for producers on the worker thread (the SubGHz sweep);
+// producers on other threads queue their readings with flipper_rng_push_raw() instead
+size_t flipper_rng_condition_raw(
+    FlipperRngState* state,
+    FlipperRngSourceId source,
+    FlipperRngConditioner* conditioner,
+    const uint32_t* readings,
+    size_t count,
+    uint8_t bits);
+// Lock-free alternative to flipper_rng_condition_raw(): queue seed (absorbed uncredited) and up
+// to FLIPPER_RNG_RAW_MAX_READINGS readings as one group carrying bits of credit; the drain tests
+// and conditions them, crediting bits scaled to the readings that pass. False if the ring is full
+#define FLIPPER_RNG_RAW_MAX_READINGS 32
+bool flipper_rng_push_raw(
+    FlipperRngState* state,
+    FlipperRngSourceId source,
+    uint32_t seed,
+    const uint32_t* readings,
+    size_t count,
+    uint8_t bits);
+// Finish a conditioned batch and queue its digest as 32-bit words carrying its credit, returns the bits queued
+uint32_t flipper_rng_push_conditioned(FlipperRngState* state, FlipperRngSourceId source, FlipperRngConditioner* conditioner);
+uint32_t flipper_rng_drain_samples(FlipperRngState* state);  // Returns entropy bits credited
+uint32_t flipper_rng_samples_dropped(FlipperRngState* state);
+
+// Switch mixing mode under the mutex and re-evaluate entropy_ready for it
+void flipper_rng_set_mixing_mode(FlipperRngState* state, MixingMode mode);
+
+// Entropy credit accounting, all under state->mutex
+// Every consumer spends credit here: all of bits or nothing, checked and taken
+// under one lock. Nothing is debited in Fortuna mode before the first reseed
+// from the Fortuna pools, so no output is generated from an unseeded DRBG. A caller with a timeout waits up to timeout_ms (or until
+// *cancel is set) and meanwhile holds a claim on incoming credit, so streaming
+// output cannot take it first. Streaming callers pass 0 and never dig into
+// the RNG_CREDIT_READY_BITS reserve kept for one-shot requests like passphrases.
+bool flipper_rng_debit_entropy_wait(
+    FlipperRngState* state,
+    uint32_t bits,
+    uint32_t timeout_ms,
+    const atomic_bool* cancel);
+
+// Continuous health tests: samples from a quarantined source are discarded with their credit
+void flipper_rng_init_health(FlipperRngState* state);
+
+// Min-entropy estimators, fed every raw sample, health test failures included
+void flipper_rng_init_estimators(FlipperRngState* state);
 void flipper_rng_mix_entropy_pool(FlipperRngState* state);
 uint8_t flipper_rng_extract_random_byte(FlipperRngState* state);
 void flipper_rng_extract_random_bytes(FlipperRngState* state, uint8_t* buffer, size_t count);
 
+// Pool read kernel used to seed the CTR_DRBG: each output byte XORs 8 taps
+// around *pos, then *pos advances by 1 + a 3-bit jitter. Jitters are taken
+// ten per word from jitter_words, low bits first (ceil(count / 10) words)
+#define RNG_POOL_READ_JITTERS_PER_WORD 10
+void flipper_rng_pool_read_kernel(
+    const uint8_t* pool,
+    size_t* pos,
+    uint8_t* out,
+    size_t count,
+    const uint32_t* jitter_words);
+
 // Von Neumann debiasing
 void von_neumann_init(VonNeumannExtractor* extractor);
 bool von_neumann_extract(VonNeumannExtractor* extractor, uint8_t input_bit, uint8_t* output_bit);
 
 // Entropy quality estimation
 float flipper_rng_estimate_entropy_quality(uint8_t* data, size_t length);
+// Recompute each source's published min-entropy estimate
 void flipper_rng_update_quality_metric(FlipperRngState* state);
@@ -0,0 +1,186 @@
+#include "entropylab_estimator.h"
+#include <math.h>
+#include <string.h>
+
+#define ESTIMATOR_Z 2.576f  // 99% upper confidence bound, as in SP 800-90B
+#define ESTIMATOR_MARKOV_BITS 128
+
+// log2 that maps impossible events far below any real probability
+static float estimator_log2(float p) {
+    return p > 0.0f ? log2f(p) : -1.0e6f;
+}
+
+static float estimator_ratio(uint32_t numerator, uint32_t denominator) {
+    return denominator ? (float)numerator / (float)denominator : 0.0f;
+}
+
+static void estimator_halve(FlipperRngEstimator* estimator) {
+    uint32_t total = 0;
+    for(size_t i = 0; i < 256; i++) {
+        estimator->counts[i] >>= 1;
+        total += estimator->counts[i];
+    }
+    estimator->total = total;
+
+    for(size_t i = 0; i < 2; i++) estimator->bit_counts[i] >>= 1;
+    for(size_t i = 0; i < 4; i++) estimator->transitions[i] >>= 1;
+    estimator->collisions >>= 1;
+    estimator->collision_sum >>= 1;
+    estimator->collision_squares >>= 1;
+    estimator->samples >>= 1;
+    estimator->sample_bytes >>= 1;
+    estimator->credited_bits >>= 1;
+}
+
+#define B2(n) n, n + 1, n + 1, n + 2
+#define B4(n) B2(n), B2(n + 1), B2(n + 1), B2(n + 2)
+#define B6(n) B4(n), B4(n + 1), B4(n + 1), B4(n + 2)
+static const uint8_t estimator_popcount[256] = {B6(0), B6(1), B6(1), B6(2)};
+
+// Binary collision walk, a nibble at a time. A block ends at the first repeated
+// bit: the second if it matches the first, the third otherwise. Indexed by
+// [walk_state][nibble, LSB first]; packs the next state (bits 0-1), blocks of
+// length 2 (bits 2-3) and blocks of length 3 (bits 4-5) the nibble completes
+static const uint8_t estimator_walk[4][16] = {
+    {0x08, 0x11, 0x11, 0x08, 0x07, 0x11, 0x11, 0x07, 0x07, 0x12, 0x12, 0x07, 0x08, 0x12, 0x12, 0x08},
+    {0x09, 0x14, 0x14, 0x14, 0x14, 0x13, 0x09, 0x13, 0x0A, 0x13, 0x14, 0x13, 0x14, 0x14, 0x0A, 0x14},
+    {0x14, 0x09, 0x14, 0x14, 0x13, 0x14, 0x13, 0x09, 0x13, 0x0A, 0x13, 0x14, 0x14, 0x14, 0x14, 0x0A},
+    {0x15, 0x15, 0x20, 0x20, 0x20, 0x20, 0x15, 0x15, 0x16, 0x16, 0x20, 0x20, 0x20, 0x20, 0x16, 0x16},
+};
+
+static void estimator_walk_nibble(FlipperRngEstimator* estimator, uint8_t nibble) {
+    uint8_t step = estimator_walk[estimator->walk_state][nibble];
+    uint32_t pairs = (step >> 2) & 3;
+    uint32_t triples = (step >> 4) & 3;
+    estimator->walk_state = step & 3;
+    estimator->collisions += pairs + triples;
+    estimator->collision_sum += 2 * pairs + 3 * triples;
+    estimator->collision_squares += 4 * pairs + 9 * triples;
+}
+
+static void estimator_add_byte(FlipperRngEstimator* estimator, uint8_t value) {
+    if(estimator->total >= FLIPPER_RNG_ESTIMATOR_WINDOW) estimator_halve(estimator);
+    bool first = estimator->bit_counts[0] + estimator->bit_counts[1] == 0;
+
+    estimator->counts[value]++;
+    estimator->total++;
+
+    // Bits are taken LSB first; bit i of "from" precedes bit i of "to"
+    uint32_t mask = first ? 0xFE : 0xFF;  // No transition into the very first bit
+    uint32_t from = (((uint32_t)value << 1) | estimator->last_bit) & mask;
+    uint32_t to = value & mask;
+    uint32_t from_ones = estimator_popcount[from];
+    uint32_t to_ones = estimator_popcount[to];
+    uint32_t both = estimator_popcount[from & to];
+    uint32_t pairs = first ? 7 : 8;
+    estimator->transitions[3] += both;
+    estimator->transitions[2] += from_ones - both;
+    estimator->transitions[1] += to_ones - both;
+    estimator->transitions[0] += pairs - from_ones - to_ones + both;
+
+    uint32_t ones = estimator_popcount[value];
+    estimator->bit_counts[1] += ones;
+    estimator->bit_counts[0] += 8 - ones;
+    estimator->last_bit = value >> 7;
+
+    estimator_walk_nibble(estimator, value & 0x0F);
+    estimator_walk_nibble(estimator, value >> 4);
+}
+
+void flipper_rng_estimator_init(FlipperRngEstimator* estimator) {
+    memset(estimator, 0, sizeof(FlipperRngEstimator));
+}
+
+void flipper_rng_estimator_add(FlipperRngEstimator* estimator, uint32_t sample, uint8_t bits) {
+    if(bits == 0) return;
+    uint8_t bytes = bits >= 32 ? 4 : (bits + 7) / 8;
+    for(uint8_t i = 0; i < bytes; i++) {
+        estimator_add_byte(estimator, (uint8_t)(sample >> (i * 8)));
+    }
+    estimator->samples++;
+    estimator->sample_bytes += bytes;
+    estimator->credited_bits += bits;
+}
+
+// 6.3.1: upper bound on the most common byte's probability
+static float estimator_mcv(const FlipperRngEstimator* estimator) {
+    uint16_t max = 0;
+    for(size_t i = 0; i < 256; i++) {
+        if(estimator->counts[i] > max) max = estimator->counts[i];
+    }
+    float p = (float)max / (float)estimator->total;
+    float upper = p + ESTIMATOR_Z * sqrtf(p * (1.0f - p) / (float)(estimator->total - 1));
+    if(upper > 1.0f) upper = 1.0f;
+    return -estimator_log2(upper);
+}
+
+// 6.3.2 for bits: a block is 2 long with probability p^2 + q^2 and 3 long
+// otherwise, so its mean is 2 + 2pq and p has a closed form
+static float estimator_collision(const FlipperRngEstimator* estimator) {
+    uint32_t v = estimator->collisions;
+    if(v < 2) return 8.0f;
+
+    float mean = (float)estimator->collision_sum / (float)v;
+    float variance = ((float)estimator->collision_squares - (float)v * mean * mean) / (float)(v - 1);
+    if(variance < 0.0f) variance = 0.0f;
+    float lower = mean - ESTIMATOR_Z * sqrtf(variance) / sqrtf((float)v);
+
+    float pq = (lower - 2.0f) / 2.0f;
+    float p = 1.0f;
+    if(pq >= 0.25f) {
+        p = 0.5f;
+    } else if(pq > 0.0f) {
+        p = 0.5f + sqrtf(0.25f - pq);
+    }
+    return -estimator_log2(p) * 8.0f;
+}
+
+// 6.3.3: probability of the most likely 128-bit sequence under a first-order Markov model
+static float estimator_markov(const FlipperRngEstimator* estimator) {
+    uint32_t bits = estimator->bit_counts[0] + estimator->bit_counts[1];
+    const uint32_t* t = estimator->transitions;
+    float l0 = estimator_log2(estimator_ratio(estimator->bit_counts[0], bits));
+    float l1 = estimator_log2(estimator_ratio(estimator->bit_counts[1], bits));
+    float l00 = estimator_log2(estimator_ratio(t[0], t[0] + t[1]));
+    float l01 = estimator_log2(estimator_ratio(t[1], t[0] + t[1]));
+    float l10 = estimator_log2(estimator_ratio(t[2], t[2] + t[3]));
+    float l11 = estimator_log2(estimator_ratio(t[3], t[2] + t[3]));
+
+    const float n = ESTIMATOR_MARKOV_BITS;
+    float candidates[] = {
+        l0 + (n - 1) * l00,                      // 000...0
+        l0 + (n / 2) * l01 + (n / 2 - 1) * l10,  // 0101...
+        l0 + l01 + (n - 2) * l11,                // 011...1
+        l1 + l10 + (n - 2) * l00,                // 100...0
+        l1 + (n / 2) * l10 + (n / 2 - 1) * l01,  // 1010...
+        l1 + (n - 1) * l11,                      // 111...1
+    };
+
+    float best = candidates[0];
+    for(size_t i = 1; i < sizeof(candidates) / sizeof(candidates[0]); i++) {
+        if(candidates[i] > best) best = candidates[i];
+    }
+    float per_bit = -best / n;
+    return (per_bit > 1.0f ? 1.0f : per_bit) * 8.0f;
+}
+
+void flipper_rng_estimator_update(FlipperRngEstimator* estimator) {
+    if(estimator->total < FLIPPER_RNG_ESTIMATOR_MIN_BYTES || estimator->samples == 0) {
+        estimator->valid = false;
+        return;
+    }
+
+    estimator->mcv = estimator_mcv(estimator);
+    estimator->collision = estimator_collision(estimator);
+    estimator->markov = estimator_markov(estimator);
+
+    float min_entropy = estimator->mcv;
+    if(estimator->collision < min_entropy) min_entropy = estimator->collision;
+    if(estimator->markov < min_entropy) min_entropy = estimator->markov;
+    estimator->min_entropy = min_entropy;
+
+    float bytes_per_sample = (float)estimator->sample_bytes / (float)estimator->samples;
+    estimator->per_sample = min_entropy * bytes_per_sample;
+    estimator->credited_per_sample = (float)estimator->credited_bits / (float)estimator->samples;
+    estimator->valid = true;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+/**
+ * Online SP 800-90B min-entropy estimators (section 6.3)
+ * Each raw source feeds the bytes it is credited for into three estimators:
+ *   - most common value, over byte symbols
+ *   - collision, over the bit stream (binary form of 6.3.2)
+ *   - Markov, over the bit stream
+ * All state is fixed-size counters. When a window fills, every counter is
+ * halved, so estimates track the last FLIPPER_RNG_ESTIMATOR_WINDOW / 2 to
+ * FLIPPER_RNG_ESTIMATOR_WINDOW bytes without keeping any sample history.
+ *
+ * flipper_rng_estimator_add() is a handful of adds per byte and runs on every
+ * sample; flipper_rng_estimator_update() does the floating point and is meant
+ * to be called periodically.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FLIPPER_RNG_ESTIMATOR_WINDOW 4096     // Bytes before the counters are halved
+#define FLIPPER_RNG_ESTIMATOR_MIN_BYTES 256   // Bytes needed before an estimate is published
+
+typedef struct {
+    // Most common value
+    uint16_t counts[256];
+    uint32_t total;  // Bytes in the window
+
+    // Markov: bit counts and transitions indexed by (previous << 1) | next
+    uint32_t bit_counts[2];
+    uint32_t transitions[4];
+    uint8_t last_bit;
+
+    // Collision: walk state, then blocks seen with their lengths (2 or 3)
+    uint8_t walk_state;  // 0 empty, 1/2 holding a 0/1, 3 holding two different bits
+    uint32_t collisions;
+    uint32_t collision_sum;
+    uint32_t collision_squares;
+
+    // Per-sample accounting, halved with the rest
+    uint32_t samples;
+    uint32_t sample_bytes;
+    uint32_t credited_bits;
+
+    // Published by flipper_rng_estimator_update(), bits per byte except where noted
+    bool valid;
+    float mcv;
+    float collision;
+    float markov;
+    float min_entropy;          // Smallest of the three
+    float per_sample;           // min_entropy scaled to the source's average sample
+    float credited_per_sample;  // What the source claims per sample
+} FlipperRngEstimator;
+
+void flipper_rng_estimator_init(FlipperRngEstimator* estimator);
+
+// Count the bytes of a sample that a credit of bits folds into the pool
+void flipper_rng_estimator_add(FlipperRngEstimator* estimator, uint32_t sample, uint8_t bits);
+
+// Recompute the published estimates from the counters
+void flipper_rng_estimator_update(FlipperRngEstimator* estimator);
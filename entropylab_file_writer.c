@@ -0,0 +1,217 @@
+/**
+ * Double-buffered SD card writer
+ * Buffers are handed to the writer thread strictly in turn, so the thread
+ * only needs a count of queued buffers and the index of the next one.
+ * busy[i] is set by the producer on hand-off and cleared by the thread once
+ * the buffer is on the card; the producer never touches a busy buffer.
+ */
+
+#include "entropylab_file_writer.h"
+#include <furi.h>
+#include <storage/storage.h>
+#include <stdatomic.h>
+#include <string.h>
+
+#define TAG "EntropyLab_File"
+
+struct FlipperRngFileWriter {
+    Storage* storage;
+    File* file;
+    FuriThread* thread;
+    FuriSemaphore* queued;  // Buffers handed off and not yet written
+    FuriMutex* stats_mutex;
+
+    uint8_t* buffers[2];
+    size_t lengths[2];
+    atomic_bool busy[2];
+    size_t buffer_size;
+
+    // Producer side
+    uint8_t active;
+    size_t fill;
+    size_t target;  // Bytes that complete the active buffer
+
+    // Writer thread side
+    uint8_t next;
+    atomic_bool stopping;
+
+    uint32_t open_tick;
+    FlipperRngFileWriterStats stats;
+};
+
+static int32_t flipper_rng_file_writer_thread(void* context) {
+    FlipperRngFileWriter* writer = context;
+
+    while(true) {
+        if(furi_semaphore_acquire(writer->queued, 100) != FuriStatusOk) {
+            // Only exit once every queued buffer has been written
+            if(atomic_load_explicit(&writer->stopping, memory_order_acquire)) break;
+            continue;
+        }
+
+        uint8_t index = writer->next;
+        uint32_t start = furi_get_tick();
+        size_t written = storage_file_write(writer->file, writer->buffers[index], writer->lengths[index]);
+        uint32_t took = furi_get_tick() - start;
+
+        bool short_write = written < writer->lengths[index];
+        furi_mutex_acquire(writer->stats_mutex, FuriWaitForever);
+        writer->stats.bytes_written += written;
+        writer->stats.write_ms += took;
+        if(short_write) {
+            writer->stats.bytes_failed += writer->lengths[index] - written;
+            writer->stats.write_errors++;
+        }
+        furi_mutex_release(writer->stats_mutex);
+
+        if(short_write) {
+            FURI_LOG_E(TAG, "Short write: %zu of %zu bytes", written, writer->lengths[index]);
+        }
+
+        atomic_store_explicit(&writer->busy[index], false, memory_order_release);
+        writer->next = index ^ 1;
+    }
+
+    return 0;
+}
+
+// Give the active buffer to the writer thread and switch to the other one
+static void flipper_rng_file_writer_hand_off(FlipperRngFileWriter* writer) {
+    writer->lengths[writer->active] = writer->fill;
+    atomic_store_explicit(&writer->busy[writer->active], true, memory_order_release);
+    furi_semaphore_release(writer->queued);
+
+    writer->active ^= 1;
+    writer->fill = 0;
+    writer->target = writer->buffer_size;
+}
+
+FlipperRngFileWriter* flipper_rng_file_writer_open(const char* path, size_t buffer_size) {
+    FlipperRngFileWriter* writer = malloc(sizeof(FlipperRngFileWriter));
+    if(!writer) return NULL;
+    memset(writer, 0, sizeof(FlipperRngFileWriter));
+
+    writer->buffer_size = buffer_size;
+    writer->buffers[0] = malloc(buffer_size);
+    writer->buffers[1] = malloc(buffer_size);
+    if(!writer->buffers[0] || !writer->buffers[1]) {
+        FURI_LOG_E(TAG, "Failed to allocate 2 x %zu byte buffers", buffer_size);
+        free(writer->buffers[0]);
+        free(writer->buffers[1]);
+        free(writer);
+        return NULL;
+    }
+
+    writer->storage = furi_record_open(RECORD_STORAGE);
+    writer->file = storage_file_alloc(writer->storage);
+    if(!storage_file_open(writer->file, path, FSAM_WRITE, FSOM_OPEN_APPEND)) {
+        FURI_LOG_E(TAG, "Failed to open %s", path);
+        storage_file_free(writer->file);
+        furi_record_close(RECORD_STORAGE);
+        free(writer->buffers[0]);
+        free(writer->buffers[1]);
+        free(writer);
+        return NULL;
+    }
+
+    // First buffer only fills up to the next buffer-size boundary of the file
+    size_t misalignment = (size_t)(storage_file_size(writer->file) % buffer_size);
+    writer->target = buffer_size - misalignment;
+
+    atomic_init(&writer->busy[0], false);
+    atomic_init(&writer->busy[1], false);
+    atomic_init(&writer->stopping, false);
+    writer->queued = furi_semaphore_alloc(2, 0);
+    writer->stats_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    writer->open_tick = furi_get_tick();
+
+    writer->thread = furi_thread_alloc_ex("FlipperRngFile", 2048, flipper_rng_file_writer_thread, writer);
+    furi_thread_start(writer->thread);
+
+    FURI_LOG_I(TAG, "Writing to %s with 2 x %zu byte buffers", path, buffer_size);
+    return writer;
+}
+
+static size_t
+    flipper_rng_file_writer_fill(FlipperRngFileWriter* writer, const uint8_t* data, size_t length, bool wait) {
+    size_t accepted = 0;
+
+    while(accepted < length) {
+        if(atomic_load_explicit(&writer->busy[writer->active], memory_order_acquire)) {
+            if(wait) {
+                furi_delay_ms(1);
+                continue;
+            }
+            // Both buffers queued: the card is behind, drop rather than wait
+            furi_mutex_acquire(writer->stats_mutex, FuriWaitForever);
+            writer->stats.bytes_dropped += length - accepted;
+            furi_mutex_release(writer->stats_mutex);
+            break;
+        }
+
+        size_t chunk = MIN(length - accepted, writer->target - writer->fill);
+        memcpy(&writer->buffers[writer->active][writer->fill], &data[accepted], chunk);
+        writer->fill += chunk;
+        accepted += chunk;
+
+        if(writer->fill == writer->target) {
+            flipper_rng_file_writer_hand_off(writer);
+        }
+    }
+
+    return accepted;
+}
+
+size_t flipper_rng_file_writer_write(FlipperRngFileWriter* writer, const uint8_t* data, size_t length) {
+    return flipper_rng_file_writer_fill(writer, data, length, false);
+}
+
+void flipper_rng_file_writer_write_wait(FlipperRngFileWriter* writer, const uint8_t* data, size_t length) {
+    flipper_rng_file_writer_fill(writer, data, length, true);
+}
+
+void flipper_rng_file_writer_get_stats(FlipperRngFileWriter* writer, FlipperRngFileWriterStats* stats) {
+    furi_mutex_acquire(writer->stats_mutex, FuriWaitForever);
+    *stats = writer->stats;
+    furi_mutex_release(writer->stats_mutex);
+
+    stats->elapsed_ms = furi_get_tick() - writer->open_tick;
+    stats->bytes_per_sec =
+        stats->elapsed_ms ? (uint32_t)(stats->bytes_written * 1000 / stats->elapsed_ms) : 0;
+}
+
+void flipper_rng_file_writer_close(FlipperRngFileWriter* writer) {
+    if(!writer) return;
+
+    // Wait for the active buffer to come back before flushing what is left in it
+    if(writer->fill > 0) {
+        while(atomic_load_explicit(&writer->busy[writer->active], memory_order_acquire)) {
+            furi_delay_ms(1);
+        }
+        flipper_rng_file_writer_hand_off(writer);
+    }
+
+    atomic_store_explicit(&writer->stopping, true, memory_order_release);
+    furi_thread_join(writer->thread);
+    furi_thread_free(writer->thread);
+
+    storage_file_close(writer->file);
+    storage_file_free(writer->file);
+    furi_record_close(RECORD_STORAGE);
+
+    FlipperRngFileWriterStats stats;
+    flipper_rng_file_writer_get_stats(writer, &stats);
+    FURI_LOG_I(
+        TAG,
+        "Closed: %lu bytes written, %lu dropped, %lu failed, %lu B/s",
+        (uint32_t)stats.bytes_written,
+        (uint32_t)stats.bytes_dropped,
+        (uint32_t)stats.bytes_failed,
+        stats.bytes_per_sec);
+
+    furi_semaphore_free(writer->queued);
+    furi_mutex_free(writer->stats_mutex);
+    free(writer->buffers[0]);
+    free(writer->buffers[1]);
+    free(writer);
+}
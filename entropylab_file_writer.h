@@ -0,0 +1,46 @@
+#pragma once
+
+/**
+ * Double-buffered SD card writer for OutputModeFile
+ * The file stays open for the whole capture. The worker copies output into
+ * the active buffer; full buffers are handed to a writer thread, so SD
+ * latency only blocks collection when both buffers are queued. Writes are
+ * sized to land on buffer-size boundaries of the file, which keeps them
+ * cluster-aligned on the card. Short writes, such as on a full card, are
+ * counted in the stats as failed bytes.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define FLIPPER_RNG_FILE_WRITER_BUFFER_SIZE 8192  // Per buffer, two are allocated
+
+typedef struct FlipperRngFileWriter FlipperRngFileWriter;
+
+typedef struct {
+    uint64_t bytes_written;  // Landed on the card
+    uint64_t bytes_dropped;  // Discarded because both buffers were still queued
+    uint64_t bytes_failed;   // Handed to storage_file_write but not written
+    uint32_t write_errors;   // storage_file_write calls that came up short
+    uint32_t write_ms;       // Time spent inside storage_file_write
+    uint32_t elapsed_ms;     // Since the writer was opened
+    uint32_t bytes_per_sec;  // Sustained rate: bytes_written over elapsed_ms
+} FlipperRngFileWriterStats;
+
+// Open path for appending and start the writer thread, NULL on failure
+FlipperRngFileWriter* flipper_rng_file_writer_open(const char* path, size_t buffer_size);
+
+// Queue data for writing without blocking on the card
+// Returns the number of bytes accepted; the rest is counted as dropped
+size_t flipper_rng_file_writer_write(FlipperRngFileWriter* writer, const uint8_t* data, size_t length);
+
+// Queue all of data, waiting for the card whenever both buffers are queued
+// For output that must not be lost, such as credited worker output or
+// bulk-generated credentials
+void flipper_rng_file_writer_write_wait(FlipperRngFileWriter* writer, const uint8_t* data, size_t length);
+
+void flipper_rng_file_writer_get_stats(FlipperRngFileWriter* writer, FlipperRngFileWriterStats* stats);
+
+// Flush the partial buffer, wait for the thread and close the file
+void flipper_rng_file_writer_close(FlipperRngFileWriter* writer);
@@ -0,0 +1,99 @@
+#include "entropylab_fortuna.h"
+#include "entropylab_sha256.h"
+#include "entropylab_secure.h"
+#include <string.h>
+
+// An event is one compression block: source, length, data, zero padding.
+// The explicit length makes every block unambiguous without MD padding.
+static void fortuna_emit(FlipperRngFortuna* fortuna, uint8_t source) {
+    uint8_t block[FLIPPER_RNG_SHA256_BLOCK_SIZE] = {0};
+    uint8_t length = fortuna->staged_len[source];
+    block[0] = source;
+    block[1] = length;
+    memcpy(&block[2], fortuna->staged[source], length);
+
+    uint8_t pool = fortuna->next_pool[source];
+    flipper_rng_sha256_compress(fortuna->pools[pool], block);
+    if(pool == 0) fortuna->pool0_bytes += length;
+    fortuna->next_pool[source] = (uint8_t)((pool + 1) % FLIPPER_RNG_FORTUNA_POOLS);
+    fortuna->staged_len[source] = 0;
+    fortuna->events++;
+
+    secure_wipe(block, sizeof(block));
+    secure_wipe(fortuna->staged[source], sizeof(fortuna->staged[source]));
+}
+
+void flipper_rng_fortuna_init(FlipperRngFortuna* fortuna) {
+    memset(fortuna, 0, sizeof(FlipperRngFortuna));
+    for(size_t i = 0; i < FLIPPER_RNG_FORTUNA_POOLS; i++) {
+        flipper_rng_sha256_initial_state(fortuna->pools[i]);
+    }
+}
+
+void flipper_rng_fortuna_add(FlipperRngFortuna* fortuna, uint8_t source, uint32_t sample, uint8_t bits) {
+    if(bits == 0) return;
+    if(source >= FLIPPER_RNG_FORTUNA_SOURCES) source = FLIPPER_RNG_FORTUNA_SOURCES - 1;
+    uint8_t bytes = bits >= 32 ? 4 : (bits + 7) / 8;
+
+    for(uint8_t i = 0; i < bytes; i++) {
+        fortuna->staged[source][fortuna->staged_len[source]++] = (uint8_t)(sample >> (i * 8));
+        if(fortuna->staged_len[source] == FLIPPER_RNG_FORTUNA_EVENT_BYTES) fortuna_emit(fortuna, source);
+    }
+}
+
+bool flipper_rng_fortuna_reseed_due(const FlipperRngFortuna* fortuna, uint32_t now_ms) {
+    if(fortuna->pool0_bytes < FLIPPER_RNG_FORTUNA_MIN_POOL_BYTES) return false;
+    return fortuna->reseed_count == 0 || now_ms - fortuna->last_reseed_ms >= FLIPPER_RNG_FORTUNA_RESEED_MS;
+}
+
+static void fortuna_put_be32(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)(value >> 24);
+    out[1] = (uint8_t)(value >> 16);
+    out[2] = (uint8_t)(value >> 8);
+    out[3] = (uint8_t)value;
+}
+
+uint8_t flipper_rng_fortuna_reseed(FlipperRngFortuna* fortuna, uint8_t* seed, size_t seed_len, uint32_t now_ms) {
+    fortuna->reseed_count++;
+    fortuna->last_reseed_ms = now_ms;
+
+    // digest = SHA-256(reseed count || scheduled pools), then each pool starts over
+    FlipperRngSha256 ctx;
+    uint8_t word[4];
+    flipper_rng_sha256_init(&ctx);
+    fortuna_put_be32(word, fortuna->reseed_count);
+    flipper_rng_sha256_update(&ctx, word, sizeof(word));
+
+    uint8_t used = 0;
+    while(used < FLIPPER_RNG_FORTUNA_POOLS) {
+        if(used > 0 && (fortuna->reseed_count & ((1u << used) - 1)) != 0) break;
+        for(size_t i = 0; i < 8; i++) {
+            fortuna_put_be32(word, fortuna->pools[used][i]);
+            flipper_rng_sha256_update(&ctx, word, sizeof(word));
+        }
+        flipper_rng_sha256_initial_state(fortuna->pools[used]);
+        used++;
+    }
+    fortuna->pool0_bytes = 0;
+
+    uint8_t digest[FLIPPER_RNG_SHA256_DIGEST_SIZE];
+    flipper_rng_sha256_final(&ctx, digest);
+
+    // Expand to seed_len with SHA-256(counter || digest)
+    uint8_t input[1 + FLIPPER_RNG_SHA256_DIGEST_SIZE];
+    uint8_t block[FLIPPER_RNG_SHA256_DIGEST_SIZE];
+    memcpy(&input[1], digest, sizeof(digest));
+    for(size_t offset = 0, counter = 0; offset < seed_len; counter++) {
+        input[0] = (uint8_t)counter;
+        flipper_rng_sha256(input, sizeof(input), block);
+        size_t chunk = seed_len - offset < sizeof(block) ? seed_len - offset : sizeof(block);
+        memcpy(&seed[offset], block, chunk);
+        offset += chunk;
+    }
+
+    secure_wipe(word, sizeof(word));
+    secure_wipe(digest, sizeof(digest));
+    secure_wipe(input, sizeof(input));
+    secure_wipe(block, sizeof(block));
+    return used;
+}
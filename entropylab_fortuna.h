@@ -0,0 +1,50 @@
+#pragma once
+
+/**
+ * Fortuna-style multi-pool accumulator (Ferguson & Schneier, ch. 9)
+ * Each pool is a 32-byte SHA-256 chaining value. A source stages its bytes
+ * into events of up to FLIPPER_RNG_FORTUNA_EVENT_BYTES and sends successive
+ * events to successive pools, so every source spreads evenly over all of them
+ * and no single source decides what a pool holds.
+ *
+ * Reseed r (counting from 1) draws on pool i when 2^i divides r: pool 0 every
+ * time, pool 1 every other time, and so on. Pools that are rarely drained
+ * build up enough entropy to recover from a compromised state even when an
+ * attacker controls most of the input.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define FLIPPER_RNG_FORTUNA_POOLS 32
+#define FLIPPER_RNG_FORTUNA_SOURCES 4          // FlipperRngSourceCount plus one for untagged input
+#define FLIPPER_RNG_FORTUNA_EVENT_BYTES 62     // Data per event; with the 2-byte header it fills one block
+#define FLIPPER_RNG_FORTUNA_MIN_POOL_BYTES 64  // Pool 0 input needed before a scheduled reseed
+#define FLIPPER_RNG_FORTUNA_RESEED_MS 100      // Minimum time between scheduled reseeds
+
+typedef struct {
+    uint32_t pools[FLIPPER_RNG_FORTUNA_POOLS][8];  // SHA-256 chaining values
+    uint32_t pool0_bytes;                          // Event bytes in pool 0 since the last reseed
+
+    // Per-source staging and round-robin position
+    uint8_t staged[FLIPPER_RNG_FORTUNA_SOURCES][FLIPPER_RNG_FORTUNA_EVENT_BYTES];
+    uint8_t staged_len[FLIPPER_RNG_FORTUNA_SOURCES];
+    uint8_t next_pool[FLIPPER_RNG_FORTUNA_SOURCES];
+
+    uint32_t reseed_count;
+    uint32_t last_reseed_ms;
+    uint32_t events;
+} FlipperRngFortuna;
+
+void flipper_rng_fortuna_init(FlipperRngFortuna* fortuna);
+
+// Stage the bytes of a sample that a credit of bits covers (ceil(bits / 8), at most 4)
+// Sources at or past FLIPPER_RNG_FORTUNA_SOURCES share the last slot
+void flipper_rng_fortuna_add(FlipperRngFortuna* fortuna, uint8_t source, uint32_t sample, uint8_t bits);
+
+// Pool 0 has enough input and the last reseed is at least FLIPPER_RNG_FORTUNA_RESEED_MS old
+bool flipper_rng_fortuna_reseed_due(const FlipperRngFortuna* fortuna, uint32_t now_ms);
+
+// Drain the scheduled pools into seed_len bytes of seed material, returns the pools used
+uint8_t flipper_rng_fortuna_reseed(FlipperRngFortuna* fortuna, uint8_t* seed, size_t seed_len, uint32_t now_ms);
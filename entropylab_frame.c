@@ -0,0 +1,121 @@
+#include "entropylab_frame.h"
+#include <string.h>
+
+// Half-byte table for the reflected polynomial 0xEDB88320: 64 bytes of flash instead of 1 KB
+static const uint32_t crc32_nibble[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+uint32_t flipper_rng_crc32(uint32_t crc, const uint8_t* data, size_t length) {
+    crc = ~crc;
+    for(size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ crc32_nibble[crc & 0x0F];
+        crc = (crc >> 4) ^ crc32_nibble[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+static void frame_put_le16(uint8_t* out, uint16_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static uint16_t frame_get_le16(const uint8_t* in) {
+    return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+size_t flipper_rng_frame_encode(uint8_t* frame, uint16_t seq, uint8_t flags, uint16_t payload_len) {
+    frame[0] = FLIPPER_RNG_FRAME_MAGIC0;
+    frame[1] = FLIPPER_RNG_FRAME_MAGIC1;
+    frame_put_le16(&frame[2], seq);
+    frame_put_le16(&frame[4], payload_len);
+    frame[6] = flags;
+
+    size_t crc_offset = FLIPPER_RNG_FRAME_HEADER_SIZE + payload_len;
+    uint32_t crc = flipper_rng_crc32(0, frame, crc_offset);
+    frame_put_le16(&frame[crc_offset], (uint16_t)crc);
+    frame_put_le16(&frame[crc_offset + 2], (uint16_t)(crc >> 16));
+    return crc_offset + FLIPPER_RNG_FRAME_CRC_SIZE;
+}
+
+void flipper_rng_frame_decoder_init(FlipperRngFrameDecoder* decoder) {
+    memset(decoder, 0, sizeof(FlipperRngFrameDecoder));
+}
+
+static void frame_decoder_consume(FlipperRngFrameDecoder* decoder, size_t count) {
+    memmove(decoder->buffer, &decoder->buffer[count], decoder->fill - count);
+    decoder->fill -= count;
+}
+
+// Pull every complete frame out of the buffer; returns when more bytes are needed
+static void frame_decoder_parse(FlipperRngFrameDecoder* decoder, FlipperRngFrameCallback callback, void* context) {
+    while(decoder->fill > 0) {
+        // Hunt for the magic, keeping a trailing 'E' that may start the next one
+        if(decoder->buffer[0] != FLIPPER_RNG_FRAME_MAGIC0 ||
+           (decoder->fill > 1 && decoder->buffer[1] != FLIPPER_RNG_FRAME_MAGIC1)) {
+            const uint8_t* next = memchr(&decoder->buffer[1], FLIPPER_RNG_FRAME_MAGIC0, decoder->fill - 1);
+            size_t skip = next ? (size_t)(next - decoder->buffer) : decoder->fill;
+            decoder->discarded_bytes += skip;
+            frame_decoder_consume(decoder, skip);
+            continue;
+        }
+        if(decoder->fill < FLIPPER_RNG_FRAME_HEADER_SIZE) return;
+
+        uint16_t length = frame_get_le16(&decoder->buffer[4]);
+        if(length > FLIPPER_RNG_FRAME_PAYLOAD) {
+            decoder->discarded_bytes++;
+            frame_decoder_consume(decoder, 1);
+            continue;
+        }
+        size_t crc_offset = FLIPPER_RNG_FRAME_HEADER_SIZE + length;
+        size_t size = crc_offset + FLIPPER_RNG_FRAME_CRC_SIZE;
+        if(decoder->fill < size) return;
+
+        uint32_t crc = (uint32_t)frame_get_le16(&decoder->buffer[crc_offset]) |
+                       ((uint32_t)frame_get_le16(&decoder->buffer[crc_offset + 2]) << 16);
+        if(crc != flipper_rng_crc32(0, decoder->buffer, crc_offset)) {
+            // Drop one byte and look for a frame starting inside this one
+            decoder->crc_errors++;
+            decoder->discarded_bytes++;
+            frame_decoder_consume(decoder, 1);
+            continue;
+        }
+
+        FlipperRngFrame frame = {
+            .seq = frame_get_le16(&decoder->buffer[2]),
+            .flags = decoder->buffer[6],
+            .length = length,
+            .payload = &decoder->buffer[FLIPPER_RNG_FRAME_HEADER_SIZE],
+        };
+        frame.lost = decoder->synced ? (uint16_t)(frame.seq - decoder->expected_seq) : 0;
+        decoder->synced = true;
+        decoder->expected_seq = (uint16_t)(frame.seq + 1);
+
+        decoder->frames++;
+        decoder->payload_bytes += length;
+        decoder->lost_frames += frame.lost;
+        if(frame.flags) decoder->flagged_frames++;
+        if(callback) callback(&frame, context);
+
+        frame_decoder_consume(decoder, size);
+    }
+}
+
+void flipper_rng_frame_decoder_feed(
+    FlipperRngFrameDecoder* decoder,
+    const uint8_t* data,
+    size_t length,
+    FlipperRngFrameCallback callback,
+    void* context) {
+    while(length > 0) {
+        size_t take = sizeof(decoder->buffer) - decoder->fill;
+        if(take > length) take = length;
+        memcpy(&decoder->buffer[decoder->fill], data, take);
+        decoder->fill += take;
+        data += take;
+        length -= take;
+        frame_decoder_parse(decoder, callback, context);
+    }
+}
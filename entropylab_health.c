@@ -0,0 +1,77 @@
+#include "entropylab_health.h"
+#include <string.h>
+
+typedef struct {
+    uint16_t rct;  // Run length that fails: 1 + ceil(20 / H)
+    uint16_t apt;  // Window count that fails: 1 + CRITBINOM(512, 2^-H, 1 - 2^-20), at least 2
+} FlipperRngHealthCutoff;
+
+// Indexed by credited bits H; the APT column is the exact binomial quantile
+static const FlipperRngHealthCutoff health_cutoffs[FLIPPER_RNG_HEALTH_MAX_BITS + 1] = {
+    {0, 0},  // Unused, zero-credit samples skip the tests
+    {21, 311}, {11, 177}, {8, 103}, {6, 62}, {5, 39}, {5, 25}, {4, 18}, {4, 13},  // H = 1..8
+    {4, 10}, {3, 8}, {3, 6}, {3, 5}, {3, 4}, {3, 4}, {3, 3}, {3, 3},  // H = 9..16
+    {3, 3}, {3, 3}, {3, 2}, {2, 2}, {2, 2}, {2, 2}, {2, 2}, {2, 2},  // H = 17..24
+    {2, 2}, {2, 2}, {2, 2}, {2, 2}, {2, 2}, {2, 2}, {2, 2}, {2, 2},  // H = 25..32
+};
+
+static uint8_t health_clamp_bits(uint8_t bits) {
+    if(bits == 0) return 1;
+    return bits > FLIPPER_RNG_HEALTH_MAX_BITS ? FLIPPER_RNG_HEALTH_MAX_BITS : bits;
+}
+
+uint16_t flipper_rng_health_rct_cutoff(uint8_t bits) {
+    return health_cutoffs[health_clamp_bits(bits)].rct;
+}
+
+uint16_t flipper_rng_health_apt_cutoff(uint8_t bits) {
+    return health_cutoffs[health_clamp_bits(bits)].apt;
+}
+
+void flipper_rng_health_init(FlipperRngHealth* health) {
+    memset(health, 0, sizeof(FlipperRngHealth));
+}
+
+FlipperRngHealthResult flipper_rng_health_test(FlipperRngHealth* health, uint32_t sample, uint8_t bits) {
+    if(bits == 0) return FlipperRngHealthPass;
+    const FlipperRngHealthCutoff* cutoff = &health_cutoffs[health_clamp_bits(bits)];
+    bool failed = false;
+
+    if(health->rct_run > 0 && sample == health->rct_value) {
+        if(++health->rct_run >= cutoff->rct) {
+            health->rct_failures++;
+            health->rct_run = 0;
+            failed = true;
+        }
+    } else {
+        health->rct_value = sample;
+        health->rct_run = 1;
+    }
+
+    if(health->apt_index == 0) {
+        health->apt_value = sample;
+        health->apt_count = 1;
+        health->apt_cutoff = cutoff->apt;
+        health->apt_index = 1;
+    } else {
+        if(sample == health->apt_value && ++health->apt_count >= health->apt_cutoff) {
+            health->apt_failures++;
+            health->apt_index = 0;
+            failed = true;
+        } else if(++health->apt_index == FLIPPER_RNG_HEALTH_APT_WINDOW) {
+            health->apt_index = 0;
+        }
+    }
+
+    FlipperRngHealthResult result = FlipperRngHealthPass;
+    if(failed) {
+        result = health->quarantine ? FlipperRngHealthQuarantined : FlipperRngHealthFailed;
+        health->quarantine = FLIPPER_RNG_HEALTH_QUARANTINE;
+    } else if(health->quarantine) {
+        health->quarantine--;
+        result = FlipperRngHealthQuarantined;
+    }
+
+    if(result != FlipperRngHealthPass) health->bits_discarded += bits;
+    return result;
+}
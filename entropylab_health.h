@@ -0,0 +1,63 @@
+#pragma once
+
+/**
+ * SP 800-90B continuous health tests (section 4.4)
+ * Every raw sample runs through the Repetition Count Test and the Adaptive
+ * Proportion Test before it is credited to the pool. Both are streaming and
+ * O(1) per sample: a sample is one symbol, compared whole, and its credited
+ * bits are the assessed min-entropy H that picks the cutoffs from a table
+ * precomputed for a false positive rate of 2^-20.
+ *
+ * A failure quarantines the source: its next FLIPPER_RNG_HEALTH_QUARANTINE
+ * samples are still tested but discarded with their credit. A source that
+ * keeps failing re-arms the quarantine and stays out of the pool.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FLIPPER_RNG_HEALTH_APT_WINDOW 512     // Non-binary window from SP 800-90B
+#define FLIPPER_RNG_HEALTH_MAX_BITS 32        // Cutoff table covers H = 1..32
+#define FLIPPER_RNG_HEALTH_QUARANTINE 1024    // Samples discarded after a failure
+
+typedef enum {
+    FlipperRngHealthPass,         // Credit the sample
+    FlipperRngHealthQuarantined,  // Discard, the source is still in quarantine
+    FlipperRngHealthFailed,       // Discard, this sample put the source into quarantine
+} FlipperRngHealthResult;
+
+typedef struct {
+    // Repetition Count Test
+    uint32_t rct_value;
+    uint16_t rct_run;
+
+    // Adaptive Proportion Test, apt_index 0 starts a new window
+    uint32_t apt_value;
+    uint16_t apt_index;
+    uint16_t apt_count;
+    uint16_t apt_cutoff;  // Fixed by the first sample of the window
+
+    uint16_t quarantine;  // Samples still to discard
+
+    // Statistics
+    uint32_t rct_failures;
+    uint32_t apt_failures;
+    uint32_t bits_discarded;
+} FlipperRngHealth;
+
+void flipper_rng_health_init(FlipperRngHealth* health);
+
+// Run both tests on one sample credited with bits; samples with no credit always pass
+FlipperRngHealthResult flipper_rng_health_test(FlipperRngHealth* health, uint32_t sample, uint8_t bits);
+
+static inline bool flipper_rng_health_is_quarantined(const FlipperRngHealth* health) {
+    return health->quarantine > 0;
+}
+
+static inline uint32_t flipper_rng_health_failures(const FlipperRngHealth* health) {
+    return health->rct_failures + health->apt_failures;
+}
+
+// Cutoffs for a sample credited with bits (clamped to 1..32)
+uint16_t flipper_rng_health_rct_cutoff(uint8_t bits);
+uint16_t flipper_rng_health_apt_cutoff(uint8_t bits);
@@ -157,6 +157,64 @@ bool flipper_rng_hw_aes_mix_pool(uint8_t* pool, size_t pool_size, uint32_t* key)
     return true;
 }
 
+// Standard AES-256-ECB (FIPS-197 byte order) for the CTR_DRBG
+// The pool mixer runs with byte swapping enabled, so switch to 32-bit data
+// and load key/data big-endian like furi_hal_crypto does, then restore
+bool flipper_rng_hw_aes_encrypt_blocks(const uint8_t* key, const uint8_t* input, uint8_t* output, size_t blocks) {
+    if(!hw_aes_mutex || !hw_aes_peripheral_ready) return false;
+    
+    if(furi_mutex_acquire(hw_aes_mutex, 10) != FuriStatusOk) {
+        FURI_LOG_D(TAG, "AES mutex busy, using software AES");
+        return false;
+    }
+    
+    CLEAR_BIT(AES1->CR, AES_CR_EN);
+    MODIFY_REG(AES1->CR, AES_CR_DATATYPE, 0);
+    
+    uint32_t key_words[8];
+    memcpy(key_words, key, sizeof(key_words));
+    AES1->KEYR7 = __builtin_bswap32(key_words[0]);
+    AES1->KEYR6 = __builtin_bswap32(key_words[1]);
+    AES1->KEYR5 = __builtin_bswap32(key_words[2]);
+    AES1->KEYR4 = __builtin_bswap32(key_words[3]);
+    AES1->KEYR3 = __builtin_bswap32(key_words[4]);
+    AES1->KEYR2 = __builtin_bswap32(key_words[5]);
+    AES1->KEYR1 = __builtin_bswap32(key_words[6]);
+    AES1->KEYR0 = __builtin_bswap32(key_words[7]);
+    memset(key_words, 0, sizeof(key_words));
+    
+    SET_BIT(AES1->CR, AES_CR_EN);
+    
+    bool success = true;
+    for(size_t i = 0; i < blocks; i++) {
+        uint32_t block[4];
+        memcpy(block, &input[i * 16], 16);
+        AES1->DINR = __builtin_bswap32(block[0]);
+        AES1->DINR = __builtin_bswap32(block[1]);
+        AES1->DINR = __builtin_bswap32(block[2]);
+        AES1->DINR = __builtin_bswap32(block[3]);
+        
+        if(!flipper_rng_hw_aes_wait_flag(AES_SR_CCF)) {
+            FURI_LOG_W(TAG, "AES operation timeout at block %zu", i);
+            success = false;
+            break;
+        }
+        SET_BIT(AES1->CR, AES_CR_CCFC);
+        
+        block[0] = __builtin_bswap32(AES1->DOUTR);
+        block[1] = __builtin_bswap32(AES1->DOUTR);
+        block[2] = __builtin_bswap32(AES1->DOUTR);
+        block[3] = __builtin_bswap32(AES1->DOUTR);
+        memcpy(&output[i * 16], block, 16);
+    }
+    
+    CLEAR_BIT(AES1->CR, AES_CR_EN);
+    MODIFY_REG(AES1->CR, AES_CR_DATATYPE, AES_CR_DATATYPE_1);  // Back to the mixer's configuration
+    
+    furi_mutex_release(hw_aes_mutex);
+    return success;
+}
+
 // Fast bit manipulation using compiler intrinsics
 uint32_t flipper_rng_hw_rotate_left(uint32_t value, uint8_t shift) {
     // Use compiler intrinsic for rotation if available
@@ -234,3 +292,20 @@ uint32_t flipper_rng_hw_cycles_elapsed(uint32_t start) {
 uint32_t flipper_rng_hw_cycles_to_us(uint32_t cycles) {
     return cycles / 64;  // 64 cycles per microsecond at 64MHz
 }
+
+// Monotonic nanoseconds derived from the DWT cycle counter
+// CYCCNT wraps every ~67s at 64MHz, so this must be called at least that often
+// The wrap state is shared, so only the worker thread may call this; other
+// threads time intervals with furi_get_tick()
+uint64_t flipper_rng_hw_get_time_ns(void) {
+    static uint32_t last_cycles = 0;
+    static uint64_t wrapped_cycles = 0;
+
+    uint32_t now = DWT->CYCCNT;
+    if(now < last_cycles) {
+        wrapped_cycles += (1ULL << 32);
+    }
+    last_cycles = now;
+
+    return ((wrapped_cycles + now) * 1000ULL) / 64;  // 15.625ns per cycle at 64MHz
+}
@@ -12,6 +12,10 @@ void flipper_rng_hw_accel_deinit(void);
 // Hardware AES mixing (ultra-fast)
 bool flipper_rng_hw_aes_mix_pool(uint8_t* pool, size_t pool_size, uint32_t* key);
 
+// Standard AES-256-ECB on the AES1 peripheral (32-byte key, 16-byte blocks, in-place allowed)
+// Returns false if the peripheral is busy or unavailable so the caller can fall back to software
+bool flipper_rng_hw_aes_encrypt_blocks(const uint8_t* key, const uint8_t* input, uint8_t* output, size_t blocks);
+
 // Fast bit manipulation using compiler intrinsics
 uint32_t flipper_rng_hw_rotate_left(uint32_t value, uint8_t shift);
 uint32_t flipper_rng_hw_rotate_right(uint32_t value, uint8_t shift);
@@ -29,3 +33,4 @@ void flipper_rng_hw_uart_tx_bulk(FuriHalSerialHandle* handle, const uint8_t* dat
 uint32_t flipper_rng_hw_get_cycles(void);
 uint32_t flipper_rng_hw_cycles_elapsed(uint32_t start);
 uint32_t flipper_rng_hw_cycles_to_us(uint32_t cycles);
+uint64_t flipper_rng_hw_get_time_ns(void);
@@ -0,0 +1,69 @@
+#include "entropylab_line_reader.h"
+#include <string.h>
+
+// Invariant: the file position is always window_start + window_fill, so
+// refilling from the end of the window never needs a seek
+
+static bool flipper_rng_line_reader_refill(FlipperRngLineReader* reader) {
+    reader->window_start += reader->window_fill;
+    reader->window_fill = (uint16_t)storage_file_read(reader->file, reader->window, sizeof(reader->window));
+    reader->pos = 0;
+    reader->refills++;
+    return reader->window_fill > 0;
+}
+
+void flipper_rng_line_reader_init(FlipperRngLineReader* reader, File* file) {
+    reader->file = file;
+    reader->refills = 0;
+    storage_file_seek(file, 0, true);
+    flipper_rng_line_reader_reset(reader);
+}
+
+void flipper_rng_line_reader_reset(FlipperRngLineReader* reader) {
+    reader->window_start = (uint32_t)storage_file_tell(reader->file);
+    reader->window_fill = 0;
+    reader->pos = 0;
+}
+
+bool flipper_rng_line_reader_seek(FlipperRngLineReader* reader, uint32_t offset) {
+    if(offset >= reader->window_start && offset - reader->window_start <= reader->window_fill) {
+        reader->pos = (uint16_t)(offset - reader->window_start);
+        return true;
+    }
+
+    bool ok = storage_file_seek(reader->file, offset, true);
+    flipper_rng_line_reader_reset(reader);
+    return ok;
+}
+
+uint32_t flipper_rng_line_reader_tell(const FlipperRngLineReader* reader) {
+    return reader->window_start + reader->pos;
+}
+
+bool flipper_rng_line_reader_read_line(FlipperRngLineReader* reader, char* buffer, size_t buffer_size) {
+    if(!reader->file || !buffer || buffer_size == 0) return false;
+
+    size_t length = 0;
+    bool consumed = false;
+
+    while(reader->pos < reader->window_fill || flipper_rng_line_reader_refill(reader)) {
+        const uint8_t* start = &reader->window[reader->pos];
+        size_t available = reader->window_fill - reader->pos;
+        const uint8_t* newline = memchr(start, '\n', available);
+        size_t span = newline ? (size_t)(newline - start) : available;
+
+        for(size_t i = 0; i < span; i++) {
+            // Carriage returns are dropped wherever they appear
+            if(start[i] != '\r' && length < buffer_size - 1) {
+                buffer[length++] = (char)start[i];
+            }
+        }
+
+        reader->pos += (uint16_t)(span + (newline ? 1 : 0));
+        consumed = true;
+        if(newline) break;
+    }
+
+    buffer[length] = '\0';
+    return consumed;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+/**
+ * Block-buffered line reader for text files on storage
+ * Every storage_file_read is a round trip to the storage service, so reading
+ * a wordlist one byte per call spends almost all its time in call overhead.
+ * The reader pulls the file in FLIPPER_RNG_LINE_READER_WINDOW byte blocks and
+ * serves lines out of the window; seeks that land inside the window cost no
+ * storage calls at all.
+ */
+
+#include <storage/storage.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define FLIPPER_RNG_LINE_READER_WINDOW 1024
+
+typedef struct {
+    File* file;
+    uint32_t window_start;  // File offset of window[0]
+    uint16_t window_fill;   // Valid bytes in window
+    uint16_t pos;           // Next byte to return, relative to window_start
+    bool file_synced;       // File position is window_start + window_fill
+    uint32_t refills;       // storage_file_read calls made, for benchmarking
+    uint8_t window[FLIPPER_RNG_LINE_READER_WINDOW];
+} FlipperRngLineReader;
+
+// Attach to an open file, starting at its beginning
+void flipper_rng_line_reader_init(FlipperRngLineReader* reader, File* file);
+
+// Drop the window; call after the file is reopened or moved by someone else
+void flipper_rng_line_reader_reset(FlipperRngLineReader* reader);
+
+// Move to an absolute offset, reusing the window when it already covers it
+bool flipper_rng_line_reader_seek(FlipperRngLineReader* reader, uint32_t offset);
+
+// Offset of the next byte read_line will return
+uint32_t flipper_rng_line_reader_tell(const FlipperRngLineReader* reader);
+
+// Read the next line without its "\r\n" or "\n", false at end of file
+// Lines longer than buffer_size - 1 are truncated and the rest is skipped
+bool flipper_rng_line_reader_read_line(FlipperRngLineReader* reader, char* buffer, size_t buffer_size);
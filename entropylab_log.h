@@ -0,0 +1,10 @@
+#pragma once
+
+#include <furi.h>
+
+// Logging wrappers used by the passphrase modules
+// Kept separate so passphrase logging can be silenced without touching FURI_LOG users
+#define LOG_D(tag, fmt, ...) FURI_LOG_D(tag, fmt, ##__VA_ARGS__)
+#define LOG_I(tag, fmt, ...) FURI_LOG_I(tag, fmt, ##__VA_ARGS__)
+#define LOG_W(tag, fmt, ...) FURI_LOG_W(tag, fmt, ##__VA_ARGS__)
+#define LOG_E(tag, fmt, ...) FURI_LOG_E(tag, fmt, ##__VA_ARGS__)
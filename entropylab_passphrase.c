@@ -10,55 +10,89 @@
 
 #define TAG "EntropyLab-Passphrase"
 
-// Generate a random index for the wordlist (0 to max_value-1)
-// Uses constant-time rejection sampling to prevent timing side-channel attacks
-uint16_t flipper_rng_passphrase_get_random_index(FlipperRngState* state, uint16_t max_value) {
-    // To avoid modulo bias, we'll use rejection sampling
-    // Max valid value is the largest multiple of max_value that fits in 16 bits
-    uint16_t max_valid = (65535 / max_value) * max_value;
-    
-    // Calculate rejection probability to determine max iterations needed
-    // Worst case: EFF wordlist (7776) has ~3.1% rejection rate
-    // 4 iterations gives us 99.99%+ success probability
-    const uint8_t MAX_ITERATIONS = 4;
-    
-    uint8_t random_bytes[2];
-    uint16_t random_value = 0;
-    bool found_valid = false;
-    
-    // CONSTANT-TIME: Always do exactly MAX_ITERATIONS, regardless of when we find valid value
-    // This prevents timing side-channel attacks that could leak information about rejected values
-    for(uint8_t iteration = 0; iteration < MAX_ITERATIONS; iteration++) {
-        // Get 2 bytes of entropy
-        flipper_rng_extract_random_bytes(state, random_bytes, 2);
-        uint16_t candidate = (random_bytes[0] << 8) | random_bytes[1];
+// Map a 32-bit draw onto [0, bound) with Lemire's multiply-shift method
+// The high word of draw * bound is the index; the low word tells whether the
+// draw fell in the short final interval that would bias it. Returns false
+// for such a draw, which the caller must replace with a fresh one.
+static inline bool passphrase_bounded(uint32_t draw, uint32_t bound, uint32_t threshold, uint16_t* index) {
+    uint64_t product = (uint64_t)draw * bound;
+    *index = (uint16_t)(product >> 32);
+    return (uint32_t)product >= threshold;
+}
+
+// Fill indices with uniform values in [0, bound) without touching the credit, returns the random bytes consumed
+// One extraction covers each batch; a rejected draw (probability below
+// bound / 2^32, about 2^-19 for the EFF list) costs one extra 4-byte extraction.
+// Rejections depend only on discarded draws, so timing reveals nothing about the output.
+size_t flipper_rng_passphrase_draw_indices(
+    FlipperRngState* state,
+    uint16_t* indices,
+    size_t count,
+    uint16_t bound) {
+    if(!indices || count == 0 || bound == 0) return 0;
+    
+    // 2^32 mod bound: draws whose low word falls below this are rejected
+    uint32_t threshold = (uint32_t)(-(uint32_t)bound) % bound;
+    uint32_t draws[PASSPHRASE_MAX_WORDS];
+    size_t consumed = 0;
+    
+    for(size_t done = 0; done < count;) {
+        size_t batch = MIN(count - done, COUNT_OF(draws));
         
-        // Check if this value is valid (no modulo bias)
-        bool is_valid = (candidate < max_valid);
+        flipper_rng_extract_random_bytes(state, (uint8_t*)draws, batch * sizeof(uint32_t));
+        consumed += batch * sizeof(uint32_t);
         
-        // Use constant-time selection: update random_value only on first valid candidate
-        // This ensures we always do the same number of operations
-        if(is_valid && !found_valid) {
-            random_value = candidate;
-            found_valid = true;
+        for(size_t i = 0; i < batch; i++) {
+            while(!passphrase_bounded(draws[i], bound, threshold, &indices[done + i])) {
+                flipper_rng_extract_random_bytes(state, (uint8_t*)&draws[i], sizeof(uint32_t));
+                consumed += sizeof(uint32_t);
+            }
         }
-        
-        // Always wipe the random bytes, regardless of whether we used them
-        secure_wipe(random_bytes, sizeof(random_bytes));
+        done += batch;
     }
     
-    // Extremely unlikely (< 0.01% chance), but if we didn't find valid value after MAX_ITERATIONS,
-    // use the last candidate modulo max_value (introduces tiny bias but prevents infinite loop)
-    if(!found_valid) {
-        LOG_W(TAG, "Rejection sampling failed after %d iterations, using fallback", MAX_ITERATIONS);
-        flipper_rng_extract_random_bytes(state, random_bytes, 2);
-        random_value = (random_bytes[0] << 8) | random_bytes[1];
-        secure_wipe(random_bytes, sizeof(random_bytes));
-    }
+    secure_wipe(draws, sizeof(draws));
+    return consumed;
+}
+
+uint32_t flipper_rng_passphrase_index_bits(uint16_t bound) {
+    return bound > 1 ? 32 - __builtin_clz((uint32_t)bound - 1) : 0;
+}
+
+// Draw indices a batch at a time, each batch debiting its credit before it is drawn
+size_t flipper_rng_passphrase_get_random_indices(
+    FlipperRngState* state,
+    uint16_t* indices,
+    size_t count,
+    uint16_t bound) {
+    if(!indices || count == 0 || bound == 0) return 0;
     
-    uint16_t result = random_value % max_value;
+    uint32_t index_bits = flipper_rng_passphrase_index_bits(bound);
+    size_t consumed = 0;
     
-    return result;
+    for(size_t done = 0; done < count;) {
+        size_t batch = MIN(count - done, (size_t)PASSPHRASE_MAX_WORDS);
+        
+        // Spend the batch's credit before drawing it, so indices never outrun the sources
+        uint32_t bits = (uint32_t)batch * index_bits;
+        if(!flipper_rng_debit_entropy_wait(state, bits, PASSPHRASE_CREDIT_WAIT_MS, NULL)) {
+            LOG_W(TAG, "No entropy credit for %lu bits after %u indices", (unsigned long)bits, (unsigned)done);
+            memset(indices, 0, count * sizeof(uint16_t));
+            return 0;
+        }
+        
+        consumed += flipper_rng_passphrase_draw_indices(state, &indices[done], batch, bound);
+        done += batch;
+    }
+    
+    return consumed;
+}
+
+// Generate a random index for the wordlist (0 to max_value-1)
+// False when no index was drawn, so a zero from missing credit is never mistaken for a draw
+bool flipper_rng_passphrase_get_random_index(FlipperRngState* state, uint16_t max_value, uint16_t* index) {
+    if(!index) return false;
+    return flipper_rng_passphrase_get_random_indices(state, index, 1, max_value) > 0;
 }
 
 // Generate a diceware passphrase - now uses only SD wordlists
@@ -108,9 +142,15 @@ void flipper_rng_passphrase_generate_sd(
     size_t current_pos = 0;
     uint16_t word_count = ctx->word_count;
     
+    // Every word index from a single extraction
+    uint16_t word_indices[PASSPHRASE_MAX_WORDS];
+    if(flipper_rng_passphrase_get_random_indices(state, word_indices, num_words, word_count) == 0) {
+        LOG_E(TAG, "Not enough entropy credit for a %d-word passphrase", num_words);
+        return;
+    }
+    
     for(uint8_t i = 0; i < num_words; i++) {
-        // Get random word index
-        uint16_t word_index = flipper_rng_passphrase_get_random_index(state, word_count);
+        uint16_t word_index = word_indices[i];
         
         // Get the word from SD card using indexed access if available
         const char* word;
@@ -148,6 +188,7 @@ void flipper_rng_passphrase_generate_sd(
     
     // Ensure null termination
     passphrase[current_pos] = '\0';
+    secure_wipe(word_indices, sizeof(word_indices));
     
     LOG_D(TAG, "Generated %d-word passphrase from SD wordlist", num_words);
     
@@ -13,6 +13,7 @@ typedef struct FlipperRngState FlipperRngState;
 #define PASSPHRASE_MIN_WORDS 3
 #define PASSPHRASE_MAX_WORDS 12
 #define PASSPHRASE_DEFAULT_WORDS 6
+#define PASSPHRASE_CREDIT_WAIT_MS 2000  // Longest wait for a batch of indices' entropy credit
 
 // Wordlists are shipped as files with the app
 // Official EFF wordlists provide the highest quality and security
@@ -31,6 +32,29 @@ void flipper_rng_passphrase_generate_sd(
     size_t max_length,
     uint8_t num_words);
 
-uint16_t flipper_rng_passphrase_get_random_index(FlipperRngState* state, uint16_t max_value);
+// Uniform index in [0, max_value), without modulo bias
+// Returns false, leaving no index, if its credit does not arrive in time
+bool flipper_rng_passphrase_get_random_index(FlipperRngState* state, uint16_t max_value, uint16_t* index);
+
+// Fill indices with count uniform values in [0, bound) from one extraction in the common case
+// Returns the random bytes consumed: 4 per index plus 4 per (rare) rejected draw
+// Debits ceil(log2(bound)) bits of entropy credit per index before drawing it;
+// returns 0 with indices zeroed if that credit does not arrive in time
+size_t flipper_rng_passphrase_get_random_indices(
+    FlipperRngState* state,
+    uint16_t* indices,
+    size_t count,
+    uint16_t bound);
+
+// As above without the debit, for a caller that has already spent the indices'
+// credit (count * flipper_rng_passphrase_index_bits(bound)) itself
+size_t flipper_rng_passphrase_draw_indices(
+    FlipperRngState* state,
+    uint16_t* indices,
+    size_t count,
+    uint16_t bound);
+
+// Credit one index in [0, bound) carries: ceil(log2(bound)) bits
+uint32_t flipper_rng_passphrase_index_bits(uint16_t bound);
 
 float flipper_rng_passphrase_entropy_bits(uint8_t num_words);
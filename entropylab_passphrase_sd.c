@@ -1,43 +1,12 @@
 #include "entropylab_passphrase_sd.h"
+#include "entropylab_secure.h"
 #include <furi.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
 
 #define TAG "EntropyLab-PassphraseSD"
 
-// Helper function to read a line from file
-static bool storage_file_read_line_helper(File* file, char* buffer, size_t buffer_size) {
-    if(!file || !buffer || buffer_size == 0) return false;
-    
-    size_t pos = 0;
-    uint8_t byte;
-    
-    while(pos < buffer_size - 1) {
-        if(storage_file_read(file, &byte, 1) != 1) {
-            // End of file or error
-            if(pos > 0) {
-                buffer[pos] = '\0';
-                return true;
-            }
-            return false;
-        }
-        
-        if(byte == '\n') {
-            // End of line
-            buffer[pos] = '\0';
-            return true;
-        } else if(byte == '\r') {
-            // Skip carriage return
-            continue;
-        } else {
-            buffer[pos++] = byte;
-        }
-    }
-    
-    buffer[pos] = '\0';
-    return true;
-}
-
 // Helper to extract word from EFF format line (skips dice numbers)
 static void extract_word_from_line(char* line, char* word, size_t word_size) {
     // EFF format: "11111   word" or just "word"
@@ -79,10 +48,23 @@ PassphraseSDContext* flipper_rng_passphrase_sd_alloc(void) {
         memset(ctx->current_word, 0, sizeof(ctx->current_word));
         
         // Initialize performance optimization fields
+        flipper_rng_word_arena_init(&ctx->arena);
+        ctx->use_arena = true;
         ctx->line_offsets = NULL;
         ctx->cache_size = 0;
-        ctx->word_cache = NULL;
-        ctx->cache_indices = NULL;
+        ctx->cache_hits = 0;
+        ctx->cache_misses = 0;
+        ctx->word_cache = malloc(PASSPHRASE_CACHE_CAPACITY * sizeof(ctx->current_word));
+        ctx->cache_indices = malloc(PASSPHRASE_CACHE_CAPACITY * sizeof(uint16_t));
+        if(ctx->word_cache && ctx->cache_indices) {
+            memset(ctx->cache_indices, 0xFF, PASSPHRASE_CACHE_CAPACITY * sizeof(uint16_t));
+        } else {
+            // Lookups still work, just uncached
+            free(ctx->word_cache);
+            free(ctx->cache_indices);
+            ctx->word_cache = NULL;
+            ctx->cache_indices = NULL;
+        }
         ctx->is_indexed = false;
         ctx->is_building_index = false;
         ctx->index_progress = 0.0f;
@@ -93,15 +75,12 @@ PassphraseSDContext* flipper_rng_passphrase_sd_alloc(void) {
 void flipper_rng_passphrase_sd_free(PassphraseSDContext* ctx) {
     if(ctx) {
         // Free index and cache
+        flipper_rng_word_arena_free(&ctx->arena);
         if(ctx->line_offsets) {
             free(ctx->line_offsets);
         }
         if(ctx->word_cache) {
-            for(uint16_t i = 0; i < ctx->cache_size; i++) {
-                if(ctx->word_cache[i]) {
-                    free(ctx->word_cache[i]);
-                }
-            }
+            flipper_rng_passphrase_sd_wipe_cache(ctx);
             free(ctx->word_cache);
         }
         if(ctx->cache_indices) {
@@ -165,6 +144,15 @@ bool flipper_rng_passphrase_sd_load(PassphraseSDContext* ctx, PassphraseListType
         return true;
     }
     
+    // The index and arena describe one list; drop them when switching to another
+    if(ctx->is_indexed && ctx->type != type) {
+        flipper_rng_word_arena_free(&ctx->arena);
+        free(ctx->line_offsets);
+        ctx->line_offsets = NULL;
+        ctx->is_indexed = false;
+        flipper_rng_passphrase_sd_wipe_cache(ctx);
+    }
+    
     // Close any previously opened file
     if(ctx->is_loaded) {
         storage_file_close(ctx->file);
@@ -186,6 +174,7 @@ bool flipper_rng_passphrase_sd_load(PassphraseSDContext* ctx, PassphraseListType
     ctx->word_count = flipper_rng_passphrase_sd_get_expected_count(type);
     ctx->type = type;
     ctx->is_loaded = true;
+    flipper_rng_line_reader_init(&ctx->reader, ctx->file);
     
     FURI_LOG_I(TAG, "Opened wordlist %s with %d words", path, ctx->word_count);
     
@@ -202,12 +191,12 @@ const char* flipper_rng_passphrase_sd_get_word(PassphraseSDContext* ctx, uint16_
     }
     
     // Seek to beginning of file
-    storage_file_seek(ctx->file, 0, true);
+    flipper_rng_line_reader_seek(&ctx->reader, 0);
     
     // Read lines until we reach the desired index
     char line_buffer[64];
     for(uint16_t i = 0; i <= index; i++) {
-        if(!storage_file_read_line_helper(ctx->file, line_buffer, sizeof(line_buffer))) {
+        if(!flipper_rng_line_reader_read_line(&ctx->reader, line_buffer, sizeof(line_buffer))) {
             FURI_LOG_E(TAG, "Failed to read word at index %d", index);
             return NULL;
         }
@@ -274,6 +263,148 @@ float flipper_rng_passphrase_sd_entropy_bits(PassphraseListType type, uint8_t nu
     return num_words * bits_per_word;
 }
 
+// FNV-1a, continuing from hash
+static uint32_t passphrase_index_fnv1a(uint32_t hash, const void* data, size_t length) {
+    const uint8_t* bytes = data;
+    for(size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t passphrase_index_checksum(const PassphraseIndexHeader* header, const uint32_t* offsets) {
+    uint32_t hash = 2166136261u;
+    hash = passphrase_index_fnv1a(hash, header, offsetof(PassphraseIndexHeader, checksum));
+    return passphrase_index_fnv1a(hash, offsets, header->word_count * sizeof(uint32_t));
+}
+
+// Fill in everything except the checksum from the open wordlist
+static bool passphrase_index_describe(PassphraseSDContext* ctx, PassphraseIndexHeader* header) {
+    const char* path = flipper_rng_passphrase_sd_get_path(ctx->type);
+    memset(header, 0, sizeof(PassphraseIndexHeader));
+    header->magic = PASSPHRASE_INDEX_MAGIC;
+    header->version = PASSPHRASE_INDEX_VERSION;
+    header->word_count = ctx->word_count;
+    header->wordlist_size = (uint32_t)storage_file_size(ctx->file);
+    return path && storage_common_timestamp(ctx->storage, path, &header->wordlist_timestamp) == FSE_OK;
+}
+
+static void passphrase_index_path(PassphraseSDContext* ctx, char* out, size_t out_size) {
+    snprintf(out, out_size, "%s%s", flipper_rng_passphrase_sd_get_path(ctx->type), PASSPHRASE_INDEX_SUFFIX);
+}
+
+// Read the sidecar straight into ctx->line_offsets; false if missing, stale or corrupt
+static bool passphrase_index_load(PassphraseSDContext* ctx) {
+    PassphraseIndexHeader expected, header;
+    if(!passphrase_index_describe(ctx, &expected)) return false;
+    
+    char path[96];
+    passphrase_index_path(ctx, path, sizeof(path));
+    File* file = storage_file_alloc(ctx->storage);
+    
+    bool valid = false;
+    size_t offsets_size = ctx->word_count * sizeof(uint32_t);
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        valid = storage_file_read(file, &header, sizeof(header)) == sizeof(header) &&
+                memcmp(&header, &expected, offsetof(PassphraseIndexHeader, checksum)) == 0 &&
+                storage_file_read(file, ctx->line_offsets, offsets_size) == offsets_size &&
+                header.checksum == passphrase_index_checksum(&header, ctx->line_offsets);
+        storage_file_close(file);
+    }
+    storage_file_free(file);
+    
+    // Offsets must start at 0 and increase within the file
+    for(uint16_t i = 1; valid && i < ctx->word_count; i++) {
+        valid = ctx->line_offsets[i] > ctx->line_offsets[i - 1] && ctx->line_offsets[i] < header.wordlist_size;
+    }
+    valid = valid && ctx->line_offsets[0] == 0;
+    
+    if(valid) {
+        FURI_LOG_I(TAG, "Loaded index from %s", path);
+    }
+    return valid;
+}
+
+static void passphrase_index_save(PassphraseSDContext* ctx) {
+    PassphraseIndexHeader header;
+    if(!passphrase_index_describe(ctx, &header)) return;
+    header.checksum = passphrase_index_checksum(&header, ctx->line_offsets);
+    
+    char path[96];
+    passphrase_index_path(ctx, path, sizeof(path));
+    File* file = storage_file_alloc(ctx->storage);
+    
+    size_t offsets_size = ctx->word_count * sizeof(uint32_t);
+    bool saved = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                 storage_file_write(file, &header, sizeof(header)) == sizeof(header) &&
+                 storage_file_write(file, ctx->line_offsets, offsets_size) == offsets_size;
+    storage_file_close(file);
+    storage_file_free(file);
+    
+    if(saved) {
+        FURI_LOG_I(TAG, "Saved index to %s", path);
+    } else {
+        // Leave no partial sidecar behind; the next load simply rescans
+        FURI_LOG_W(TAG, "Failed to save index to %s", path);
+        storage_common_remove(ctx->storage, path);
+    }
+}
+
+// One pass over the wordlist feeding every word to the arena; progress covers [base, base + 0.5]
+static bool passphrase_arena_pass(
+    PassphraseSDContext* ctx,
+    float base,
+    void (*progress_callback)(float progress, void* context),
+    void* callback_context) {
+    char line_buffer[64];
+    char word[32];
+    
+    flipper_rng_line_reader_seek(&ctx->reader, 0);
+    for(uint16_t i = 0; i < ctx->word_count; i++) {
+        if(!flipper_rng_line_reader_read_line(&ctx->reader, line_buffer, sizeof(line_buffer))) {
+            FURI_LOG_E(TAG, "Wordlist ended at word %d", i);
+            return false;
+        }
+        extract_word_from_line(line_buffer, word, sizeof(word));
+        if(!flipper_rng_word_arena_append(&ctx->arena, word)) {
+            FURI_LOG_W(TAG, "Word %d (\"%s\") cannot be stored in the arena", i, word);
+            return false;
+        }
+        
+        if((i + 1) % 100 == 0 || i + 1 == ctx->word_count) {
+            ctx->index_progress = base + 0.5f * (i + 1) / ctx->word_count;
+            if(progress_callback) {
+                progress_callback(ctx->index_progress, callback_context);
+            }
+        }
+    }
+    return true;
+}
+
+// Size the arena in a first pass, then encode the list into it
+static bool passphrase_arena_build(
+    PassphraseSDContext* ctx,
+    void (*progress_callback)(float progress, void* context),
+    void* callback_context) {
+    flipper_rng_word_arena_init(&ctx->arena);
+    bool built = passphrase_arena_pass(ctx, 0.0f, progress_callback, callback_context) &&
+                 flipper_rng_word_arena_allocate(&ctx->arena) &&
+                 passphrase_arena_pass(ctx, 0.5f, progress_callback, callback_context) &&
+                 flipper_rng_word_arena_is_ready(&ctx->arena);
+    
+    if(built) {
+        FURI_LOG_I(
+            TAG,
+            "Loaded %d words into RAM, %u bytes",
+            ctx->word_count,
+            (unsigned)flipper_rng_word_arena_memory(&ctx->arena));
+    } else {
+        flipper_rng_word_arena_free(&ctx->arena);
+    }
+    return built;
+}
+
 // Build index for fast word access
 bool flipper_rng_passphrase_sd_build_index(PassphraseSDContext* ctx, void (*progress_callback)(float progress, void* context), void* callback_context) {
     if(!ctx || !ctx->is_loaded) {
@@ -290,6 +421,17 @@ bool flipper_rng_passphrase_sd_build_index(PassphraseSDContext* ctx, void (*prog
     
     FURI_LOG_I(TAG, "Building index for %d words...", ctx->word_count);
     
+    // Preferred: the whole list in RAM, generation never touches the SD card
+    if(ctx->use_arena) {
+        if(passphrase_arena_build(ctx, progress_callback, callback_context)) {
+            ctx->is_indexed = true;
+            ctx->is_building_index = false;
+            return true;
+        }
+        ctx->index_progress = 0.0f;
+        FURI_LOG_W(TAG, "Falling back to SD line offsets");
+    }
+    
     // Allocate memory for line offsets
     ctx->line_offsets = malloc(ctx->word_count * sizeof(uint32_t));
     if(!ctx->line_offsets) {
@@ -298,18 +440,29 @@ bool flipper_rng_passphrase_sd_build_index(PassphraseSDContext* ctx, void (*prog
         return false;
     }
     
+    // A saved index for this exact wordlist skips the scan entirely
+    if(passphrase_index_load(ctx)) {
+        ctx->is_indexed = true;
+        ctx->is_building_index = false;
+        ctx->index_progress = 1.0f;
+        if(progress_callback) {
+            progress_callback(ctx->index_progress, callback_context);
+        }
+        return true;
+    }
+    
     // Seek to beginning and build index
-    storage_file_seek(ctx->file, 0, true);
+    flipper_rng_line_reader_seek(&ctx->reader, 0);
     
     char line_buffer[64];
     uint16_t word_index = 0;
     
     while(word_index < ctx->word_count) {
         // Store current file position
-        ctx->line_offsets[word_index] = storage_file_tell(ctx->file);
+        ctx->line_offsets[word_index] = flipper_rng_line_reader_tell(&ctx->reader);
         
         // Read the line to advance file pointer
-        if(!storage_file_read_line_helper(ctx->file, line_buffer, sizeof(line_buffer))) {
+        if(!flipper_rng_line_reader_read_line(&ctx->reader, line_buffer, sizeof(line_buffer))) {
             FURI_LOG_E(TAG, "Failed to read line %d during indexing", word_index);
             break;
         }
@@ -330,6 +483,7 @@ bool flipper_rng_passphrase_sd_build_index(PassphraseSDContext* ctx, void (*prog
     
     if(ctx->is_indexed) {
         FURI_LOG_I(TAG, "Index built successfully for %d words", ctx->word_count);
+        passphrase_index_save(ctx);
     } else {
         FURI_LOG_E(TAG, "Index building failed at word %d", word_index);
         free(ctx->line_offsets);
@@ -339,6 +493,31 @@ bool flipper_rng_passphrase_sd_build_index(PassphraseSDContext* ctx, void (*prog
     return ctx->is_indexed;
 }
 
+// SD path: read word index into current_word through its line offset
+static bool passphrase_read_word_at_offset(PassphraseSDContext* ctx, uint16_t index) {
+    // Seek directly to the word's position; free if it is already in the window
+    if(!flipper_rng_line_reader_seek(&ctx->reader, ctx->line_offsets[index])) {
+        FURI_LOG_E(TAG, "Failed to seek to word %d", index);
+        return false;
+    }
+    
+    // Read the line
+    char line_buffer[64];
+    if(!flipper_rng_line_reader_read_line(&ctx->reader, line_buffer, sizeof(line_buffer))) {
+        FURI_LOG_E(TAG, "Failed to read word at index %d", index);
+        return false;
+    }
+    
+    // Extract just the word from the line (skip dice numbers)
+    extract_word_from_line(line_buffer, ctx->current_word, sizeof(ctx->current_word));
+    
+    return true;
+}
+
+static char* passphrase_cache_slot(PassphraseSDContext* ctx, uint16_t index) {
+    return &ctx->word_cache[(index & (PASSPHRASE_CACHE_CAPACITY - 1)) * sizeof(ctx->current_word)];
+}
+
 // Get a word by index using indexed access (much faster)
 const char* flipper_rng_passphrase_sd_get_word_indexed(PassphraseSDContext* ctx, uint16_t index) {
     if(!ctx || !ctx->is_loaded || !ctx->is_indexed) {
@@ -351,25 +530,43 @@ const char* flipper_rng_passphrase_sd_get_word_indexed(PassphraseSDContext* ctx,
         return NULL;
     }
     
-    // Seek directly to the word's position
-    if(!storage_file_seek(ctx->file, ctx->line_offsets[index], true)) {
-        FURI_LOG_E(TAG, "Failed to seek to word %d", index);
-        return NULL;
+    uint16_t slot = index & (PASSPHRASE_CACHE_CAPACITY - 1);
+    if(ctx->word_cache && ctx->cache_indices[slot] == index) {
+        ctx->cache_hits++;
+        return passphrase_cache_slot(ctx, index);
     }
+    ctx->cache_misses++;
     
-    // Read the line
-    char line_buffer[64];
-    if(!storage_file_read_line_helper(ctx->file, line_buffer, sizeof(line_buffer))) {
-        FURI_LOG_E(TAG, "Failed to read word at index %d", index);
+    if(flipper_rng_word_arena_is_ready(&ctx->arena)) {
+        if(!flipper_rng_word_arena_get(&ctx->arena, index, ctx->current_word, sizeof(ctx->current_word))) {
+            FURI_LOG_E(TAG, "Failed to decode word %d", index);
+            return NULL;
+        }
+    } else if(!passphrase_read_word_at_offset(ctx, index)) {
         return NULL;
     }
     
-    // Extract just the word from the line (skip dice numbers)
-    extract_word_from_line(line_buffer, ctx->current_word, sizeof(ctx->current_word));
-    
+    if(ctx->word_cache) {
+        if(ctx->cache_indices[slot] == PASSPHRASE_CACHE_EMPTY) {
+            ctx->cache_size++;
+        }
+        ctx->cache_indices[slot] = index;
+        memcpy(passphrase_cache_slot(ctx, index), ctx->current_word, sizeof(ctx->current_word));
+    }
     return ctx->current_word;
 }
 
+void flipper_rng_passphrase_sd_wipe_cache(PassphraseSDContext* ctx) {
+    if(!ctx) return;
+    
+    if(ctx->word_cache) {
+        secure_wipe(ctx->word_cache, PASSPHRASE_CACHE_CAPACITY * sizeof(ctx->current_word));
+        memset(ctx->cache_indices, 0xFF, PASSPHRASE_CACHE_CAPACITY * sizeof(uint16_t));
+    }
+    ctx->cache_size = 0;
+    secure_wipe(ctx->current_word, sizeof(ctx->current_word));
+}
+
 // Check if index is built
 bool flipper_rng_passphrase_sd_is_indexed(PassphraseSDContext* ctx) {
     return ctx && ctx->is_indexed;
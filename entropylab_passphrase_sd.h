@@ -1,6 +1,8 @@
 #pragma once
 
 #include <storage/storage.h>
+#include "entropylab_line_reader.h"
+#include "entropylab_wordlist_arena.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -9,6 +11,25 @@
 #define PASSPHRASE_BIP39_PATH "/ext/apps_data/entropylab/bip39_english.txt"
 #define PASSPHRASE_SLIP39_PATH "/ext/apps_data/entropylab/slip39_english.txt"
 
+// Line-offset index saved next to each wordlist as "<wordlist>.idx"
+// Reused while the wordlist's size and timestamp match the header
+#define PASSPHRASE_INDEX_SUFFIX ".idx"
+#define PASSPHRASE_INDEX_MAGIC 0x58494C45  // "ELIX"
+#define PASSPHRASE_INDEX_VERSION 1
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t word_count;
+    uint32_t wordlist_size;       // Bytes
+    uint32_t wordlist_timestamp;  // storage_common_timestamp() of the wordlist
+    uint32_t checksum;            // FNV-1a over the fields above and the offsets
+} PassphraseIndexHeader;
+
+// Decoded word cache: direct-mapped slots in one slab, no per-word allocation
+#define PASSPHRASE_CACHE_CAPACITY 64  // Slots, power of two
+#define PASSPHRASE_CACHE_EMPTY 0xFFFF  // cache_indices value of an unused slot
+
 // Wordlist sizes and entropy
 #define EFF_LONG_SIZE 7776    // 6^5 dice rolls, ~12.925 bits per word
 #define BIP39_SIZE 2048       // 2^11 words, 11.0 bits per word
@@ -28,12 +49,17 @@ typedef struct {
     Storage* storage;
     File* file;              // Keep file open for reading
     char current_word[32];   // Buffer for current word
+    FlipperRngLineReader reader;  // Buffered reads of file, used for every lookup
     
     // Performance optimizations
+    FlipperRngWordArena arena;  // Whole list decoded from RAM once ready; no SD access per word
+    bool use_arena;             // false keeps lookups on the SD card (line offsets)
     uint32_t* line_offsets;  // File offsets for each word (indexed access)
     uint16_t cache_size;     // Number of cached words
-    char** word_cache;       // Cache for frequently accessed words
-    uint16_t* cache_indices; // Indices of cached words
+    char* word_cache;        // Slab of PASSPHRASE_CACHE_CAPACITY words, sizeof(current_word) each
+    uint16_t* cache_indices; // Word index held by each slot
+    uint32_t cache_hits;     // Lookups served from word_cache
+    uint32_t cache_misses;   // Lookups that decoded or read the word
     bool is_indexed;         // Whether line offsets have been built
     
     // Progress tracking
@@ -61,11 +87,16 @@ const char* flipper_rng_passphrase_sd_get_word(PassphraseSDContext* ctx, uint16_
 bool flipper_rng_passphrase_sd_create_defaults(Storage* storage);
 
 // Build index for fast word access (async with progress callback)
+// Loads the list into the in-RAM arena; if that fails, falls back to SD line offsets,
+// loading the .idx sidecar when it is still valid or scanning the wordlist and saving one
 bool flipper_rng_passphrase_sd_build_index(PassphraseSDContext* ctx, void (*progress_callback)(float progress, void* context), void* callback_context);
 
-// Get a word by index using indexed access (much faster)
+// Get a word by index using indexed access (much faster, no SD access with the arena)
 const char* flipper_rng_passphrase_sd_get_word_indexed(PassphraseSDContext* ctx, uint16_t index);
 
+// Securely wipe cached words and current_word, keeping the hit/miss counters
+void flipper_rng_passphrase_sd_wipe_cache(PassphraseSDContext* ctx);
+
 // Check if index is built
 bool flipper_rng_passphrase_sd_is_indexed(PassphraseSDContext* ctx);
 
@@ -3,11 +3,15 @@
 #include "entropylab_passphrase.h"
 #include "entropylab_passphrase_sd.h"
 #include "entropylab_entropy.h"
+#include "entropylab_bulk.h"
+#include "entropylab_file_writer.h"
+#include "entropylab_hw_accel.h"
 #include "entropylab_secure.h"
 #include "entropylab_log.h"
 #include <gui/elements.h>
 #include <string.h>
 #include <furi.h>
+#include <furi_hal_serial.h>
 
 #define TAG "EntropyLab-PassphraseView"
 
@@ -25,6 +29,14 @@ typedef struct {
     PassphraseSDContext* sd_context;
 } IndexBuildWorkerContext;
 
+// Bulk generation thread context, owned by the model until the thread is joined
+typedef struct {
+    FlipperRngApp* app;
+    PassphraseSDContext* sd_context;
+    FlipperRngBulkConfig config;
+    atomic_bool cancel;
+} BulkWorkerContext;
+
 // Passphrase Generator view model
 typedef struct {
     char passphrase[512];  // Current passphrase - increased for up to 12 words
@@ -40,6 +52,9 @@ typedef struct {
     char load_status[64];  // Loading status message
     bool started_worker;   // Whether this view started the entropy worker
     FuriThread* index_worker_thread;  // Handle to index building thread (for cleanup)
+    FuriThread* bulk_thread;          // Bulk generation thread, NULL when idle
+    BulkWorkerContext* bulk_context;  // Freed once bulk_thread is joined
+    bool is_bulk_running;             // Bulk generation in progress
 } FlipperRngPassphraseModel;
 
 // Progress callback for index building
@@ -96,6 +111,119 @@ static int32_t index_build_worker(void* context) {
     return 0;
 }
 
+static void bulk_write_uart(const uint8_t* data, size_t length, void* context) {
+    flipper_rng_hw_uart_tx_bulk(context, data, length);
+}
+
+static void bulk_write_file(const uint8_t* data, size_t length, void* context) {
+    flipper_rng_file_writer_write_wait(context, data, length);
+}
+
+// Bulk generation thread: streams to UART in UART output mode, otherwise to FLIPPER_RNG_BULK_FILE_PATH
+static int32_t bulk_worker(void* context) {
+    BulkWorkerContext* bulk = context;
+    FlipperRngApp* app = bulk->app;
+    FlipperRngBulkStats stats = {0};
+    bool ok = false;
+    const char* target;
+    
+    if(app->state->output_mode == OutputModeUART) {
+        // The generator keeps its own UART handle while streaming from the menu
+        FuriHalSerialHandle* serial = app->state->serial_handle ? NULL :
+                                                                  furi_hal_serial_control_acquire(FuriHalSerialIdUsart);
+        target = serial ? "UART" : "UART (busy)";
+        if(serial) {
+            furi_hal_serial_init(serial, app->state->uart_baud);
+            ok = flipper_rng_bulk_generate(app->state, bulk->sd_context, &bulk->config, bulk_write_uart, serial, &stats);
+            furi_hal_serial_deinit(serial);
+            furi_hal_serial_control_release(serial);
+        }
+    } else {
+        FlipperRngFileWriter* writer =
+            flipper_rng_file_writer_open(FLIPPER_RNG_BULK_FILE_PATH, FLIPPER_RNG_FILE_WRITER_BUFFER_SIZE);
+        target = writer ? "SD" : "SD (open failed)";
+        if(writer) {
+            ok = flipper_rng_bulk_generate(app->state, bulk->sd_context, &bulk->config, bulk_write_file, writer, &stats);
+            flipper_rng_file_writer_close(writer);
+        }
+    }
+    
+    with_view_model(
+        app->diceware_view,
+        FlipperRngPassphraseModel* model,
+        {
+            snprintf(model->passphrase, sizeof(model->passphrase), "Bulk: %lu %s to %s, %lu/s%s",
+                     stats.generated, flipper_rng_bulk_format_name(bulk->config.format), target,
+                     stats.per_sec, ok ? "" : " - FAILED");
+            model->is_bulk_running = false;
+        },
+        true
+    );
+    
+    return 0;
+}
+
+// Start a bulk run of FLIPPER_RNG_BULK_DEFAULT_COUNT items; called with the model locked
+static void flipper_rng_passphrase_start_bulk(FlipperRngApp* app, FlipperRngPassphraseModel* model, FlipperRngBulkFormat format) {
+    if(model->is_bulk_running || model->is_loading) return;
+    if(!app->state->entropy_ready) {
+        snprintf(model->passphrase, sizeof(model->passphrase), "Please wait...\nCollecting entropy");
+        return;
+    }
+    if(format == FlipperRngBulkPassphrase && !flipper_rng_passphrase_sd_is_indexed(model->sd_context)) return;
+    
+    // Reap a finished previous run
+    if(model->bulk_thread) {
+        furi_thread_join(model->bulk_thread);
+        furi_thread_free(model->bulk_thread);
+        free(model->bulk_context);
+        model->bulk_thread = NULL;
+        model->bulk_context = NULL;
+    }
+    
+    BulkWorkerContext* bulk = malloc(sizeof(BulkWorkerContext));
+    bulk->app = app;
+    bulk->sd_context = model->sd_context;
+    flipper_rng_bulk_config_default(&bulk->config);
+    bulk->config.format = format;
+    bulk->config.num_words = model->num_words;
+    atomic_init(&bulk->cancel, false);
+    bulk->config.cancel = &bulk->cancel;
+    bulk->config.wait_for_credit = true;
+    
+    secure_wipe(model->passphrase, sizeof(model->passphrase));
+    snprintf(model->passphrase, sizeof(model->passphrase), "Bulk: generating %lu %s...",
+             bulk->config.count, flipper_rng_bulk_format_name(format));
+    model->is_bulk_running = true;
+    model->bulk_context = bulk;
+    model->bulk_thread = furi_thread_alloc_ex("BulkGen", 2048, bulk_worker, bulk);
+    furi_thread_start(model->bulk_thread);
+}
+
+// Cancel and join a bulk run; must be called without the model locked
+static void flipper_rng_passphrase_stop_bulk(View* view) {
+    FuriThread* thread = NULL;
+    BulkWorkerContext* bulk = NULL;
+    with_view_model(
+        view,
+        FlipperRngPassphraseModel* model,
+        {
+            thread = model->bulk_thread;
+            bulk = model->bulk_context;
+            model->bulk_thread = NULL;
+            model->bulk_context = NULL;
+        },
+        false
+    );
+    
+    if(thread) {
+        atomic_store(&bulk->cancel, true);
+        furi_thread_join(thread);
+        furi_thread_free(thread);
+        free(bulk);
+    }
+}
+
 // Start entropy worker for continuous background entropy collection
 static void flipper_rng_passphrase_start_entropy_worker(FlipperRngApp* app) {
     // Only start if not already running
@@ -129,6 +257,8 @@ static void flipper_rng_passphrase_start_entropy_worker(FlipperRngApp* app) {
     app->state->bits_from_hw_rng = 0;
     app->state->bits_from_subghz_rssi = 0;
     app->state->bits_from_infrared = 0;
+    flipper_rng_init_health(app->state);
+    flipper_rng_init_estimators(app->state);
     memset(app->state->byte_histogram, 0, sizeof(app->state->byte_histogram));
     
     // Start the worker thread for background entropy collection
@@ -322,6 +452,13 @@ void flipper_rng_passphrase_draw_callback(Canvas* canvas, void* context) {
         }
     } else {
         canvas_draw_str_aligned(canvas, 64, 38, AlignCenter, AlignTop, "Press OK to generate");
+        
+        canvas_draw_str_aligned(canvas, 64, 46, AlignCenter, AlignTop, "Hold OK/Up/Down: bulk");
+        
+        // Word cache effectiveness
+        snprintf(info_str, sizeof(info_str), "Cache: %lu hit / %lu miss",
+                 model->sd_context->cache_hits, model->sd_context->cache_misses);
+        canvas_draw_str_aligned(canvas, 64, 55, AlignCenter, AlignTop, info_str);
     }
 }
 
@@ -330,6 +467,28 @@ bool flipper_rng_passphrase_input_callback(InputEvent* event, void* context) {
     FlipperRngApp* app = context;
     bool consumed = false;
     
+    if(event->type == InputTypeLong) {
+        // Long press: bulk generation, OK = passphrases, Up = hex keys, Down = base32 keys
+        FlipperRngBulkFormat format;
+        if(event->key == InputKeyOk) {
+            format = FlipperRngBulkPassphrase;
+        } else if(event->key == InputKeyUp) {
+            format = FlipperRngBulkHex;
+        } else if(event->key == InputKeyDown) {
+            format = FlipperRngBulkBase32;
+        } else {
+            return false;
+        }
+        
+        with_view_model(
+            app->diceware_view,
+            FlipperRngPassphraseModel* model,
+            { flipper_rng_passphrase_start_bulk(app, model, format); },
+            true
+        );
+        return true;
+    }
+    
     if(event->type == InputTypePress) {
         consumed = true;
         
@@ -340,17 +499,19 @@ bool flipper_rng_passphrase_input_callback(InputEvent* event, void* context) {
                     app->diceware_view,
                     FlipperRngPassphraseModel* model,
                     {
-                        // Check if entropy is ready (minimum collection time elapsed)
+                        // Check if entropy is ready (enough credited bits in the pool)
                         if(!app->state->entropy_ready) {
                             // Show warning - not enough entropy collected yet
-                            LOG_W(TAG, "Entropy not ready yet, please wait for minimum collection time");
+                            LOG_W(TAG, "Entropy not ready yet, %lu of %d bits credited",
+                                  app->state->entropy_credit, RNG_CREDIT_READY_BITS);
                             snprintf(model->passphrase, sizeof(model->passphrase), 
                                     "Please wait...\nCollecting entropy");
                             break;
                         }
                         
                         // Only generate if wordlist is loaded and not currently loading/indexing/generating
-                        if(model->sd_context && model->sd_context->is_loaded && !model->is_loading && !model->is_generating) {
+                        if(model->sd_context && model->sd_context->is_loaded && !model->is_loading && !model->is_generating &&
+                           !model->is_bulk_running) {
                             model->is_generating = true;
                             
                             // Securely wipe old passphrase before generating new one
@@ -512,12 +673,17 @@ void flipper_rng_passphrase_exit_callback(void* context) {
     
     LOG_D(TAG, "Exiting passphrase generator, stopping background entropy collection");
     
+    // A bulk run writes credentials in the background; stop it before wiping
+    flipper_rng_passphrase_stop_bulk(app->diceware_view);
+    
     // Securely wipe passphrase from memory when leaving view
     with_view_model(
         app->diceware_view,
         FlipperRngPassphraseModel* model,
         {
             secure_wipe(model->passphrase, sizeof(model->passphrase));
+            // Cached words are pieces of the passphrases generated here
+            flipper_rng_passphrase_sd_wipe_cache(model->sd_context);
         },
         false
     );
@@ -554,6 +720,9 @@ View* flipper_rng_passphrase_view_alloc(FlipperRngApp* app) {
             model->sd_available = false;
             model->is_loading = false;
             model->index_worker_thread = NULL;
+            model->bulk_thread = NULL;
+            model->bulk_context = NULL;
+            model->is_bulk_running = false;
         },
         true
     );
@@ -563,6 +732,8 @@ View* flipper_rng_passphrase_view_alloc(FlipperRngApp* app) {
 
 // Free diceware view
 void flipper_rng_passphrase_view_free(View* view) {
+    flipper_rng_passphrase_stop_bulk(view);
+    
     // Securely wipe and free SD context
     with_view_model(
         view,
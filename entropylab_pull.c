@@ -0,0 +1,126 @@
+#include "entropylab_pull.h"
+#include "entropylab_secure.h"
+#include <string.h>
+
+size_t flipper_rng_pull_encode_request(uint8_t* frame, uint16_t seq, uint8_t command, uint16_t count) {
+    uint8_t* payload = &frame[FLIPPER_RNG_FRAME_HEADER_SIZE];
+    payload[0] = command;
+    payload[1] = (uint8_t)count;
+    payload[2] = (uint8_t)(count >> 8);
+    return flipper_rng_frame_encode(frame, seq, 0, FLIPPER_RNG_PULL_REQUEST_PAYLOAD);
+}
+
+void flipper_rng_pull_server_init(FlipperRngPullServer* server) {
+    memset(server, 0, sizeof(FlipperRngPullServer));
+    flipper_rng_frame_decoder_init(&server->decoder);
+}
+
+static void pull_server_request(const FlipperRngFrame* frame, void* context) {
+    FlipperRngPullServer* server = context;
+    uint16_t count = 0;
+    bool valid = frame->length == FLIPPER_RNG_PULL_REQUEST_PAYLOAD &&
+                 frame->payload[0] == FlipperRngPullCommandRead;
+    if(valid) count = (uint16_t)(frame->payload[1] | (frame->payload[2] << 8));
+
+    if(!valid || count == 0) {
+        server->rejected_requests++;
+        if(server->rejected < UINT8_MAX) server->rejected++;
+        return;
+    }
+    server->requests++;
+    server->owed += count;
+}
+
+void flipper_rng_pull_server_receive(FlipperRngPullServer* server, const uint8_t* data, size_t length) {
+    flipper_rng_frame_decoder_feed(&server->decoder, data, length, pull_server_request, server);
+}
+
+size_t flipper_rng_pull_server_fill(
+    FlipperRngPullServer* server,
+    const uint8_t* data,
+    size_t length,
+    uint8_t flags) {
+    size_t space = flipper_rng_pull_server_space(server);
+    if(length > space) length = space;
+    if(length == 0) return 0;
+
+    // Extend the newest run if the flags match or there is no slot for a new one
+    FlipperRngPullSegment* last =
+        server->segment_count ?
+            &server->segments[(server->segment_head + server->segment_count - 1) % FLIPPER_RNG_PULL_SEGMENTS] :
+            NULL;
+    if(last && (last->flags == flags || server->segment_count == FLIPPER_RNG_PULL_SEGMENTS)) {
+        last->length += (uint16_t)length;
+        last->flags |= flags;
+    } else {
+        FlipperRngPullSegment* next =
+            &server->segments[(server->segment_head + server->segment_count) % FLIPPER_RNG_PULL_SEGMENTS];
+        next->length = (uint16_t)length;
+        next->flags = flags;
+        server->segment_count++;
+    }
+
+    size_t tail = (server->reservoir_head + server->reservoir_fill) % FLIPPER_RNG_PULL_RESERVOIR;
+    size_t first = FLIPPER_RNG_PULL_RESERVOIR - tail;
+    if(first > length) first = length;
+    memcpy(&server->reservoir[tail], data, first);
+    memcpy(server->reservoir, &data[first], length - first);
+    server->reservoir_fill += length;
+    return length;
+}
+
+// Consume length bytes' worth of runs from the front, returns their flags ORed
+static uint8_t pull_server_take_flags(FlipperRngPullServer* server, size_t length) {
+    uint8_t flags = 0;
+    while(length > 0 && server->segment_count > 0) {
+        FlipperRngPullSegment* segment = &server->segments[server->segment_head];
+        flags |= segment->flags;
+        if(segment->length > length) {
+            segment->length -= (uint16_t)length;
+            break;
+        }
+        length -= segment->length;
+        server->segment_head = (server->segment_head + 1) % FLIPPER_RNG_PULL_SEGMENTS;
+        server->segment_count--;
+    }
+    return flags;
+}
+
+// Move length bytes from the front of the reservoir to out, wiping them behind
+static void pull_server_take(FlipperRngPullServer* server, uint8_t* out, size_t length) {
+    size_t first = FLIPPER_RNG_PULL_RESERVOIR - server->reservoir_head;
+    if(first > length) first = length;
+    memcpy(out, &server->reservoir[server->reservoir_head], first);
+    secure_wipe(&server->reservoir[server->reservoir_head], first);
+    memcpy(&out[first], server->reservoir, length - first);
+    secure_wipe(server->reservoir, length - first);
+
+    server->reservoir_head = (server->reservoir_head + length) % FLIPPER_RNG_PULL_RESERVOIR;
+    server->reservoir_fill -= length;
+}
+
+uint32_t flipper_rng_pull_server_serve(FlipperRngPullServer* server, FlipperRngPullSend send, void* context) {
+    while(server->rejected > 0) {
+        size_t size = flipper_rng_frame_encode(server->frame, server->seq++, FlipperRngFrameFlagRejected, 0);
+        send(server->frame, size, context);
+        server->rejected--;
+    }
+
+    uint32_t served = 0;
+    while(server->owed > 0) {
+        uint16_t length = server->owed < FLIPPER_RNG_FRAME_PAYLOAD ? (uint16_t)server->owed :
+                                                                    FLIPPER_RNG_FRAME_PAYLOAD;
+        if(server->reservoir_fill < length) break;
+
+        uint8_t flags = pull_server_take_flags(server, length);
+        pull_server_take(server, &server->frame[FLIPPER_RNG_FRAME_HEADER_SIZE], length);
+        size_t size = flipper_rng_frame_encode(server->frame, server->seq++, flags, length);
+        send(server->frame, size, context);
+        secure_wipe(server->frame, size);
+
+        server->owed -= length;
+        served += length;
+    }
+    server->bytes_served += served;
+    return served;
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+/**
+ * Pull-mode UART protocol
+ * Instead of streaming continuously, the device keeps a reservoir of random
+ * bytes topped up and only transmits what the host asks for. Both directions
+ * use entropylab_frame.h frames:
+ *
+ *   request   seq = host request counter, payload [command u8][count u16 LE]
+ *   response  count bytes in frames of up to FLIPPER_RNG_FRAME_PAYLOAD, numbered
+ *             by the device's own frame counter, health flags as in push mode
+ *
+ * Requests queue: the device owes the sum of every count it has received and
+ * sends it as bytes become available. A malformed request gets one empty frame
+ * flagged FlipperRngFrameFlagRejected.
+ */
+
+#include "entropylab_frame.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define FLIPPER_RNG_PULL_RESERVOIR 4096  // Bytes kept ready between requests
+#define FLIPPER_RNG_PULL_SEGMENTS 32     // Runs of reservoir bytes with their own health flags
+#define FLIPPER_RNG_PULL_REQUEST_PAYLOAD 3
+#define FLIPPER_RNG_PULL_REQUEST_SIZE \
+    (FLIPPER_RNG_FRAME_HEADER_SIZE + FLIPPER_RNG_PULL_REQUEST_PAYLOAD + FLIPPER_RNG_FRAME_CRC_SIZE)
+#define FLIPPER_RNG_PULL_RX_SIZE 256  // Must be a power of two
+#define FLIPPER_RNG_PULL_RX_MASK (FLIPPER_RNG_PULL_RX_SIZE - 1)
+
+typedef enum {
+    FlipperRngPullCommandRead = 0x01,  // Send count random bytes
+} FlipperRngPullCommand;
+
+// Host side: build a request frame in frame (FLIPPER_RNG_PULL_REQUEST_SIZE bytes), returns its size
+size_t flipper_rng_pull_encode_request(uint8_t* frame, uint16_t seq, uint8_t command, uint16_t count);
+
+// Received UART bytes, pushed from the RX interrupt and popped by the worker
+// Same single-producer/single-consumer rules as FlipperRngSampleRing
+typedef struct {
+    uint8_t bytes[FLIPPER_RNG_PULL_RX_SIZE];
+    atomic_uint head;
+    atomic_uint tail;
+    atomic_uint dropped;
+} FlipperRngPullRx;
+
+static inline void flipper_rng_pull_rx_init(FlipperRngPullRx* rx) {
+    atomic_init(&rx->head, 0);
+    atomic_init(&rx->tail, 0);
+    atomic_init(&rx->dropped, 0);
+}
+
+static inline bool flipper_rng_pull_rx_push(FlipperRngPullRx* rx, uint8_t byte) {
+    unsigned head = atomic_load_explicit(&rx->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&rx->tail, memory_order_acquire);
+
+    if(head - tail >= FLIPPER_RNG_PULL_RX_SIZE) {
+        atomic_fetch_add_explicit(&rx->dropped, 1, memory_order_relaxed);
+        return false;
+    }
+    rx->bytes[head & FLIPPER_RNG_PULL_RX_MASK] = byte;
+    atomic_store_explicit(&rx->head, head + 1, memory_order_release);
+    return true;
+}
+
+// Copies up to length queued bytes to out, returns how many
+static inline size_t flipper_rng_pull_rx_pop(FlipperRngPullRx* rx, uint8_t* out, size_t length) {
+    unsigned tail = atomic_load_explicit(&rx->tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&rx->head, memory_order_acquire);
+    size_t count = 0;
+
+    while(tail != head && count < length) {
+        out[count++] = rx->bytes[tail & FLIPPER_RNG_PULL_RX_MASK];
+        tail++;
+    }
+    atomic_store_explicit(&rx->tail, tail, memory_order_release);
+    return count;
+}
+
+// Send one encoded frame
+typedef void (*FlipperRngPullSend)(const uint8_t* frame, size_t size, void* context);
+
+// Consecutive reservoir bytes filled under the same health flags
+typedef struct {
+    uint16_t length;
+    uint8_t flags;
+} FlipperRngPullSegment;
+
+typedef struct {
+    FlipperRngFrameDecoder decoder;  // Incoming requests
+    uint8_t frame[FLIPPER_RNG_FRAME_MAX_SIZE];
+
+    // Reservoir, a circular buffer of extracted bytes
+    uint8_t reservoir[FLIPPER_RNG_PULL_RESERVOIR];
+    size_t reservoir_head;  // Oldest byte
+    size_t reservoir_fill;
+
+    // The reservoir's bytes as runs, oldest first; when every slot is taken a fill
+    // joins the newest run and ORs in its flags, so flags are never lost
+    FlipperRngPullSegment segments[FLIPPER_RNG_PULL_SEGMENTS];
+    uint8_t segment_head;
+    uint8_t segment_count;
+
+    uint32_t owed;      // Requested bytes not yet sent
+    uint16_t seq;       // Next response frame
+    uint8_t rejected;   // Empty rejection frames still to send
+
+    // Statistics
+    uint32_t requests;
+    uint32_t bytes_served;
+    uint32_t rejected_requests;
+} FlipperRngPullServer;
+
+void flipper_rng_pull_server_init(FlipperRngPullServer* server);
+
+// Decode requests out of received bytes
+void flipper_rng_pull_server_receive(FlipperRngPullServer* server, const uint8_t* data, size_t length);
+
+static inline size_t flipper_rng_pull_server_space(const FlipperRngPullServer* server) {
+    return FLIPPER_RNG_PULL_RESERVOIR - server->reservoir_fill;
+}
+
+// Nothing owed and the reservoir is full: the worker can sleep until the next request
+static inline bool flipper_rng_pull_server_idle(const FlipperRngPullServer* server) {
+    return server->owed == 0 && server->rejected == 0 && server->reservoir_fill == FLIPPER_RNG_PULL_RESERVOIR;
+}
+
+// Append extracted bytes with the health flags raised while they were made, returns how many fit
+size_t flipper_rng_pull_server_fill(
+    FlipperRngPullServer* server,
+    const uint8_t* data,
+    size_t length,
+    uint8_t flags);
+
+// Send what is owed, in full frames unless the tail of a request is shorter;
+// each frame carries the flags of every run its bytes came from. Returns the payload bytes sent
+uint32_t flipper_rng_pull_server_serve(FlipperRngPullServer* server, FlipperRngPullSend send, void* context);
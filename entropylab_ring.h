@@ -0,0 +1,89 @@
+#pragma once
+
+/**
+ * Lock-free single-producer/single-consumer sample ring
+ * Entropy producers (IR worker callback, SubGHz sweep, TRNG reads) push raw
+ * samples without blocking; the generator worker drains every ring in one
+ * batch under state->mutex. head is only written by the producer and tail
+ * only by the consumer, so acquire/release ordering is all that's needed.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define FLIPPER_RNG_RING_SIZE 64  // Must be a power of two
+#define FLIPPER_RNG_RING_MASK (FLIPPER_RNG_RING_SIZE - 1)
+
+typedef struct {
+    uint32_t sample;
+    uint8_t bits;    // Credited entropy bits, same meaning as flipper_rng_add_entropy()
+    uint8_t source;  // FlipperRngSourceId, for flipper_rng_add_entropy_batch()
+} FlipperRngSample;
+
+typedef struct {
+    FlipperRngSample slots[FLIPPER_RNG_RING_SIZE];
+    atomic_uint head;     // Next slot to write (producer)
+    atomic_uint tail;     // Next slot to read (consumer)
+    atomic_uint dropped;  // Samples rejected because the ring was full (producer)
+} FlipperRngSampleRing;
+
+static inline void flipper_rng_ring_init(FlipperRngSampleRing* ring) {
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->dropped, 0);
+}
+
+// Producer side: never blocks, returns false (and counts a drop) when full
+static inline bool
+    flipper_rng_ring_push(FlipperRngSampleRing* ring, uint32_t sample, uint8_t bits, uint8_t source) {
+    unsigned head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if(head - tail >= FLIPPER_RNG_RING_SIZE) {
+        atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+        return false;
+    }
+
+    FlipperRngSample* slot = &ring->slots[head & FLIPPER_RNG_RING_MASK];
+    slot->sample = sample;
+    slot->bits = bits;
+    slot->source = source;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return true;
+}
+
+// Producer side: queue count samples as one unit, published together so the consumer
+// never sees part of them; when they don't all fit none are queued and all count as dropped
+static inline bool
+    flipper_rng_ring_push_batch(FlipperRngSampleRing* ring, const FlipperRngSample* samples, unsigned count) {
+    unsigned head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if(count > FLIPPER_RNG_RING_SIZE - (head - tail)) {
+        atomic_fetch_add_explicit(&ring->dropped, count, memory_order_relaxed);
+        return false;
+    }
+
+    for(unsigned i = 0; i < count; i++) {
+        ring->slots[(head + i) & FLIPPER_RNG_RING_MASK] = samples[i];
+    }
+    atomic_store_explicit(&ring->head, head + count, memory_order_release);
+    return true;
+}
+
+// Consumer side: returns false when empty
+static inline bool flipper_rng_ring_pop(FlipperRngSampleRing* ring, FlipperRngSample* out) {
+    unsigned tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    if(tail == head) return false;
+
+    *out = ring->slots[tail & FLIPPER_RNG_RING_MASK];
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+static inline uint32_t flipper_rng_ring_dropped(FlipperRngSampleRing* ring) {
+    return atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Securely wipe sensitive data from memory
+// Uses a volatile pointer so the compiler cannot elide the stores as dead writes
+static inline void secure_wipe(void* data, size_t length) {
+    if(!data) return;
+    
+    volatile uint8_t* ptr = (volatile uint8_t*)data;
+    while(length--) {
+        *ptr++ = 0;
+    }
+}
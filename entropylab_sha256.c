@@ -0,0 +1,136 @@
+/**
+ * Portable software SHA-256 (FIPS 180-4)
+ * Straightforward 64-round compression with a 16-word rolling schedule.
+ */
+
+#include "entropylab_sha256.h"
+#include "entropylab_secure.h"
+#include <string.h>
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static const uint32_t sha256_h0[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+static inline uint32_t sha256_rotr(uint32_t x, unsigned n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+void flipper_rng_sha256_initial_state(uint32_t state[8]) {
+    memcpy(state, sha256_h0, sizeof(sha256_h0));
+}
+
+void flipper_rng_sha256_compress(uint32_t state[8], const uint8_t block[FLIPPER_RNG_SHA256_BLOCK_SIZE]) {
+    uint32_t w[16];
+    for(size_t i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)block[i * 4] << 24) | ((uint32_t)block[i * 4 + 1] << 16) |
+               ((uint32_t)block[i * 4 + 2] << 8) | block[i * 4 + 3];
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for(size_t i = 0; i < 64; i++) {
+        if(i >= 16) {
+            uint32_t w15 = w[(i - 15) & 15];
+            uint32_t w2 = w[(i - 2) & 15];
+            uint32_t s0 = sha256_rotr(w15, 7) ^ sha256_rotr(w15, 18) ^ (w15 >> 3);
+            uint32_t s1 = sha256_rotr(w2, 17) ^ sha256_rotr(w2, 19) ^ (w2 >> 10);
+            w[i & 15] += s0 + w[(i - 7) & 15] + s1;
+        }
+
+        uint32_t t1 = h + (sha256_rotr(e, 6) ^ sha256_rotr(e, 11) ^ sha256_rotr(e, 25)) + ((e & f) ^ (~e & g)) +
+                      sha256_k[i] + w[i & 15];
+        uint32_t t2 = (sha256_rotr(a, 2) ^ sha256_rotr(a, 13) ^ sha256_rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+    secure_wipe(w, sizeof(w));
+}
+
+void flipper_rng_sha256_init(FlipperRngSha256* ctx) {
+    flipper_rng_sha256_initial_state(ctx->state);
+    ctx->length = 0;
+    ctx->buffer_len = 0;
+}
+
+void flipper_rng_sha256_update(FlipperRngSha256* ctx, const uint8_t* data, size_t length) {
+    ctx->length += length;
+
+    if(ctx->buffer_len > 0) {
+        size_t take = FLIPPER_RNG_SHA256_BLOCK_SIZE - ctx->buffer_len;
+        if(take > length) take = length;
+        memcpy(&ctx->buffer[ctx->buffer_len], data, take);
+        ctx->buffer_len += take;
+        data += take;
+        length -= take;
+        if(ctx->buffer_len < FLIPPER_RNG_SHA256_BLOCK_SIZE) return;
+        flipper_rng_sha256_compress(ctx->state, ctx->buffer);
+        ctx->buffer_len = 0;
+    }
+
+    for(; length >= FLIPPER_RNG_SHA256_BLOCK_SIZE; length -= FLIPPER_RNG_SHA256_BLOCK_SIZE) {
+        flipper_rng_sha256_compress(ctx->state, data);
+        data += FLIPPER_RNG_SHA256_BLOCK_SIZE;
+    }
+
+    memcpy(ctx->buffer, data, length);
+    ctx->buffer_len = length;
+}
+
+void flipper_rng_sha256_final(FlipperRngSha256* ctx, uint8_t digest[FLIPPER_RNG_SHA256_DIGEST_SIZE]) {
+    uint64_t bit_length = ctx->length * 8;
+
+    // 0x80, zeros up to 56 mod 64, then the big-endian bit length
+    ctx->buffer[ctx->buffer_len++] = 0x80;
+    if(ctx->buffer_len > FLIPPER_RNG_SHA256_BLOCK_SIZE - 8) {
+        memset(&ctx->buffer[ctx->buffer_len], 0, FLIPPER_RNG_SHA256_BLOCK_SIZE - ctx->buffer_len);
+        flipper_rng_sha256_compress(ctx->state, ctx->buffer);
+        ctx->buffer_len = 0;
+    }
+    memset(&ctx->buffer[ctx->buffer_len], 0, FLIPPER_RNG_SHA256_BLOCK_SIZE - 8 - ctx->buffer_len);
+    for(size_t i = 0; i < 8; i++) {
+        ctx->buffer[FLIPPER_RNG_SHA256_BLOCK_SIZE - 1 - i] = (uint8_t)(bit_length >> (i * 8));
+    }
+    flipper_rng_sha256_compress(ctx->state, ctx->buffer);
+
+    for(size_t i = 0; i < 8; i++) {
+        digest[i * 4] = (uint8_t)(ctx->state[i] >> 24);
+        digest[i * 4 + 1] = (uint8_t)(ctx->state[i] >> 16);
+        digest[i * 4 + 2] = (uint8_t)(ctx->state[i] >> 8);
+        digest[i * 4 + 3] = (uint8_t)ctx->state[i];
+    }
+    secure_wipe(ctx, sizeof(FlipperRngSha256));
+}
+
+void flipper_rng_sha256(const uint8_t* data, size_t length, uint8_t digest[FLIPPER_RNG_SHA256_DIGEST_SIZE]) {
+    FlipperRngSha256 ctx;
+    flipper_rng_sha256_init(&ctx);
+    flipper_rng_sha256_update(&ctx, data, length);
+    flipper_rng_sha256_final(&ctx, digest);
+}
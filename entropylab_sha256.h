@@ -0,0 +1,31 @@
+#pragma once
+
+/**
+ * Portable software SHA-256 (FIPS 180-4)
+ * Used by the Fortuna accumulator, which also drives the compression function
+ * directly to chain its pools one block at a time.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define FLIPPER_RNG_SHA256_BLOCK_SIZE 64
+#define FLIPPER_RNG_SHA256_DIGEST_SIZE 32
+
+typedef struct {
+    uint32_t state[8];
+    uint64_t length;  // Bytes hashed so far
+    uint8_t buffer[FLIPPER_RNG_SHA256_BLOCK_SIZE];
+    size_t buffer_len;
+} FlipperRngSha256;
+
+void flipper_rng_sha256_init(FlipperRngSha256* ctx);
+void flipper_rng_sha256_update(FlipperRngSha256* ctx, const uint8_t* data, size_t length);
+void flipper_rng_sha256_final(FlipperRngSha256* ctx, uint8_t digest[FLIPPER_RNG_SHA256_DIGEST_SIZE]);
+void flipper_rng_sha256(const uint8_t* data, size_t length, uint8_t digest[FLIPPER_RNG_SHA256_DIGEST_SIZE]);
+
+// Initial hash value H(0)
+void flipper_rng_sha256_initial_state(uint32_t state[8]);
+
+// One compression: state = state + F(state, block), no padding or length
+void flipper_rng_sha256_compress(uint32_t state[8], const uint8_t block[FLIPPER_RNG_SHA256_BLOCK_SIZE]);
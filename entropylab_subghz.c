@@ -0,0 +1,382 @@
+#include "entropylab_subghz.h"
+#include "entropylab_entropy.h"
+#include "entropylab_hw_accel.h"
+#include <furi.h>
+#include <furi_hal.h>
+#include <furi_hal_random.h>
+#include <furi_hal_cortex.h>
+#include <furi_hal_subghz.h>
+#include <lib/subghz/devices/cc1101_configs.h>
+#include <lib/drivers/cc1101_regs.h>
+
+#define TAG "EntropyLab"
+
+#define SUBGHZ_MAX_FREQUENCIES 30
+
+// Optimized frequency set based on regional validation
+// Focus on frequencies that work globally without blocks
+static const uint32_t subghz_frequencies[] = {
+    // 300-348 MHz band (most regions allow these)
+    300000000,  // 300 MHz - Band edge
+    310000000,  // 310 MHz
+    315000000,  // 315 MHz - ISM band (US/Asia)
+    318000000,  // 318 MHz - UK SRD
+    330000000,  // 330 MHz
+    345000000,  // 345 MHz - Near band edge
+
+    // 387-464 MHz band (check region)
+    390000000,  // 390 MHz
+    410000000,  // 410 MHz
+    418000000,  // 418 MHz
+
+    // 433 MHz region - most universally accepted
+    433050000,  // 433.05 MHz - LPD433 start
+    433175000,  // 433.175 MHz - LPD433
+    433300000,  // 433.3 MHz - LPD433
+    433420000,  // 433.42 MHz - Amateur
+    433620000,  // 433.62 MHz
+    433920000,  // 433.92 MHz - ISM Global
+    434420000,  // 434.42 MHz - SRD
+    434790000,  // 434.79 MHz - LPD433 end
+
+    // 440-450 MHz (region dependent)
+    440000000,  // 440 MHz
+    446000000,  // 446 MHz - PMR446
+    450000000,  // 450 MHz
+
+    // 460-464 MHz (often blocked)
+    460000000,  // 460 MHz
+    462562500,  // 462.5625 MHz - FRS/GMRS
+    464000000,  // 464 MHz - Band edge
+
+    // 902-928 MHz ISM (Americas/AU only)
+    902000000,  // 902 MHz
+    905000000,  // 905 MHz
+    910000000,  // 910 MHz
+    915000000,  // 915 MHz - ISM center
+    920000000,  // 920 MHz
+    925000000,  // 925 MHz
+
+    // Note: Removed 784, 903, 928 MHz as they often fail
+    // Note: 868 MHz removed - EU only
+};
+
+// Sweep progress, kept between worker ticks
+typedef struct {
+    FlipperRngSubGhzSweepPhase phase;
+    uint32_t ticks_until_start;
+    bool radio_configured;  // Preset loaded, radio must be put back to sleep
+
+    uint32_t valid_frequencies[SUBGHZ_MAX_FREQUENCIES];
+    size_t valid_count;
+    uint8_t freq_offset;      // HW-random start for prime-based hopping
+    uint8_t samples_to_take;  // Frequencies to try this sweep
+    uint8_t hop;              // Frequencies tried so far
+    uint8_t bytes_pushed;
+
+    uint32_t frequency;
+    uint32_t timing_start;  // DWT at tune, timing entropy for the whole visit
+    uint64_t rx_start_ns;
+    float rssi_samples[FLIPPER_RNG_SUBGHZ_RSSI_SAMPLES];
+    uint8_t lqi_samples[FLIPPER_RNG_SUBGHZ_RSSI_SAMPLES];
+    uint8_t sample_count;
+} SubGhzSweep;
+
+// Static mutex for SubGHz access protection, held for the whole sweep
+static FuriMutex* subghz_mutex = NULL;
+static uint32_t subghz_error_count = 0;  // Track consecutive errors for recovery
+static uint32_t subghz_last_success = 0;  // Last successful collection time
+static SubGhzSweep sweep;
+
+static uint8_t subghz_timing_byte(uint32_t timing_start) {
+    return (DWT->CYCCNT - timing_start) & 0xFF;
+}
+
+// Queue one noise byte; the worker folds it into the pool with the other rings
+static void subghz_push_byte(FlipperRngState* state, uint8_t noise_byte) {
+    flipper_rng_push_sample(state, FlipperRngSourceSubGhzRSSI, noise_byte, FLIPPER_RNG_SUBGHZ_BITS_PER_BYTE);
+    sweep.bytes_pushed++;
+}
+
+// End of sweep (complete or aborted): radio back to sleep, error bookkeeping, release the mutex
+static void subghz_sweep_finish(void) {
+    if(sweep.radio_configured) {
+        // Critical section for state transitions to prevent race conditions
+        FURI_CRITICAL_ENTER();
+        furi_hal_subghz_idle();
+        furi_hal_subghz_sleep();
+        FURI_CRITICAL_EXIT();
+
+        // Don't reset here - only sleep to save power
+        // Reset should only happen on app exit or after errors
+        sweep.radio_configured = false;
+    }
+
+    // Track successful completion
+    if(sweep.bytes_pushed > 0) {
+        subghz_error_count = 0;  // Reset error counter on success
+        subghz_last_success = furi_get_tick();
+    } else {
+        subghz_error_count++;
+
+        // If we haven't had a success in a long time, force reset
+        uint32_t time_since_success = furi_get_tick() - subghz_last_success;
+        if(time_since_success > 60000) {  // 60 seconds without success
+            FURI_LOG_W(TAG, "SubGHz RSSI: No success in 60s, forcing reset");
+            furi_hal_subghz_reset();
+            subghz_error_count = 0;
+            subghz_last_success = furi_get_tick();
+        }
+    }
+
+    FURI_LOG_I(TAG, "SubGHz RSSI: Queued %u bytes (Valid:%zu, Sampled:%u, Errors:%lu)",
+              sweep.bytes_pushed, sweep.valid_count, sweep.hop, subghz_error_count);
+
+    sweep.phase = FlipperRngSubGhzSweepIdle;
+
+    // Release mutex - CRITICAL to prevent deadlock
+    furi_mutex_release(subghz_mutex);
+}
+
+// Take the radio, load the preset and pick this sweep's frequencies
+// Only register writes, no settling delays; returns false if no sweep runs
+static bool subghz_sweep_begin(FlipperRngState* state) {
+    // Create mutex on first use
+    if(!subghz_mutex) {
+        subghz_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    }
+
+    // Someone else has the radio: try again next interval instead of waiting
+    if(furi_mutex_acquire(subghz_mutex, 0) != FuriStatusOk) {
+        FURI_LOG_W(TAG, "SubGHz RSSI: Could not acquire mutex, skipping");
+        subghz_error_count++;
+        return false;
+    }
+
+    // If we've had too many consecutive errors, force a reset
+    if(subghz_error_count > 10) {
+        FURI_LOG_W(TAG, "SubGHz RSSI: Too many errors (%lu), forcing reset", subghz_error_count);
+        furi_hal_subghz_reset();
+        subghz_error_count = 0;
+    }
+
+    // CRITICAL FIX: Wrap state transitions in a critical section
+    // to prevent crashes from bad hardware states
+    FURI_CRITICAL_ENTER();
+    furi_hal_subghz_sleep();
+    furi_hal_subghz_idle();
+    FURI_CRITICAL_EXIT();
+
+    // Load optimized preset for entropy collection
+    // Using OOK 650kHz for wide bandwidth and good sensitivity
+    furi_hal_subghz_load_custom_preset(subghz_device_cc1101_preset_ook_650khz_async_regs);
+
+    // Configure for optimal RSSI readings (based on spectrum analyzer)
+    // Disable AGC freeze, set optimal gain settings
+    uint8_t agc_settings[][2] = {
+        {CC1101_AGCCTRL0, 0x91}, // Medium hysteresis, 16 samples AGC
+        {CC1101_AGCCTRL2, 0xC0}, // MAX LNA+LNA2, MAIN_TARGET 24 dB
+        {0, 0}
+    };
+    furi_hal_subghz_load_registers(agc_settings[0]);
+    furi_hal_subghz_idle();
+
+    // Check if we can successfully set a frequency (indicates SubGHz is responsive)
+    if(furi_hal_subghz_set_frequency(433920000) == 0) {
+        FURI_LOG_W(TAG, "SubGHz RSSI: Hardware not responding");
+        subghz_error_count++;
+
+        // Clean up if initialization failed - with comprehensive reset
+        furi_hal_subghz_idle();
+        furi_hal_subghz_sleep();
+
+        // If errors are piling up, do a full reset
+        if(subghz_error_count > 5) {
+            FURI_LOG_W(TAG, "SubGHz RSSI: Multiple init failures, forcing reset");
+            furi_hal_subghz_reset();
+            subghz_error_count = 0;
+        }
+
+        furi_mutex_release(subghz_mutex);
+        return false;
+    }
+    sweep.radio_configured = true;
+
+    // Pre-filter frequencies to only valid ones for this region
+    // This avoids "frequency blocked" errors
+    sweep.valid_count = 0;
+    for(size_t i = 0; i < COUNT_OF(subghz_frequencies) && sweep.valid_count < SUBGHZ_MAX_FREQUENCIES; i++) {
+        if(furi_hal_subghz_is_frequency_valid(subghz_frequencies[i])) {
+            sweep.valid_frequencies[sweep.valid_count++] = subghz_frequencies[i];
+        }
+    }
+
+    sweep.hop = 0;
+    sweep.bytes_pushed = 0;
+
+    if(sweep.valid_count == 0) {
+        FURI_LOG_W(TAG, "SubGHz: No frequencies valid in this region, using timing entropy");
+        uint32_t timing = DWT->CYCCNT ^ (DWT->CYCCNT << 16);
+        flipper_rng_push_sample(state, FlipperRngSourceSubGhzRSSI, timing, 16);
+        sweep.bytes_pushed = FLIPPER_RNG_SUBGHZ_BYTES_PER_SWEEP;
+        subghz_sweep_finish();
+        return false;
+    }
+
+    // Use hardware RNG to randomize frequency selection for unpredictability
+    sweep.freq_offset = furi_hal_random_get() & 0xFF;
+
+    // Dynamic sampling based on available frequencies
+    sweep.samples_to_take = (uint8_t)sweep.valid_count;
+    if(sweep.samples_to_take > 12) sweep.samples_to_take = 12;
+    if(sweep.samples_to_take < 6) sweep.samples_to_take = 6;
+
+    FURI_LOG_D(TAG, "SubGHz RSSI: Sweeping up to %u of %zu valid frequencies",
+              sweep.samples_to_take, sweep.valid_count);
+    return true;
+}
+
+// Set the next frequency and enter RX
+static void subghz_sweep_tune(FlipperRngState* state) {
+    // Non-consecutive frequency hopping with prime-based distribution
+    // This ensures we sample different frequencies each time
+    const uint8_t prime_hop = 7;
+    size_t freq_idx = (sweep.valid_count > 1) ? (sweep.freq_offset + (sweep.hop * prime_hop)) % sweep.valid_count : 0;
+    sweep.frequency = sweep.valid_frequencies[freq_idx];
+    sweep.hop++;
+    sweep.timing_start = DWT->CYCCNT;
+
+    // Double-check frequency validity before setting
+    if(!furi_hal_subghz_is_frequency_valid(sweep.frequency) ||
+       furi_hal_subghz_set_frequency(sweep.frequency) == 0) {
+        FURI_LOG_D(TAG, "SubGHz RSSI: Failed to set freq %lu MHz, using timing", sweep.frequency / 1000000);
+        subghz_push_byte(state, subghz_timing_byte(sweep.timing_start));
+        return;  // Stay in Tune for the next frequency
+    }
+
+    FURI_CRITICAL_ENTER();
+    furi_hal_subghz_rx();
+    FURI_CRITICAL_EXIT();
+
+    sweep.rx_start_ns = flipper_rng_hw_get_time_ns();
+    sweep.sample_count = 0;
+    sweep.phase = FlipperRngSubGhzSweepSettle;
+}
+
+// Health test one frequency's raw RSSI readings, hash those that pass with the
+// LQI samples and visit timing, and queue the digest
+static void subghz_push_conditioned(FlipperRngState* state) {
+    uint32_t timing_noise = DWT->CYCCNT - sweep.timing_start;
+    
+    // RSSI comes in 0.5 dB steps, so twice the reading is the exact raw symbol
+    uint32_t rssi_symbols[FLIPPER_RNG_SUBGHZ_RSSI_SAMPLES];
+    for(size_t i = 0; i < FLIPPER_RNG_SUBGHZ_RSSI_SAMPLES; i++) {
+        rssi_symbols[i] = (uint32_t)(int32_t)(sweep.rssi_samples[i] * 2.0f);
+    }
+    
+    // The frequency's credit, spread over its readings and scaled to those that pass
+    FlipperRngConditioner conditioner;
+    flipper_rng_conditioner_begin(&conditioner);
+    uint8_t reading_bits =
+        (FLIPPER_RNG_SUBGHZ_BITS_PER_BYTE + FLIPPER_RNG_SUBGHZ_RSSI_SAMPLES - 1) / FLIPPER_RNG_SUBGHZ_RSSI_SAMPLES;
+    size_t passed = flipper_rng_condition_raw(
+        state, FlipperRngSourceSubGhzRSSI, &conditioner, rssi_symbols, FLIPPER_RNG_SUBGHZ_RSSI_SAMPLES, reading_bits);
+    if(passed == 0) {
+        FURI_LOG_D(TAG, "SubGHz RSSI: no healthy readings at %lu MHz", sweep.frequency / 1000000);
+        return;
+    }
+    flipper_rng_conditioner_credit(
+        &conditioner, FLIPPER_RNG_SUBGHZ_BITS_PER_BYTE * passed / FLIPPER_RNG_SUBGHZ_RSSI_SAMPLES);
+    flipper_rng_conditioner_add(&conditioner, sweep.lqi_samples, sizeof(sweep.lqi_samples), 0);
+    flipper_rng_conditioner_add_word(&conditioner, timing_noise, 0);
+    flipper_rng_conditioner_add_word(&conditioner, sweep.frequency, 0);
+    flipper_rng_push_conditioned(state, FlipperRngSourceSubGhzRSSI, &conditioner);
+    sweep.bytes_pushed++;
+    
+    FURI_LOG_D(TAG, "SubGHz RSSI: Freq=%lu MHz, RSSI=%.1f dBm, LQI=%u, timing=%lu",
+              sweep.frequency / 1000000, (double)sweep.rssi_samples[0], sweep.lqi_samples[0], timing_noise);
+}
+
+// Read one RSSI/LQI sample; after the last one, queue the byte and leave RX
+static void subghz_sweep_sample(FlipperRngState* state) {
+    float rssi = furi_hal_subghz_get_rssi();
+    uint8_t lqi = furi_hal_subghz_get_lqi();
+
+    bool sample_ok = (rssi >= -130.0f && rssi <= 0.0f);
+    if(sample_ok) {
+        sweep.rssi_samples[sweep.sample_count] = rssi;
+        sweep.lqi_samples[sweep.sample_count] = lqi;
+        sweep.sample_count++;
+        if(sweep.sample_count < FLIPPER_RNG_SUBGHZ_RSSI_SAMPLES) return;
+
+        subghz_push_conditioned(state);
+    } else {
+        // Sample failed, use timing fallback
+        FURI_LOG_W(TAG, "SubGHz RSSI: Invalid RSSI value %.1f, using fallback", (double)rssi);
+        subghz_push_byte(state, subghz_timing_byte(sweep.timing_start));
+        subghz_error_count++;
+    }
+
+    // Return to idle between frequencies - with critical section
+    FURI_CRITICAL_ENTER();
+    furi_hal_subghz_idle();
+    FURI_CRITICAL_EXIT();
+    sweep.phase = FlipperRngSubGhzSweepTune;
+}
+
+FlipperRngSubGhzSweepPhase flipper_rng_subghz_sweep_step(FlipperRngState* state) {
+    if(sweep.ticks_until_start > 0) sweep.ticks_until_start--;
+
+    // Stop request or source switched off: abandon the sweep between steps
+    bool enabled = state && state->is_running && (state->entropy_sources & EntropySourceSubGhzRSSI);
+    if(!enabled) {
+        if(sweep.phase != FlipperRngSubGhzSweepIdle) subghz_sweep_finish();
+        return sweep.phase;
+    }
+
+    switch(sweep.phase) {
+    case FlipperRngSubGhzSweepIdle:
+        if(sweep.ticks_until_start > 0) break;
+        sweep.ticks_until_start = FLIPPER_RNG_SUBGHZ_SWEEP_INTERVAL;
+        if(subghz_sweep_begin(state)) {
+            sweep.phase = FlipperRngSubGhzSweepTune;
+        }
+        break;
+    case FlipperRngSubGhzSweepTune:
+        if(sweep.bytes_pushed >= FLIPPER_RNG_SUBGHZ_BYTES_PER_SWEEP || sweep.hop >= sweep.samples_to_take) {
+            subghz_sweep_finish();
+            break;
+        }
+        subghz_sweep_tune(state);
+        break;
+    case FlipperRngSubGhzSweepSettle:
+        // Spectrum analyzer uses 3ms for RSSI stabilization so the AGC has settled
+        if(flipper_rng_hw_get_time_ns() - sweep.rx_start_ns < FLIPPER_RNG_SUBGHZ_SETTLE_US * 1000ULL) break;
+        sweep.phase = FlipperRngSubGhzSweepSample;
+        subghz_sweep_sample(state);
+        break;
+    case FlipperRngSubGhzSweepSample:
+        subghz_sweep_sample(state);
+        break;
+    }
+
+    return sweep.phase;
+}
+
+void flipper_rng_subghz_sweep_deinit(void) {
+    if(sweep.phase != FlipperRngSubGhzSweepIdle) {
+        subghz_sweep_finish();
+    }
+    sweep.ticks_until_start = 0;
+
+    // Clean up SubGHz mutex if allocated
+    if(subghz_mutex) {
+        furi_mutex_free(subghz_mutex);
+        subghz_mutex = NULL;
+        FURI_LOG_I(TAG, "SubGHz mutex freed");
+    }
+}
+
+void flipper_rng_collect_subghz_rssi_entropy(FlipperRngState* state) {
+    flipper_rng_subghz_sweep_step(state);
+}
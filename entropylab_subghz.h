@@ -0,0 +1,33 @@
+#pragma once
+
+/**
+ * Non-blocking SubGHz RSSI sweep
+ * Reloading the CC1101 preset, hopping frequencies and waiting for RSSI to
+ * settle used to happen inside one call that stalled the worker for tens of
+ * milliseconds. The sweep is now a resumable state machine: each worker tick
+ * does at most one short radio operation, and each frequency's RSSI/LQI
+ * readings are conditioned and queued on the SubGHz sample ring as soon as
+ * the frequency has been sampled.
+ */
+
+#include "entropylab.h"
+
+#define FLIPPER_RNG_SUBGHZ_SWEEP_INTERVAL 50  // Worker ticks between sweep starts
+#define FLIPPER_RNG_SUBGHZ_SETTLE_US 3000     // RSSI/AGC settling time after entering RX
+#define FLIPPER_RNG_SUBGHZ_RSSI_SAMPLES 5     // RSSI/LQI reads per frequency, one per tick
+#define FLIPPER_RNG_SUBGHZ_BYTES_PER_SWEEP 4  // Frequencies hashed into a queued sample per sweep
+#define FLIPPER_RNG_SUBGHZ_BITS_PER_BYTE 4    // Credited per byte: 16 bits per sweep
+
+typedef enum {
+    FlipperRngSubGhzSweepIdle,    // Waiting for the next sweep
+    FlipperRngSubGhzSweepTune,    // Next step sets the frequency and enters RX
+    FlipperRngSubGhzSweepSettle,  // In RX, waiting out FLIPPER_RNG_SUBGHZ_SETTLE_US
+    FlipperRngSubGhzSweepSample,  // Reading one RSSI/LQI sample per step
+} FlipperRngSubGhzSweepPhase;
+
+// Advance the sweep by one step and return the phase it is now in
+// Called from the worker every tick while EntropySourceSubGhzRSSI is enabled
+FlipperRngSubGhzSweepPhase flipper_rng_subghz_sweep_step(FlipperRngState* state);
+
+// Abort a sweep in progress, put the radio to sleep and free the SubGHz mutex
+void flipper_rng_subghz_sweep_deinit(void);
@@ -0,0 +1,153 @@
+/**
+ * Double-buffered UART transmitter
+ * Buffers are handed to the TX thread strictly in turn. Two semaphores carry
+ * the hand-offs: queued counts buffers waiting to be sent, available counts
+ * buffers the producer may fill. A buffer is only touched by the side that
+ * last took it from a semaphore, so no other synchronization is needed.
+ */
+
+#include "entropylab_uart_writer.h"
+#include <furi.h>
+#include <stdatomic.h>
+#include <string.h>
+
+#define TAG "EntropyLab_UART"
+
+struct FlipperRngUartWriter {
+    FuriHalSerialHandle* handle;
+    FuriThread* thread;
+    FuriSemaphore* queued;  // Buffers handed off and not yet sent
+    FuriSemaphore* available;  // Buffers the producer may fill
+    FuriMutex* stats_mutex;
+
+    uint8_t* buffers[2];
+    size_t lengths[2];
+    size_t buffer_size;
+
+    uint8_t active;  // Producer side
+    uint8_t next;    // TX thread side
+    atomic_bool stopping;
+
+    uint32_t open_tick;
+    FlipperRngUartWriterStats stats;
+};
+
+static int32_t flipper_rng_uart_writer_thread(void* context) {
+    FlipperRngUartWriter* writer = context;
+
+    while(true) {
+        if(furi_semaphore_acquire(writer->queued, 100) != FuriStatusOk) {
+            // Only exit once every queued buffer has been sent
+            if(atomic_load_explicit(&writer->stopping, memory_order_acquire)) break;
+            continue;
+        }
+
+        uint8_t index = writer->next;
+        // Ticks, not flipper_rng_hw_get_time_ns(): its wrap state belongs to the worker thread
+        uint32_t start = furi_get_tick();
+        furi_hal_serial_tx(writer->handle, writer->buffers[index], writer->lengths[index]);
+        uint32_t took = furi_get_tick() - start;
+
+        furi_mutex_acquire(writer->stats_mutex, FuriWaitForever);
+        writer->stats.bytes_sent += writer->lengths[index];
+        writer->stats.tx_ms += took;
+        furi_mutex_release(writer->stats_mutex);
+
+        writer->next = index ^ 1;
+        furi_semaphore_release(writer->available);
+    }
+
+    return 0;
+}
+
+FlipperRngUartWriter* flipper_rng_uart_writer_open(FuriHalSerialHandle* handle, size_t buffer_size) {
+    if(!handle) return NULL;
+    FlipperRngUartWriter* writer = malloc(sizeof(FlipperRngUartWriter));
+    if(!writer) return NULL;
+    memset(writer, 0, sizeof(FlipperRngUartWriter));
+
+    writer->handle = handle;
+    writer->buffer_size = buffer_size;
+    writer->buffers[0] = malloc(buffer_size);
+    writer->buffers[1] = malloc(buffer_size);
+    if(!writer->buffers[0] || !writer->buffers[1]) {
+        FURI_LOG_E(TAG, "Failed to allocate 2 x %zu byte buffers", buffer_size);
+        free(writer->buffers[0]);
+        free(writer->buffers[1]);
+        free(writer);
+        return NULL;
+    }
+
+    atomic_init(&writer->stopping, false);
+    writer->queued = furi_semaphore_alloc(2, 0);
+    writer->available = furi_semaphore_alloc(2, 2);
+    writer->stats_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    writer->open_tick = furi_get_tick();
+
+    writer->thread = furi_thread_alloc_ex("FlipperRngUart", 1024, flipper_rng_uart_writer_thread, writer);
+    // Below the worker: the TX spin only fills time the worker spends asleep
+    furi_thread_set_priority(writer->thread, FuriThreadPriorityLow);
+    furi_thread_start(writer->thread);
+
+    FURI_LOG_I(TAG, "UART TX thread started with 2 x %zu byte buffers", buffer_size);
+    return writer;
+}
+
+void flipper_rng_uart_writer_write(FlipperRngUartWriter* writer, const uint8_t* data, size_t length) {
+    size_t offset = 0;
+
+    while(offset < length) {
+        // Both buffers on their way out: the line is the bottleneck
+        if(furi_semaphore_acquire(writer->available, 0) != FuriStatusOk) {
+            uint32_t start = furi_get_tick();
+            furi_semaphore_acquire(writer->available, FuriWaitForever);
+            uint32_t waited = furi_get_tick() - start;
+            furi_mutex_acquire(writer->stats_mutex, FuriWaitForever);
+            writer->stats.stall_ms += waited;
+            furi_mutex_release(writer->stats_mutex);
+        }
+
+        size_t chunk = MIN(length - offset, writer->buffer_size);
+        memcpy(writer->buffers[writer->active], &data[offset], chunk);
+        writer->lengths[writer->active] = chunk;
+        furi_semaphore_release(writer->queued);
+
+        writer->active ^= 1;
+        offset += chunk;
+    }
+}
+
+void flipper_rng_uart_writer_get_stats(FlipperRngUartWriter* writer, FlipperRngUartWriterStats* stats) {
+    furi_mutex_acquire(writer->stats_mutex, FuriWaitForever);
+    *stats = writer->stats;
+    furi_mutex_release(writer->stats_mutex);
+
+    stats->elapsed_ms = furi_get_tick() - writer->open_tick;
+    stats->bytes_per_sec = stats->elapsed_ms ? (uint32_t)(stats->bytes_sent * 1000 / stats->elapsed_ms) : 0;
+    uint32_t stall_percent = stats->elapsed_ms ? stats->stall_ms * 100 / stats->elapsed_ms : 0;
+    stats->stall_percent = (uint8_t)MIN(stall_percent, 100u);
+}
+
+void flipper_rng_uart_writer_close(FlipperRngUartWriter* writer) {
+    if(!writer) return;
+
+    atomic_store_explicit(&writer->stopping, true, memory_order_release);
+    furi_thread_join(writer->thread);
+    furi_thread_free(writer->thread);
+
+    FlipperRngUartWriterStats stats;
+    flipper_rng_uart_writer_get_stats(writer, &stats);
+    FURI_LOG_I(
+        TAG,
+        "Closed: %lu bytes sent, %lu B/s, %lu ms stalled",
+        (uint32_t)stats.bytes_sent,
+        stats.bytes_per_sec,
+        stats.stall_ms);
+
+    furi_semaphore_free(writer->queued);
+    furi_semaphore_free(writer->available);
+    furi_mutex_free(writer->stats_mutex);
+    free(writer->buffers[0]);
+    free(writer->buffers[1]);
+    free(writer);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+/**
+ * Double-buffered UART transmitter for OutputModeUART
+ * furi_hal_serial_tx() busy-waits on the USART until the last byte is out,
+ * so calling it from the worker stops collection for the whole chunk. The
+ * worker instead copies each chunk or frame into a free buffer and a TX
+ * thread drains it. That thread still spins on the USART, and there is only
+ * one core, so it runs below the worker's priority: it sends while the
+ * worker sleeps between polls and is preempted as soon as the worker wakes.
+ * The gain is that collection no longer waits on the line, not that the two
+ * run at once; the line idles while the worker runs. Nothing is dropped:
+ * when both buffers are still queued the worker waits, and that wait is
+ * reported as TX stall time.
+ */
+
+#include <furi_hal_serial.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define FLIPPER_RNG_UART_WRITER_BUFFER_SIZE 1024  // Per buffer, two are allocated; holds a whole frame
+
+typedef struct FlipperRngUartWriter FlipperRngUartWriter;
+
+typedef struct {
+    uint64_t bytes_sent;     // Handed to the USART
+    uint32_t tx_ms;          // Time the TX thread spent inside furi_hal_serial_tx
+    uint32_t stall_ms;       // Time the producer waited for a free buffer
+    uint32_t elapsed_ms;     // Since the writer was opened
+    uint32_t bytes_per_sec;  // Achieved rate: bytes_sent over elapsed_ms
+    uint8_t stall_percent;   // stall_ms over elapsed_ms
+} FlipperRngUartWriterStats;
+
+// Start the TX thread for an initialized serial handle, NULL on failure
+FlipperRngUartWriter* flipper_rng_uart_writer_open(FuriHalSerialHandle* handle, size_t buffer_size);
+
+// Queue data for transmission, each call going out as its own hand-off;
+// waits (counted as stall) while both buffers are on their way out
+void flipper_rng_uart_writer_write(FlipperRngUartWriter* writer, const uint8_t* data, size_t length);
+
+void flipper_rng_uart_writer_get_stats(FlipperRngUartWriter* writer, FlipperRngUartWriterStats* stats);
+
+// Send everything queued, then stop the thread
+void flipper_rng_uart_writer_close(FlipperRngUartWriter* writer);
@@ -41,6 +41,22 @@ static const char* output_mode_names[] = {
     "File",
 };
 
+static const char* uart_format_names[] = {
+    "Raw",
+    "Framed",
+    "Pull",
+};
+
+static const char* uart_baud_names[] = {
+    "115200",
+    "230400",
+    "460800",
+    "921600",
+    "1M",
+    "2M",
+    "4M",
+};
+
 static const char* poll_interval_names[] = {
     "1ms",
     "5ms", 
@@ -64,9 +80,17 @@ static const char* mix_frequency_names[] = {
     "64 (Conservative)",
 };
 
+static const char* full_mix_names[] = {
+    "Every Mix",
+    "Every 4th",
+    "Every 8th",
+    "Every 16th",
+};
+
 static const char* mixing_mode_names[] = {
     "HW AES",
     "SW XOR",
+    "Fortuna",
 };
 
 static const char* wordlist_names[] = {
@@ -83,10 +107,19 @@ static const uint32_t poll_interval_values[] = {
     1, 5, 10, 50, 100, 500,
 };
 
+// USART1 runs from 64 MHz with 16x oversampling, so 4 Mbaud is its ceiling
+static const uint32_t uart_baud_values[] = {
+    115200, 230400, 460800, 921600, 1000000, 2000000, 4000000,
+};
+
 static const uint32_t mix_frequency_values[] = {
     16, 32, 48, 64,
 };
 
+static const uint32_t full_mix_values[] = {
+    1, 4, 8, 16,
+};
+
 static const uint32_t entropy_source_values[] = {
     EntropySourceAll,                                                              // All high-quality
     EntropySourceHardwareRNG,                                                      // HW RNG only
@@ -134,6 +167,22 @@ void flipper_rng_output_mode_changed(VariableItem* item) {
     variable_item_set_current_value_text(item, output_mode_names[index]);
 }
 
+void flipper_rng_uart_format_changed(VariableItem* item) {
+    FlipperRngApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    
+    app->state->uart_format = (UartFormat)index;
+    variable_item_set_current_value_text(item, uart_format_names[index]);
+}
+
+void flipper_rng_uart_baud_changed(VariableItem* item) {
+    FlipperRngApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    
+    app->state->uart_baud = uart_baud_values[index];
+    variable_item_set_current_value_text(item, uart_baud_names[index]);
+}
+
 void flipper_rng_poll_interval_changed(VariableItem* item) {
     FlipperRngApp* app = variable_item_get_context(item);
     uint8_t index = variable_item_get_current_value_index(item);
@@ -157,11 +206,18 @@ void flipper_rng_mix_frequency_changed(VariableItem* item) {
     variable_item_set_current_value_text(item, mix_frequency_names[index]);
 }
 
+void flipper_rng_full_mix_changed(VariableItem* item) {
+    FlipperRngApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    app->state->full_mix_interval = full_mix_values[index];
+    variable_item_set_current_value_text(item, full_mix_names[index]);
+}
+
 void flipper_rng_mixing_mode_changed(VariableItem* item) {
     FlipperRngApp* app = variable_item_get_context(item);
     uint8_t index = variable_item_get_current_value_index(item);
     
-    app->state->mixing_mode = (MixingMode)index;
+    flipper_rng_set_mixing_mode(app->state, (MixingMode)index);
     variable_item_set_current_value_text(item, mixing_mode_names[index]);
     
     FURI_LOG_I(TAG, "Mixing mode changed to: %s", mixing_mode_names[index]);
@@ -222,6 +278,35 @@ void flipper_rng_setup_config_view(FlipperRngApp* app) {
     variable_item_set_current_value_index(item, app->state->output_mode);
     variable_item_set_current_value_text(item, output_mode_names[app->state->output_mode]);
     
+    // UART format (framing only applies to UART output)
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "UART Format",
+        COUNT_OF(uart_format_names),
+        flipper_rng_uart_format_changed,
+        app
+    );
+    variable_item_set_current_value_index(item, app->state->uart_format);
+    variable_item_set_current_value_text(item, uart_format_names[app->state->uart_format]);
+    
+    // UART baud rate, applied the next time the generator starts
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "UART Baud",
+        COUNT_OF(uart_baud_names),
+        flipper_rng_uart_baud_changed,
+        app
+    );
+    uint8_t baud_index = 0;
+    for(uint32_t i = 0; i < COUNT_OF(uart_baud_values); i++) {
+        if(uart_baud_values[i] == app->state->uart_baud) {
+            baud_index = i;
+            break;
+        }
+    }
+    variable_item_set_current_value_index(item, baud_index);
+    variable_item_set_current_value_text(item, uart_baud_names[baud_index]);
+    
     // Wordlist Selection (moved below Output Mode)
     item = variable_item_list_add(
         app->variable_item_list,
@@ -297,6 +382,24 @@ void flipper_rng_setup_config_view(FlipperRngApp* app) {
     }
     variable_item_set_current_value_index(item, mix_index);
     variable_item_set_current_value_text(item, mix_frequency_names[mix_index]);
+    
+    // Full-pool sweep interval (other mixes only touch dirty regions)
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Full Mix",
+        COUNT_OF(full_mix_names),
+        flipper_rng_full_mix_changed,
+        app
+    );
+    uint32_t full_mix_index = 2;  // Default to every 8th mix
+    for(uint32_t i = 0; i < COUNT_OF(full_mix_values); i++) {
+        if(full_mix_values[i] == app->state->full_mix_interval) {
+            full_mix_index = i;
+            break;
+        }
+    }
+    variable_item_set_current_value_index(item, full_mix_index);
+    variable_item_set_current_value_text(item, full_mix_names[full_mix_index]);
 }
 
 // Visualization drawing
@@ -663,6 +766,19 @@ void flipper_rng_visualization_update(FlipperRngApp* app, uint8_t* data, size_t
                 model->bits_from_hw_rng = app->state->bits_from_hw_rng;
                 model->bits_from_subghz_rssi = app->state->bits_from_subghz_rssi;
                 model->bits_from_infrared = app->state->bits_from_infrared;
+                model->file_output = (app->state->output_mode == OutputModeFile);
+                model->file_write_bps = app->state->file_write_bps;
+                model->file_bytes_failed = app->state->file_bytes_failed;
+                model->uart_output = (app->state->output_mode == OutputModeUART);
+                model->uart_tx_bps = app->state->uart_tx_bps;
+                model->uart_tx_stall_percent = app->state->uart_tx_stall_percent;
+                for(size_t i = 0; i < FlipperRngSourceCount; i++) {
+                    model->health_failures[i] = flipper_rng_health_failures(&app->state->health[i]);
+                    model->quarantined[i] = flipper_rng_health_is_quarantined(&app->state->health[i]);
+                    model->estimate_valid[i] = app->state->estimators[i].valid;
+                    model->estimate_per_sample[i] = app->state->estimators[i].per_sample;
+                    model->credited_per_sample[i] = app->state->estimators[i].credited_per_sample;
+                }
                 
                 // Set start time when generation starts
                 if(model->is_running && model->start_time_ms == 0) {
@@ -868,6 +984,19 @@ void flipper_rng_source_stats_enter_callback(void* context) {
             model->bits_from_hw_rng = app->state->bits_from_hw_rng;
             model->bits_from_subghz_rssi = app->state->bits_from_subghz_rssi;
             model->bits_from_infrared = app->state->bits_from_infrared;
+            model->file_output = (app->state->output_mode == OutputModeFile);
+            model->file_write_bps = app->state->file_write_bps;
+            model->file_bytes_failed = app->state->file_bytes_failed;
+            model->uart_output = (app->state->output_mode == OutputModeUART);
+            model->uart_tx_bps = app->state->uart_tx_bps;
+            model->uart_tx_stall_percent = app->state->uart_tx_stall_percent;
+            for(size_t i = 0; i < FlipperRngSourceCount; i++) {
+                model->health_failures[i] = flipper_rng_health_failures(&app->state->health[i]);
+                model->quarantined[i] = flipper_rng_health_is_quarantined(&app->state->health[i]);
+                model->estimate_valid[i] = app->state->estimators[i].valid;
+                model->estimate_per_sample[i] = app->state->estimators[i].per_sample;
+                model->credited_per_sample[i] = app->state->estimators[i].credited_per_sample;
+            }
             
             // Set start time when generation starts
             if(model->is_running && model->start_time_ms == 0) {
@@ -899,6 +1028,56 @@ void flipper_rng_source_stats_enter_callback(void* context) {
     );
 }
 
+// Right-aligned health marker on a source line: "QUAR" while quarantined, "!n" after n failures
+static void flipper_rng_source_stats_draw_health(
+    Canvas* canvas,
+    const FlipperRngVisualizationModel* model,
+    FlipperRngSourceId source,
+    int y) {
+    char marker[16];
+    if(model->quarantined[source]) {
+        snprintf(marker, sizeof(marker), "QUAR");
+    } else if(model->health_failures[source]) {
+        snprintf(marker, sizeof(marker), "!%lu", model->health_failures[source]);
+    } else {
+        return;
+    }
+    
+    // Clear behind the marker in case the count runs long
+    uint16_t width = canvas_string_width(canvas, marker);
+    canvas_set_color(canvas, ColorWhite);
+    canvas_draw_box(canvas, 126 - width - 1, y - 8, width + 2, 9);
+    canvas_set_color(canvas, ColorBlack);
+    canvas_draw_str_aligned(canvas, 126, y, AlignRight, AlignBottom, marker);
+}
+
+// Min-entropy mode: estimated vs credited bits per sample, bar shows the ratio
+static void flipper_rng_source_stats_draw_estimates(Canvas* canvas, const FlipperRngVisualizationModel* model) {
+    static const char* const labels[FlipperRngSourceCount] = {"HW", "RF", "IR"};
+    char buffer[48];
+    int y = 18;
+    
+    for(size_t i = 0; i < FlipperRngSourceCount; i++) {
+        if(model->estimate_valid[i]) {
+            snprintf(buffer, sizeof(buffer), "%s: %.1f of %.0f bits/smp", labels[i],
+                     (double)model->estimate_per_sample[i], (double)model->credited_per_sample[i]);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%s: collecting...", labels[i]);
+        }
+        canvas_draw_str(canvas, 2, y, buffer);
+        flipper_rng_source_stats_draw_health(canvas, model, (FlipperRngSourceId)i, y);
+        
+        canvas_draw_frame(canvas, 2, y + 1, 124, 4);
+        if(model->estimate_valid[i] && model->credited_per_sample[i] > 0.0f) {
+            float ratio = model->estimate_per_sample[i] / model->credited_per_sample[i];
+            if(ratio > 1.0f) ratio = 1.0f;
+            int fill_width = (int)(122 * ratio);
+            if(fill_width > 0) canvas_draw_box(canvas, 3, y + 2, fill_width, 2);
+        }
+        y += 14;
+    }
+}
+
 void flipper_rng_source_stats_draw_callback(Canvas* canvas, void* context) {
     FlipperRngVisualizationModel* model = context;
     
@@ -906,7 +1085,8 @@ void flipper_rng_source_stats_draw_callback(Canvas* canvas, void* context) {
     canvas_set_font(canvas, FontPrimary);
     
     // Show mode in title
-    const char* title = model->show_bits_per_sec ? "Entropy Rate" : "Entropy Total";
+    const char* title = model->show_min_entropy ? "Min-Entropy" :
+                        model->show_bits_per_sec ? "Entropy Rate" : "Entropy Total";
     canvas_draw_str(canvas, 2, 10, title);
     
     if(!model->is_running) {
@@ -918,8 +1098,29 @@ void flipper_rng_source_stats_draw_callback(Canvas* canvas, void* context) {
     
     canvas_set_font(canvas, FontSecondary);
     
-    // Show toggle hint at bottom
-    canvas_draw_str_aligned(canvas, 64, 63, AlignCenter, AlignBottom, "[OK] Toggle Mode");
+    // Show toggle hint at bottom, with the SD or UART rate while sending output
+    if(model->file_output) {
+        char sd_line[32];
+        // ERR: the card came up short on a write (full or failing)
+        snprintf(sd_line, sizeof(sd_line), "SD %lu.%02lu MB/s%s [OK]",
+                 model->file_write_bps / 1000000, (model->file_write_bps / 10000) % 100,
+                 model->file_bytes_failed ? " ERR" : "");
+        canvas_draw_str_aligned(canvas, 64, 63, AlignCenter, AlignBottom, sd_line);
+    } else if(model->uart_output) {
+        // A high stall share means the line, not generation, is the limit
+        char uart_line[32];
+        snprintf(uart_line, sizeof(uart_line), "TX %lu.%luKB/s stall %u%%",
+                 model->uart_tx_bps / 1000, (model->uart_tx_bps / 100) % 10,
+                 model->uart_tx_stall_percent);
+        canvas_draw_str_aligned(canvas, 64, 63, AlignCenter, AlignBottom, uart_line);
+    } else {
+        canvas_draw_str_aligned(canvas, 64, 63, AlignCenter, AlignBottom, "[OK] Toggle Mode");
+    }
+    
+    if(model->show_min_entropy) {
+        flipper_rng_source_stats_draw_estimates(canvas, model);
+        return;
+    }
     
     // Use cached display values from the model
     // These are only updated when the model itself updates
@@ -945,6 +1146,7 @@ void flipper_rng_source_stats_draw_callback(Canvas* canvas, void* context) {
     snprintf(buffer, sizeof(buffer), "HW: %lu %s (%lu%%)", 
              model->hw_display_value, unit, hw_percent);
     canvas_draw_str(canvas, 2, y, buffer);
+    flipper_rng_source_stats_draw_health(canvas, model, FlipperRngSourceHardwareRNG, y);
     
     // Draw progress bar below text
     int bar_y = y + 1;
@@ -961,6 +1163,7 @@ void flipper_rng_source_stats_draw_callback(Canvas* canvas, void* context) {
     snprintf(buffer, sizeof(buffer), "RF: %lu %s (%lu%%)", 
              model->rf_display_value, unit, rf_percent);
     canvas_draw_str(canvas, 2, y, buffer);
+    flipper_rng_source_stats_draw_health(canvas, model, FlipperRngSourceSubGhzRSSI, y);
     
     bar_y = y + 1;
     canvas_draw_frame(canvas, bar_x, bar_y, bar_width, bar_height);
@@ -976,6 +1179,7 @@ void flipper_rng_source_stats_draw_callback(Canvas* canvas, void* context) {
     snprintf(buffer, sizeof(buffer), "IR: %lu %s (%lu%%)", 
              model->ir_display_value, unit, ir_percent);
     canvas_draw_str(canvas, 2, y, buffer);
+    flipper_rng_source_stats_draw_health(canvas, model, FlipperRngSourceInfrared, y);
     
     bar_y = y + 1;
     canvas_draw_frame(canvas, bar_x, bar_y, bar_width, bar_height);
@@ -994,8 +1198,15 @@ bool flipper_rng_source_stats_input_callback(InputEvent* event, void* context) {
             app->source_stats_view,
             FlipperRngVisualizationModel* model,
             {
-                // Toggle between total bits and bits/sec display
-                model->show_bits_per_sec = !model->show_bits_per_sec;
+                // Cycle total bits -> bits/sec -> min-entropy estimates
+                if(model->show_min_entropy) {
+                    model->show_min_entropy = false;
+                    model->show_bits_per_sec = false;
+                } else if(model->show_bits_per_sec) {
+                    model->show_min_entropy = true;
+                } else {
+                    model->show_bits_per_sec = true;
+                }
                 
                 // Recalculate display values for the new mode
                 if(model->show_bits_per_sec && model->is_running) {
@@ -25,6 +25,22 @@ typedef struct {
     uint32_t hw_display_value;
     uint32_t rf_display_value;
     uint32_t ir_display_value;
+    // SD writer throughput, shown while capturing to file
+    bool file_output;
+    uint32_t file_write_bps;
+    uint32_t file_bytes_failed;
+    // UART TX throughput and time the worker waited on the line
+    bool uart_output;
+    uint32_t uart_tx_bps;
+    uint8_t uart_tx_stall_percent;
+    // Health test failures and quarantine per FlipperRngSourceId
+    uint32_t health_failures[FlipperRngSourceCount];
+    bool quarantined[FlipperRngSourceCount];
+    // Online min-entropy estimate against the credited bits, per sample
+    bool show_min_entropy;  // Third display mode, after total and rate
+    bool estimate_valid[FlipperRngSourceCount];
+    float estimate_per_sample[FlipperRngSourceCount];
+    float credited_per_sample[FlipperRngSourceCount];
 } FlipperRngVisualizationModel;
 
 // Configuration callbacks
@@ -36,6 +52,12 @@ void flipper_rng_source_changed(VariableItem* item);
 // Output mode callback  
 void flipper_rng_output_mode_changed(VariableItem* item);
 
+// UART format callback
+void flipper_rng_uart_format_changed(VariableItem* item);
+
+// UART baud rate callback
+void flipper_rng_uart_baud_changed(VariableItem* item);
+
 // Poll interval callback
 void flipper_rng_poll_interval_changed(VariableItem* item);
 
@@ -45,6 +67,9 @@ void flipper_rng_visual_refresh_changed(VariableItem* item);
 // Mixing mode callback
 void flipper_rng_mixing_mode_changed(VariableItem* item);
 
+// Full mix interval callback
+void flipper_rng_full_mix_changed(VariableItem* item);
+
 // Wordlist selection callback
 void flipper_rng_wordlist_changed(VariableItem* item);
 
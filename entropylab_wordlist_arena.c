@@ -0,0 +1,141 @@
+#include "entropylab_wordlist_arena.h"
+#include <furi.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAG "EntropyLab_Arena"
+
+#define ARENA_LENGTH_BITS 4
+#define ARENA_LETTER_BITS 5
+
+// 0 is unused so a zeroed tail never decodes as a letter
+static uint8_t arena_letter_code(char letter) {
+    if(letter >= 'a' && letter <= 'z') return (uint8_t)(letter - 'a' + 1);
+    if(letter == '-') return 27;
+    return 0;
+}
+
+static char arena_letter(uint8_t code) {
+    return code == 27 ? '-' : (char)('a' + code - 1);
+}
+
+// Values never exceed 5 bits, so one write touches at most two bytes
+static void arena_put_bits(FlipperRngWordArena* arena, uint32_t value, uint8_t bits) {
+    if(arena->data) {
+        uint32_t byte = arena->bit_pos >> 3;
+        uint8_t shift = arena->bit_pos & 7;
+        arena->data[byte] |= (uint8_t)(value << shift);
+        arena->data[byte + 1] |= (uint8_t)(value >> (8 - shift));
+    }
+    arena->bit_pos += bits;
+}
+
+static uint32_t arena_get_bits(const uint8_t* data, uint32_t* bit_pos, uint8_t bits) {
+    uint32_t byte = *bit_pos >> 3;
+    uint32_t window = data[byte] | ((uint32_t)data[byte + 1] << 8);
+    uint32_t value = (window >> (*bit_pos & 7)) & ((1u << bits) - 1);
+    *bit_pos += bits;
+    return value;
+}
+
+void flipper_rng_word_arena_init(FlipperRngWordArena* arena) {
+    memset(arena, 0, sizeof(FlipperRngWordArena));
+}
+
+bool flipper_rng_word_arena_append(FlipperRngWordArena* arena, const char* word) {
+    size_t length = strlen(word);
+    if(length == 0 || length > FLIPPER_RNG_ARENA_MAX_WORD) return false;
+    for(size_t i = 0; i < length; i++) {
+        if(!arena_letter_code(word[i])) return false;
+    }
+
+    size_t prefix = 0;
+    uint32_t bit_pos = arena->bit_pos;
+    if(arena->word_count % FLIPPER_RNG_ARENA_BLOCK_WORDS == 0) {
+        bit_pos = (bit_pos + 7) & ~7u;
+    } else {
+        while(prefix < length && arena->previous[prefix] == word[prefix]) prefix++;
+    }
+
+    // The encoding pass must not outgrow what the sizing pass measured
+    uint32_t bits = 2 * ARENA_LENGTH_BITS + (length - prefix) * ARENA_LETTER_BITS;
+    if(arena->capacity &&
+       (arena->word_count >= arena->capacity || bit_pos + bits > arena->data_size * 8)) {
+        return false;
+    }
+
+    arena->bit_pos = bit_pos;
+    if(arena->data && arena->word_count % FLIPPER_RNG_ARENA_BLOCK_WORDS == 0) {
+        arena->block_offsets[arena->word_count / FLIPPER_RNG_ARENA_BLOCK_WORDS] = bit_pos >> 3;
+    }
+
+    arena_put_bits(arena, prefix, ARENA_LENGTH_BITS);
+    arena_put_bits(arena, length - prefix, ARENA_LENGTH_BITS);
+    for(size_t i = prefix; i < length; i++) {
+        arena_put_bits(arena, arena_letter_code(word[i]), ARENA_LETTER_BITS);
+    }
+
+    memcpy(arena->previous, word, length + 1);
+    arena->word_count++;
+    return true;
+}
+
+bool flipper_rng_word_arena_allocate(FlipperRngWordArena* arena) {
+    uint16_t word_count = arena->word_count;
+    uint16_t blocks = (word_count + FLIPPER_RNG_ARENA_BLOCK_WORDS - 1) / FLIPPER_RNG_ARENA_BLOCK_WORDS;
+    uint32_t data_size = (arena->bit_pos + 7) >> 3;
+    if(word_count == 0) return false;
+
+    // One spare byte lets every read and write touch two bytes
+    uint8_t* data = calloc(data_size + 1, 1);
+    uint32_t* block_offsets = malloc(blocks * sizeof(uint32_t));
+    if(!data || !block_offsets) {
+        FURI_LOG_E(TAG, "Failed to allocate %lu bytes for %u words", data_size, word_count);
+        free(data);
+        free(block_offsets);
+        return false;
+    }
+
+    flipper_rng_word_arena_init(arena);
+    arena->data = data;
+    arena->block_offsets = block_offsets;
+    arena->data_size = data_size;
+    arena->capacity = word_count;
+    return true;
+}
+
+bool flipper_rng_word_arena_is_ready(const FlipperRngWordArena* arena) {
+    return arena->data && arena->word_count == arena->capacity;
+}
+
+bool flipper_rng_word_arena_get(const FlipperRngWordArena* arena, uint16_t index, char* out, size_t out_size) {
+    if(!flipper_rng_word_arena_is_ready(arena) || index >= arena->word_count || out_size <= FLIPPER_RNG_ARENA_MAX_WORD) {
+        return false;
+    }
+
+    uint32_t bit_pos = arena->block_offsets[index / FLIPPER_RNG_ARENA_BLOCK_WORDS] << 3;
+    size_t length = 0;
+    for(uint16_t i = 0; i <= index % FLIPPER_RNG_ARENA_BLOCK_WORDS; i++) {
+        size_t prefix = arena_get_bits(arena->data, &bit_pos, ARENA_LENGTH_BITS);
+        size_t suffix = arena_get_bits(arena->data, &bit_pos, ARENA_LENGTH_BITS);
+        length = MIN(prefix, length);
+        for(size_t j = 0; j < suffix && length < FLIPPER_RNG_ARENA_MAX_WORD; j++) {
+            out[length++] = arena_letter((uint8_t)arena_get_bits(arena->data, &bit_pos, ARENA_LETTER_BITS));
+        }
+    }
+
+    out[length] = '\0';
+    return true;
+}
+
+size_t flipper_rng_word_arena_memory(const FlipperRngWordArena* arena) {
+    if(!arena->data) return 0;
+    size_t blocks = (arena->capacity + FLIPPER_RNG_ARENA_BLOCK_WORDS - 1) / FLIPPER_RNG_ARENA_BLOCK_WORDS;
+    return arena->data_size + 1 + blocks * sizeof(uint32_t);
+}
+
+void flipper_rng_word_arena_free(FlipperRngWordArena* arena) {
+    free(arena->data);
+    free(arena->block_offsets);
+    flipper_rng_word_arena_init(arena);
+}
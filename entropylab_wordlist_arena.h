@@ -0,0 +1,53 @@
+#pragma once
+
+/**
+ * Front-coded in-RAM wordlist arena
+ * Words are stored in order, FLIPPER_RNG_ARENA_BLOCK_WORDS per block. Each
+ * word is a 4-bit length of the prefix it shares with the previous word, a
+ * 4-bit suffix length and the suffix in 5-bit letter codes, packed LSB first.
+ * Blocks start on a byte boundary with a full word and are found through a
+ * sparse index of byte offsets, so a lookup decodes at most one block.
+ *
+ * Building is two passes over the same words: append everything with no
+ * storage to size the arena, flipper_rng_word_arena_allocate(), then append
+ * everything again to encode it.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define FLIPPER_RNG_ARENA_BLOCK_WORDS 16
+#define FLIPPER_RNG_ARENA_MAX_WORD 15  // Longest word the 4-bit lengths can describe
+
+typedef struct {
+    uint8_t* data;             // NULL during the sizing pass
+    uint32_t* block_offsets;   // Byte offset of each block in data
+    uint32_t data_size;        // Bytes, excluding the one byte of read padding
+    uint16_t word_count;       // Words appended so far
+    uint16_t capacity;         // Words counted by the sizing pass, 0 while sizing
+
+    // Encoder position
+    uint32_t bit_pos;
+    char previous[FLIPPER_RNG_ARENA_MAX_WORD + 1];
+} FlipperRngWordArena;
+
+// Start an empty sizing pass
+void flipper_rng_word_arena_init(FlipperRngWordArena* arena);
+
+// Add the next word, false if it is too long or uses letters other than a-z and '-'
+bool flipper_rng_word_arena_append(FlipperRngWordArena* arena, const char* word);
+
+// End the sizing pass: allocate for the words seen so far and rewind for encoding
+bool flipper_rng_word_arena_allocate(FlipperRngWordArena* arena);
+
+// True once allocated and every sized word has been encoded
+bool flipper_rng_word_arena_is_ready(const FlipperRngWordArena* arena);
+
+// Decode word index into out (at least FLIPPER_RNG_ARENA_MAX_WORD + 1 bytes)
+bool flipper_rng_word_arena_get(const FlipperRngWordArena* arena, uint16_t index, char* out, size_t out_size);
+
+// Heap used by an allocated arena, data plus block index
+size_t flipper_rng_word_arena_memory(const FlipperRngWordArena* arena);
+
+void flipper_rng_word_arena_free(FlipperRngWordArena* arena);
@@ -2,6 +2,12 @@
 #include "entropylab_entropy.h"
 #include "entropylab_views.h"
 #include "entropylab_hw_accel.h"
+#include "entropylab_file_writer.h"
+#include "entropylab_uart_writer.h"
+#include "entropylab_frame.h"
+#include "entropylab_pull.h"
+#include "entropylab_subghz.h"
+#include "entropylab_secure.h"
 #include <furi_hal_random.h>
 #include <furi_hal_serial.h>
 #include <storage/storage.h>
@@ -11,6 +17,60 @@
 
 #define TAG "EntropyLab"
 #define OUTPUT_BUFFER_SIZE 256  // Reduced to save stack space and prevent overflow
+#define OUTPUT_FILE_PATH "/ext/flipper_rng.bin"
+#define PULL_IDLE_WAIT_MS 50  // Longest sleep between requests, bounds the stop latency
+
+// Pull mode: the RX interrupt queues request bytes and wakes the worker
+typedef struct {
+    FlipperRngPullRx rx;
+    FuriSemaphore* ready;
+} FlipperRngWorkerPullRx;
+
+static void flipper_rng_worker_pull_rx_callback(FuriHalSerialHandle* handle, FuriHalSerialRxEvent event, void* context) {
+    FlipperRngWorkerPullRx* pull_rx = context;
+    if(event & FuriHalSerialRxEventData) {
+        while(furi_hal_serial_async_rx_available(handle)) {
+            flipper_rng_pull_rx_push(&pull_rx->rx, furi_hal_serial_async_rx(handle));
+        }
+        furi_semaphore_release(pull_rx->ready);
+    }
+}
+
+// Encoded frame to the UART TX thread, context is the UART writer
+static void flipper_rng_worker_uart_send(const uint8_t* frame, size_t size, void* context) {
+    flipper_rng_uart_writer_write(context, frame, size);
+}
+
+// Health events since the last call, as FlipperRngFrameFlag bits
+// Health state and ring counters are only written by this thread
+static uint8_t flipper_rng_worker_frame_flags(FlipperRngState* state, uint32_t* failures, uint32_t* dropped) {
+    uint8_t flags = 0;
+    uint32_t total_failures = 0;
+    for(size_t i = 0; i < FlipperRngSourceCount; i++) {
+        total_failures += flipper_rng_health_failures(&state->health[i]);
+        if(flipper_rng_health_is_quarantined(&state->health[i])) flags |= FlipperRngFrameFlagQuarantined;
+    }
+    if(total_failures != *failures) flags |= FlipperRngFrameFlagHealthFailed;
+    *failures = total_failures;
+    
+    uint32_t total_dropped = flipper_rng_samples_dropped(state);
+    if(total_dropped != *dropped) flags |= FlipperRngFrameFlagSamplesDropped;
+    *dropped = total_dropped;
+    return flags;
+}
+
+static void flipper_rng_worker_send_frame(
+    FlipperRngUartWriter* uart_writer, uint8_t* frame, uint16_t seq, uint8_t flags, uint16_t length) {
+    size_t size = flipper_rng_frame_encode(frame, seq, flags, length);
+    flipper_rng_worker_uart_send(frame, size, uart_writer);
+}
+
+static void flipper_rng_worker_update_uart_stats(FlipperRngState* state, FlipperRngUartWriter* uart_writer) {
+    FlipperRngUartWriterStats uart_stats;
+    flipper_rng_uart_writer_get_stats(uart_writer, &uart_stats);
+    state->uart_tx_bps = uart_stats.bytes_per_sec;
+    state->uart_tx_stall_percent = uart_stats.stall_percent;
+}
 
 // Worker thread - Multi-source entropy collection with always-on visualization
 int32_t flipper_rng_worker_thread(void* context) {
@@ -31,30 +91,103 @@ int32_t flipper_rng_worker_thread(void* context) {
     // Mark as used to avoid warning
     UNUSED(output_buffer);
     
+    // TRNG batch, heap-allocated to keep it off the 4KB worker stack
+    FlipperRngSample* hw_batch = malloc(RNG_HW_BATCH_WORDS * sizeof(FlipperRngSample));
+    uint32_t* hw_words = malloc(RNG_HW_BATCH_WORDS * sizeof(uint32_t));
+    furi_check(hw_batch && hw_words);
+    
+    // File output stays open for the whole run, opened on the first flush
+    FlipperRngFileWriter* file_writer = NULL;
+    FlipperRngFileWriterStats file_stats;
+    app->state->file_write_bps = 0;
+    app->state->file_bytes_failed = 0;
+    
+    // UART output drains on its own thread so collection continues while a chunk is on the wire
+    FlipperRngUartWriter* uart_writer = NULL;
+    app->state->uart_tx_bps = 0;
+    app->state->uart_tx_stall_percent = 0;
+    if(app->state->output_mode == OutputModeUART && app->state->serial_handle) {
+        // The configured rate, whoever set the port up
+        furi_hal_serial_set_br(app->state->serial_handle, app->state->uart_baud);
+        uart_writer = flipper_rng_uart_writer_open(app->state->serial_handle, FLIPPER_RNG_UART_WRITER_BUFFER_SIZE);
+    }
+    
+    // Framed UART output collects FLIPPER_RNG_FRAME_PAYLOAD bytes per frame,
+    // flagged with any health event seen while they were generated
+    bool framed = app->state->output_mode == OutputModeUART && app->state->uart_format == UartFormatFramed;
+    uint8_t* frame = framed ? malloc(FLIPPER_RNG_FRAME_MAX_SIZE) : NULL;
+    furi_check(!framed || frame);
+    uint16_t frame_len = 0;
+    uint16_t frame_seq = 0;
+    uint8_t frame_flags = 0;
+    uint32_t frame_failures = 0;
+    uint32_t frame_dropped = 0;
+    
+    // Pull mode keeps a reservoir full and otherwise sleeps until the host asks for bytes
+    bool pull = uart_writer && app->state->uart_format == UartFormatPull;
+    FlipperRngPullServer* pull_server = NULL;
+    FlipperRngWorkerPullRx* pull_rx = NULL;
+    bool pull_parked = false;
+    if(pull) {
+        pull_server = malloc(sizeof(FlipperRngPullServer));
+        pull_rx = malloc(sizeof(FlipperRngWorkerPullRx));
+        furi_check(pull_server && pull_rx);
+        flipper_rng_pull_server_init(pull_server);
+        flipper_rng_pull_rx_init(&pull_rx->rx);
+        pull_rx->ready = furi_semaphore_alloc(1, 0);
+        furi_hal_serial_async_rx_start(
+            app->state->serial_handle, flipper_rng_worker_pull_rx_callback, pull_rx, false);
+        FURI_LOG_I(TAG, "Pull mode, %d byte reservoir", FLIPPER_RNG_PULL_RESERVOIR);
+    }
+    if(framed || pull) flipper_rng_worker_frame_flags(app->state, &frame_failures, &frame_dropped);
+    
     uint32_t counter = 0;
     uint32_t mix_counter = 0;
     uint32_t total_entropy_bits = 0;
     
     // Record start time for rate calculation and entropy readiness
+    // Readiness comes from credit: every run starts from none
     app->state->start_time = furi_get_tick();
     app->state->entropy_collection_start = furi_get_tick();
-    app->state->entropy_ready = false;  // Not ready yet
-    
-    // Minimum entropy collection time: 2 seconds
-    // This ensures we have environmental entropy from SubGHz and IR sources
-    const uint32_t MIN_ENTROPY_COLLECTION_MS = 2000;
+    furi_mutex_acquire(app->state->mutex, FuriWaitForever);
+    app->state->entropy_credit = 0;
+    app->state->entropy_ready = false;
+    furi_mutex_release(app->state->mutex);
+    bool ready_logged = false;
     
     FURI_LOG_I(TAG, "Worker entering main loop, is_running=%d", app->state->is_running);
-    FURI_LOG_I(TAG, "Entropy will be ready for passphrases after %lu ms", MIN_ENTROPY_COLLECTION_MS);
+    FURI_LOG_I(TAG, "Entropy will be ready for passphrases at %d credited bits", RNG_CREDIT_READY_BITS);
     
     while(app->state->is_running) {
-        // Check if minimum entropy collection time has elapsed
-        if(!app->state->entropy_ready) {
-            uint32_t collection_time = furi_get_tick() - app->state->entropy_collection_start;
-            if(collection_time >= MIN_ENTROPY_COLLECTION_MS) {
-                app->state->entropy_ready = true;
-                FURI_LOG_I(TAG, "Entropy ready! Collected for %lu ms, passphrases can now be generated", collection_time);
+        if(pull) {
+            // Take in new requests and answer them from the reservoir
+            uint8_t request_bytes[32];
+            size_t received;
+            while((received = flipper_rng_pull_rx_pop(&pull_rx->rx, request_bytes, sizeof(request_bytes))) > 0) {
+                flipper_rng_pull_server_receive(pull_server, request_bytes, received);
+            }
+            flipper_rng_pull_server_serve(pull_server, flipper_rng_worker_uart_send, uart_writer);
+            
+            // Nothing owed and nothing to top up: no collection, mixing or visualization until woken
+            if(flipper_rng_pull_server_idle(pull_server)) {
+                if(!pull_parked) {
+                    // A sweep left mid-way would keep the CC1101 in RX and hold the SubGHz mutex
+                    flipper_rng_subghz_sweep_deinit();
+                    pull_parked = true;
+                }
+                // The IR worker keeps queueing; drain its ring so nothing overflows while parked
+                flipper_rng_drain_samples(app->state);
+                frame_flags |= flipper_rng_worker_frame_flags(app->state, &frame_failures, &frame_dropped);
+                furi_semaphore_acquire(pull_rx->ready, PULL_IDLE_WAIT_MS);
+                continue;
             }
+            pull_parked = false;
+        }
+        
+        if(!ready_logged && app->state->entropy_ready) {
+            ready_logged = true;
+            FURI_LOG_I(TAG, "Entropy ready after %lu ms, passphrases can now be generated",
+                       furi_get_tick() - app->state->entropy_collection_start);
         }
         
         // Log periodically
@@ -73,27 +206,29 @@ int32_t flipper_rng_worker_thread(void* context) {
         uint32_t entropy_bits = 0;
         
         // Hardware RNG - HIGHEST QUALITY (32 bits per sample)
+        // Pulled as one batch of words and folded with a single mutex round-trip
         if(app->state->entropy_sources & EntropySourceHardwareRNG) {
-            uint32_t hw_random = furi_hal_random_get();
-            flipper_rng_add_entropy(app->state, hw_random, 32);
-            entropy_bits += 32;
-            app->state->bits_from_hw_rng += 32;
-        }
-        
-        // SubGHz RSSI - ENHANCED HIGH QUALITY RF noise (16 bits per sample)
-        // Sample less frequently to avoid blocking (every 50 iterations = 50ms at 1ms poll)
-        if((app->state->entropy_sources & EntropySourceSubGhzRSSI) && (counter % 50 == 0)) {
-            // Pass state to allow early exit on stop
-            flipper_rng_collect_subghz_rssi_entropy(app->state);
-            // Only count bits if we're still running
-            if(app->state->is_running) {
-                entropy_bits += 16;
-                app->state->bits_from_subghz_rssi += 16;
+            furi_hal_random_fill_buf((uint8_t*)hw_words, RNG_HW_BATCH_WORDS * sizeof(uint32_t));
+            for(size_t i = 0; i < RNG_HW_BATCH_WORDS; i++) {
+                hw_batch[i].sample = hw_words[i];
+                hw_batch[i].bits = 32;
+                hw_batch[i].source = FlipperRngSourceHardwareRNG;
             }
+            entropy_bits += flipper_rng_add_entropy_batch(app->state, hw_batch, RNG_HW_BATCH_WORDS);
         }
         
-        // Infrared is now handled by persistent worker via callbacks
-        // No need to poll here anymore - entropy is added continuously
+        // SubGHz RSSI - ENHANCED HIGH QUALITY RF noise (16 bits per sweep)
+        // One non-blocking sweep step per iteration; a sweep starts every 50 iterations
+        // and queues each RSSI byte on the SubGHz ring as it is sampled.
+        // Also called with the source disabled so a running sweep can release the radio
+        flipper_rng_collect_subghz_rssi_entropy(app->state);
+        
+        // Infrared is handled by the persistent worker, whose callback queues samples
+        
+        // Fold everything queued by the other producers into the pool under one lock
+        // Per-source bit counters are credited here as samples actually land in the pool
+        entropy_bits += flipper_rng_drain_samples(app->state);
+        if(framed || pull) frame_flags |= flipper_rng_worker_frame_flags(app->state, &frame_failures, &frame_dropped);
         
         
         // Mix the entropy pool periodically using configurable frequency
@@ -107,8 +242,20 @@ int32_t flipper_rng_worker_thread(void* context) {
         // Generate more bytes per iteration for better throughput
         int bytes_to_generate = 32; // Increased from 16 to 32 for better throughput
         int bytes_available = OUTPUT_BUFFER_SIZE - buffer_pos;
+        if(pull) {
+            int reservoir_space = (int)flipper_rng_pull_server_space(pull_server) - (int)buffer_pos;
+            if(reservoir_space < bytes_available) bytes_available = reservoir_space;
+        }
         int bytes_to_extract = (bytes_to_generate < bytes_available) ? bytes_to_generate : bytes_available;
         
+        // Every extraction spends credit; streaming never waits for it and leaves
+        // the ready reserve and anything a passphrase or bulk run is waiting on.
+        // The debit also fails until entropy_ready's conditions hold, so nothing
+        // streams in Fortuna mode before the first reseed from the pools.
+        if(bytes_to_extract > 0 && !flipper_rng_debit_entropy_wait(app->state, bytes_to_extract * 8, 0, NULL)) {
+            bytes_to_extract = 0;
+        }
+        
         if(bytes_to_extract > 0) {
             // Batch extract all bytes in one call - MUCH faster
             flipper_rng_extract_random_bytes(app->state, &output_buffer[buffer_pos], bytes_to_extract);
@@ -133,7 +280,8 @@ int32_t flipper_rng_worker_thread(void* context) {
         } else if(app->state->output_mode == OutputModeUART) {
             // For UART, send larger chunks less frequently (every 128 bytes)
             // This reduces overhead while maintaining good latency
-            should_output = (buffer_pos >= 128);
+            // Pull mode moves every extracted byte straight into the reservoir
+            should_output = pull ? (buffer_pos > 0) : (buffer_pos >= 128);
         } else {
             // For File mode, wait for full buffer
             should_output = (buffer_pos >= OUTPUT_BUFFER_SIZE);
@@ -149,33 +297,44 @@ int32_t flipper_rng_worker_thread(void* context) {
                            app->state->bytes_generated);
             } else if(app->state->output_mode == OutputModeUART) {
                 // Send to GPIO UART (pins 13/14) using DMA optimization
-                if(app->state->serial_handle) {
-                    // Try DMA-based transmission first for better performance
-                    if(!flipper_rng_hw_uart_tx_dma(app->state->serial_handle, (uint8_t*)output_buffer, buffer_pos)) {
-                        // Fallback to optimized bulk transmission
-                        flipper_rng_hw_uart_tx_bulk(app->state->serial_handle, (uint8_t*)output_buffer, buffer_pos);
+                if(pull) {
+                    // The flags raised since the last fill go with these bytes, whenever they are served
+                    flipper_rng_pull_server_fill(pull_server, output_buffer, buffer_pos, frame_flags);
+                    frame_flags = 0;
+                    flipper_rng_pull_server_serve(pull_server, flipper_rng_worker_uart_send, uart_writer);
+                } else if(uart_writer && framed) {
+                    // Fill the frame payload, sending each frame as it completes
+                    for(size_t offset = 0; offset < buffer_pos;) {
+                        size_t take = FLIPPER_RNG_FRAME_PAYLOAD - frame_len;
+                        if(take > buffer_pos - offset) take = buffer_pos - offset;
+                        memcpy(&frame[FLIPPER_RNG_FRAME_HEADER_SIZE + frame_len], &output_buffer[offset], take);
+                        frame_len += take;
+                        offset += take;
+                        if(frame_len == FLIPPER_RNG_FRAME_PAYLOAD) {
+                            flipper_rng_worker_send_frame(uart_writer, frame, frame_seq++, frame_flags, frame_len);
+                            FURI_LOG_D(TAG, "Sent UART frame %u, flags 0x%02X", frame_seq - 1, frame_flags);
+                            frame_len = 0;
+                            frame_flags = 0;
+                        }
                     }
-                    FURI_LOG_D(TAG, "Sent %zu bytes to UART (DMA-optimized)", buffer_pos);
+                } else if(uart_writer) {
+                    // Queue for the TX thread; only waits when both buffers are still draining
+                    flipper_rng_uart_writer_write(uart_writer, output_buffer, buffer_pos);
+                    FURI_LOG_D(TAG, "Queued %zu bytes for UART", buffer_pos);
                 } else {
                     FURI_LOG_W(TAG, "UART not initialized");
                 }
             } else if(app->state->output_mode == OutputModeFile) {
-                // Save to SD card file
-                Storage* storage = furi_record_open(RECORD_STORAGE);
-                File* file = storage_file_alloc(storage);
-                
-                // Append to file (create if doesn't exist)
-                if(storage_file_open(file, "/ext/flipper_rng.bin", 
-                                    FSAM_WRITE, FSOM_OPEN_APPEND)) {
-                    size_t written = storage_file_write(file, (const void*)output_buffer, buffer_pos);
-                    storage_file_close(file);
-                    FURI_LOG_I(TAG, "Wrote %zu bytes to /ext/flipper_rng.bin", written);
+                // Hand off to the SD writer thread; the card is written in large aligned chunks
+                // These bytes already spent their credit, so wait for a buffer rather than drop them
+                if(!file_writer) {
+                    file_writer = flipper_rng_file_writer_open(OUTPUT_FILE_PATH, FLIPPER_RNG_FILE_WRITER_BUFFER_SIZE);
+                }
+                if(file_writer) {
+                    flipper_rng_file_writer_write_wait(file_writer, output_buffer, buffer_pos);
                 } else {
                     FURI_LOG_W(TAG, "Failed to open file for writing");
                 }
-                
-                storage_file_free(file);
-                furi_record_close(RECORD_STORAGE);
             }
             
             buffer_pos = 0;
@@ -190,6 +349,13 @@ int32_t flipper_rng_worker_thread(void* context) {
         // Update quality metric based on actual entropy pool
         if(counter % 100 == 0) {
             flipper_rng_update_quality_metric(app->state);
+            
+            if(file_writer) {
+                flipper_rng_file_writer_get_stats(file_writer, &file_stats);
+                app->state->file_write_bps = file_stats.bytes_per_sec;
+                app->state->file_bytes_failed = (uint32_t)file_stats.bytes_failed;
+            }
+            if(uart_writer) flipper_rng_worker_update_uart_stats(app->state, uart_writer);
         }
         
         // Calculate active source count
@@ -224,7 +390,8 @@ int32_t flipper_rng_worker_thread(void* context) {
             
             // No overrides - respect user's visual refresh rate setting completely
             
-            if(should_update) {
+            // The display's bytes are output too: skip this refresh when there is no credit for them
+            if(should_update && flipper_rng_debit_entropy_wait(app->state, 128 * 8, 0, NULL)) {
                 // Generate fresh random data for visualization
                 uint8_t vis_buffer[128];
                 for(int i = 0; i < 128; i++) {
@@ -260,6 +427,34 @@ int32_t flipper_rng_worker_thread(void* context) {
         }
     }
     
+    free(hw_batch);
+    free(hw_words);
+    
+    // A short last frame keeps the tail of the run
+    if(frame && frame_len > 0 && uart_writer) {
+        flipper_rng_worker_send_frame(uart_writer, frame, frame_seq, frame_flags, frame_len);
+    }
+    free(frame);
+    
+    if(pull) {
+        furi_hal_serial_async_rx_stop(app->state->serial_handle);
+        FURI_LOG_I(TAG, "Pull mode served %lu requests, %lu bytes, %lu rejected",
+                   pull_server->requests, pull_server->bytes_served, pull_server->rejected_requests);
+        furi_semaphore_free(pull_rx->ready);
+        secure_wipe(pull_server, sizeof(FlipperRngPullServer));
+        free(pull_server);
+        free(pull_rx);
+    }
+    
+    // Flush whatever is still buffered and close the capture file
+    flipper_rng_file_writer_close(file_writer);
+    
+    // Keep the run's UART figures on screen, then let queued output drain
+    if(uart_writer) {
+        flipper_rng_worker_update_uart_stats(app->state, uart_writer);
+        flipper_rng_uart_writer_close(uart_writer);
+    }
+    
     // Clean up entropy sources before exiting
     flipper_rng_deinit_entropy_sources(app->state);
     
@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""
+Reference decoder for Entropy Lab framed UART output (UART Format: Framed)
+
+Frame layout, all fields little-endian (see entropylab_frame.h):
+    magic "EL" | seq u16 | length u16 | flags u8 | payload | CRC-32 u32
+The CRC is zlib.crc32 over everything before it.
+
+Reads a serial device, a capture file or stdin ('-'), writes the payload of
+every good frame and reports lost, corrupted and flagged frames on stderr.
+"""
+
+import argparse
+import os
+import stat
+import struct
+import sys
+import zlib
+
+MAGIC = b"EL"
+HEADER = struct.Struct("<2sHHB")
+HEADER_SIZE = HEADER.size
+CRC_SIZE = 4
+MAX_PAYLOAD = 512
+
+FLAG_HEALTH_FAILED = 1 << 0
+FLAG_QUARANTINED = 1 << 1
+FLAG_SAMPLES_DROPPED = 1 << 2
+FLAG_REJECTED = 1 << 3  # Pull mode: the request was not understood
+FLAGS_UNHEALTHY = FLAG_HEALTH_FAILED | FLAG_QUARANTINED
+
+FLAG_NAMES = {
+    FLAG_HEALTH_FAILED: "health-failed",
+    FLAG_QUARANTINED: "quarantined",
+    FLAG_SAMPLES_DROPPED: "samples-dropped",
+    FLAG_REJECTED: "rejected",
+}
+
+
+def encode_frame(seq, flags, payload):
+    """One frame as the device sends it"""
+    body = HEADER.pack(MAGIC, seq & 0xFFFF, len(payload), flags) + payload
+    return body + struct.pack("<I", zlib.crc32(body))
+
+
+def describe_flags(flags):
+    names = [name for bit, name in FLAG_NAMES.items() if flags & bit]
+    return ",".join(names) if names else "none"
+
+
+class Frame:
+    def __init__(self, seq, flags, payload, lost):
+        self.seq = seq
+        self.flags = flags
+        self.payload = payload
+        self.lost = lost  # Frames missing before this one
+
+    @property
+    def healthy(self):
+        return not (self.flags & FLAGS_UNHEALTHY)
+
+
+class FrameDecoder:
+    """Streaming decoder: feed() bytes as they arrive, get complete frames back"""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.expected_seq = None
+        self.frames = 0
+        self.payload_bytes = 0
+        self.lost_frames = 0
+        self.crc_errors = 0
+        self.discarded_bytes = 0
+        self.flagged_frames = 0
+
+    def feed(self, data):
+        self.buffer.extend(data)
+        frames = []
+        while self.buffer:
+            start = self.buffer.find(MAGIC)
+            if start < 0:
+                # Keep a trailing 'E' that may start the next magic
+                keep = 1 if self.buffer[-1:] == MAGIC[:1] else 0
+                self._discard(len(self.buffer) - keep)
+                break
+            if start > 0:
+                self._discard(start)
+            if len(self.buffer) < HEADER_SIZE:
+                break
+
+            _, seq, length, flags = HEADER.unpack_from(self.buffer)
+            if length > MAX_PAYLOAD:
+                self._discard(1)
+                continue
+            size = HEADER_SIZE + length + CRC_SIZE
+            if len(self.buffer) < size:
+                break
+
+            (crc,) = struct.unpack_from("<I", self.buffer, HEADER_SIZE + length)
+            if crc != zlib.crc32(self.buffer[:HEADER_SIZE + length]):
+                # Drop one byte and look for a frame starting inside this one
+                self.crc_errors += 1
+                self._discard(1)
+                continue
+
+            lost = 0 if self.expected_seq is None else (seq - self.expected_seq) & 0xFFFF
+            self.expected_seq = (seq + 1) & 0xFFFF
+            payload = bytes(self.buffer[HEADER_SIZE:HEADER_SIZE + length])
+            del self.buffer[:size]
+
+            self.frames += 1
+            self.payload_bytes += length
+            self.lost_frames += lost
+            if flags:
+                self.flagged_frames += 1
+            frames.append(Frame(seq, flags, payload, lost))
+        return frames
+
+    def _discard(self, count):
+        self.discarded_bytes += count
+        del self.buffer[:count]
+
+    def summary(self):
+        return (f"{self.frames} frames, {self.payload_bytes} payload bytes, "
+                f"{self.lost_frames} lost, {self.crc_errors} CRC errors, "
+                f"{self.discarded_bytes} bytes discarded, {self.flagged_frames} flagged")
+
+
+def open_input(path, baud):
+    """Serial devices are opened with pyserial, anything else as a plain file"""
+    if path == "-":
+        return sys.stdin.buffer
+    if stat.S_ISCHR(os.stat(path).st_mode):
+        import serial
+        return serial.Serial(path, baud, timeout=1)
+    return open(path, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode Entropy Lab framed UART output")
+    parser.add_argument("input", help="serial device, capture file, or - for stdin")
+    parser.add_argument("-o", "--output", help="write payload here (default stdout)")
+    parser.add_argument("-b", "--baud", type=int, default=115200, help="serial baud rate")
+    parser.add_argument("-n", "--bytes", type=int, default=0, help="stop after this many payload bytes")
+    parser.add_argument("--strict", action="store_true",
+                        help="drop frames produced while a source failed its health tests")
+    args = parser.parse_args()
+
+    source = open_input(args.input, args.baud)
+    output = open(args.output, "wb") if args.output else sys.stdout.buffer
+    decoder = FrameDecoder()
+    written = 0
+    skipped = 0
+
+    try:
+        while not args.bytes or written < args.bytes:
+            chunk = source.read(4096)
+            if not chunk:
+                # End of file; a serial read timing out just means no data yet
+                if hasattr(source, "in_waiting"):
+                    continue
+                break
+            for frame in decoder.feed(chunk):
+                if frame.lost:
+                    print(f"lost {frame.lost} frame(s) before seq {frame.seq}", file=sys.stderr)
+                if frame.flags:
+                    print(f"seq {frame.seq}: {describe_flags(frame.flags)}", file=sys.stderr)
+                if args.strict and not frame.healthy:
+                    skipped += 1
+                    continue
+                output.write(frame.payload)
+                written += len(frame.payload)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        output.flush()
+        if output is not sys.stdout.buffer:
+            output.close()
+        if source is not sys.stdin.buffer:
+            source.close()
+
+    print(f"{decoder.summary()}, {skipped} skipped", file=sys.stderr)
+    return 1 if decoder.crc_errors or decoder.lost_frames else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
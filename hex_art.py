@@ -24,16 +24,24 @@ def get_terminal_size():
     except:
         return 24, 80  # Default fallback
 
-def hex_art_monitor(port="/dev/ttyUSB0", baudrate=115200):
+def hex_art_monitor(port="/dev/ttyUSB0", baudrate=115200, socket_path=None):
     """Simple hex art visualization"""
     
     term_rows, term_cols = get_terminal_size()
     
     print(f"🔢 Entropy Lab Hex Monitor")
-    print(f"📡 Connecting to {port} at {baudrate} baud...")
+    if socket_path:
+        print(f"📡 Connecting to entropy server at {socket_path}...")
+    else:
+        print(f"📡 Connecting to {port} at {baudrate} baud...")
     
     try:
-        ser = serial.Serial(port, baudrate, timeout=2)
+        if socket_path:
+            # Shares the device with other tools through entropy_server.py
+            from entropy_server import EntropyClient
+            ser = EntropyClient(socket_path)
+        else:
+            ser = serial.Serial(port, baudrate, timeout=2)
         print(f"✅ Connected! Monitoring hex stream...")
         print(f"🎮 Press Ctrl+C to stop")
         time.sleep(2)
@@ -125,6 +133,7 @@ if __name__ == "__main__":
     parser = argparse.ArgumentParser(description="Entropy Lab Hex Monitor")
     parser.add_argument("--port", default="/dev/ttyUSB0", help="UART port")
     parser.add_argument("--baud", type=int, default=115200, help="Baud rate")
+    parser.add_argument("--socket", help="read from entropy_server.py at this socket instead of the UART")
     
     args = parser.parse_args()
     
@@ -134,4 +143,4 @@ if __name__ == "__main__":
     print("Smooth cursor-based updates")
     print("=" * 40)
     
-    sys.exit(hex_art_monitor(args.port, args.baud))
+    sys.exit(hex_art_monitor(args.port, args.baud, args.socket))
@@ -0,0 +1,90 @@
+/**
+ * Host harness for the Entropy Lab core
+ */
+
+#include "entropylab_host.h"
+#include "entropylab_entropy.h"
+#include "entropylab_hw_accel.h"
+
+#define TAG "EntropyLabHost"
+
+FlipperRngApp* entropylab_host_app_alloc(void) {
+    FlipperRngApp* app = calloc(1, sizeof(FlipperRngApp));
+    furi_check(app);
+
+    app->state = calloc(1, sizeof(FlipperRngState));
+    furi_check(app->state);
+
+    // Same defaults as flipper_rng_app_alloc()
+    FlipperRngState* state = app->state;
+    state->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    state->entropy_sources = EntropySourceAll;
+    state->output_mode = OutputModeNone;
+    state->uart_format = UartFormatRaw;
+    state->uart_baud = 115200;
+    state->mixing_mode = MixingModeHardware;
+    state->wordlist_type = PassphraseListEFFLong;
+    state->poll_interval_ms = 1;
+    state->visual_refresh_ms = 500;
+    state->mix_frequency = 32;
+    state->mix_counter = 0;
+    state->full_mix_interval = RNG_FULL_MIX_INTERVAL_DEFAULT;
+    state->mixes_since_full = 0;
+    state->dirty_regions = RNG_POOL_ALL_REGIONS;  // Initial fill touches the whole pool
+    state->is_running = false;
+    state->entropy_ready = false;
+    state->entropy_credit = 0;
+    state->entropy_claimed = 0;
+    state->entropy_pool_pos = 0;
+    state->bytes_generated = 0;
+    flipper_rng_init_sample_rings(state);
+    flipper_rng_init_health(state);
+    flipper_rng_init_estimators(state);
+
+    flipper_rng_hw_accel_init();
+
+    furi_hal_random_fill_buf(state->entropy_pool, RNG_POOL_SIZE);
+    flipper_rng_fortuna_init(&state->fortuna);
+
+    app->worker_thread = furi_thread_alloc();
+    furi_thread_set_name(app->worker_thread, "FlipperRngWorker");
+    furi_thread_set_stack_size(app->worker_thread, 4096);
+    furi_thread_set_callback(app->worker_thread, flipper_rng_worker_thread);
+    furi_thread_set_context(app->worker_thread, app);
+
+    return app;
+}
+
+void entropylab_host_app_free(FlipperRngApp* app) {
+    furi_check(app);
+
+    entropylab_host_worker_stop(app);
+    furi_thread_free(app->worker_thread);
+
+    flipper_rng_hw_accel_deinit();
+    flipper_rng_deinit_entropy_sources(app->state);
+
+    furi_mutex_free(app->state->mutex);
+    free(app->state);
+    free(app);
+}
+
+void entropylab_host_worker_start(FlipperRngApp* app) {
+    if(furi_thread_get_state(app->worker_thread) != FuriThreadStateStopped) return;
+
+    // Joining a finished thread is required before it can be started again
+    furi_thread_join(app->worker_thread);
+    app->state->is_running = true;
+    furi_thread_start(app->worker_thread);
+}
+
+void entropylab_host_worker_stop(FlipperRngApp* app) {
+    app->state->is_running = false;
+    furi_thread_join(app->worker_thread);
+}
+
+void entropylab_host_set_ext_root(const char* default_ext) {
+    if(!getenv("ENTROPYLAB_HOST_EXT") && default_ext) {
+        setenv("ENTROPYLAB_HOST_EXT", default_ext, 0);
+    }
+}
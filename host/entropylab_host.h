@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * Host harness for the Entropy Lab core
+ * Builds a FlipperRngApp with the same defaults as flipper_rng_app_alloc()
+ * but without any GUI, so the worker and pool functions run on Linux.
+ */
+
+#include "entropylab.h"
+
+// Allocate an app with only the state initialized (GUI handles stay NULL)
+FlipperRngApp* entropylab_host_app_alloc(void);
+void entropylab_host_app_free(FlipperRngApp* app);
+
+// Run flipper_rng_worker_thread on its own thread
+void entropylab_host_worker_start(FlipperRngApp* app);
+void entropylab_host_worker_stop(FlipperRngApp* app);
+
+// Point /ext at a directory containing apps_data/entropylab/<wordlists>
+// Uses ENTROPYLAB_HOST_EXT when set, otherwise falls back to default_ext
+void entropylab_host_set_ext_root(const char* default_ext);
+
+// Number of visualization snapshots the worker has pushed
+uint32_t entropylab_host_visualization_updates(void);
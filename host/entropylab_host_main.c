@@ -0,0 +1,2191 @@
+/**
+ * entropylab_host - run the Entropy Lab core on Linux
+ *
+ *   entropylab_host selftest          add/mix/extract/worker/passphrase smoke checks
+ *   entropylab_host uart <ms> [framed] [baud]
+ *                                     run the worker in UART mode with stdout as the serial port,
+ *                                     paced to baud when given; TX stats on stderr
+ *   entropylab_host pull <ms>         run the worker in UART pull mode on a new pty, path on stderr
+ *   entropylab_host decode [strict]   framed UART stream on stdin to payload on stdout, stats on
+ *                                     stderr; strict drops frames with health flags
+ *   entropylab_host passphrase [n]    generate an n-word passphrase from the EFF list
+ *   entropylab_host bench [iterations] [batch...]
+ *                                     time add/mix/extract, JSON on stdout
+ *   entropylab_host bulk [count] [eff|bip39|slip39|hex|base32] [words|bytes]
+ *                                     bulk passphrases or keys on stdout, rate on stderr
+ */
+
+#define _GNU_SOURCE  // posix_openpt, ptsname_r
+
+#include "entropylab_host.h"
+#include "entropylab_entropy.h"
+#include "entropylab_passphrase.h"
+#include "entropylab_passphrase_sd.h"
+#include "entropylab_line_reader.h"
+#include "entropylab_bench.h"
+#include "entropylab_bulk.h"
+#include "entropylab_aes.h"
+#include "entropylab_drbg.h"
+#include "entropylab_sha256.h"
+#include "entropylab_fortuna.h"
+#include "entropylab_blake2s.h"
+#include "entropylab_conditioner.h"
+#include "entropylab_subghz.h"
+#include "entropylab_file_writer.h"
+#include "entropylab_uart_writer.h"
+#include "entropylab_frame.h"
+#include "entropylab_pull.h"
+#include "entropylab_pull_client.h"
+#include <storage/storage.h>
+#include "entropylab_hw_accel.h"
+#include <furi_hal_subghz.h>
+#include <furi_hal_serial.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <time.h>
+
+#define HOST_DEFAULT_EXT "build/ext"
+#define HOST_SUBGHZ_TRACE "traces/subghz_noise.csv"
+
+static int host_failures = 0;
+
+static void host_check(bool condition, const char* what) {
+    printf("%s - %s\n", condition ? "ok" : "not ok", what);
+    if(!condition) host_failures++;
+}
+
+static double host_chi_square(const uint8_t* data, size_t length) {
+    uint32_t counts[256] = {0};
+    for(size_t i = 0; i < length; i++) counts[data[i]]++;
+
+    double expected = (double)length / 256.0;
+    double chi = 0.0;
+    for(int i = 0; i < 256; i++) {
+        double diff = (double)counts[i] - expected;
+        chi += diff * diff / expected;
+    }
+    return chi;
+}
+
+static void host_unhex(const char* hex, uint8_t* out, size_t length) {
+    for(size_t i = 0; i < length; i++) {
+        unsigned value = 0;
+        sscanf(&hex[i * 2], "%2x", &value);
+        out[i] = (uint8_t)value;
+    }
+}
+
+// FIPS-197 C.3 and a CTR_DRBG vector cross-checked against an OpenSSL-based reference
+static void host_crypto_known_answers(void) {
+    uint8_t key[32], block[16], expected[64];
+    for(int i = 0; i < 32; i++) key[i] = (uint8_t)i;
+    host_unhex("00112233445566778899aabbccddeeff", block, 16);
+    host_unhex("8ea2b7ca516745bfeafc49904b496089", expected, 16);
+
+    FlipperRngAes256 aes;
+    flipper_rng_aes256_init(&aes, key);
+    flipper_rng_aes256_encrypt_block(&aes, block, block);
+    host_check(memcmp(block, expected, 16) == 0, "AES-256 FIPS-197 known answer");
+
+    // Instantiate with 0x00..0x2f, discard one 64-byte generate, check the second,
+    // then reseed with 0x64..0x93 and check a 20-byte partial-block request
+    uint8_t seed[FLIPPER_RNG_DRBG_SEED_SIZE], output[64];
+    FlipperRngDrbg drbg = {0};
+    for(int i = 0; i < FLIPPER_RNG_DRBG_SEED_SIZE; i++) seed[i] = (uint8_t)i;
+    flipper_rng_drbg_instantiate(&drbg, seed, NULL, 0);
+    flipper_rng_drbg_generate(&drbg, output, 64, NULL, 0);
+    flipper_rng_drbg_generate(&drbg, output, 64, NULL, 0);
+    host_unhex(
+        "04562ad35e8ecafaafda16981cdaa147606beea62801342af13c8b5535f72f94"
+        "95b74317c762f0adab7abe710797612176b61b0e208398113cf9c170157bc75f",
+        expected,
+        64);
+    host_check(memcmp(output, expected, 64) == 0, "CTR_DRBG known answer");
+
+    for(int i = 0; i < FLIPPER_RNG_DRBG_SEED_SIZE; i++) seed[i] = (uint8_t)(100 + i);
+    flipper_rng_drbg_reseed(&drbg, seed, NULL, 0);
+    flipper_rng_drbg_generate(&drbg, output, 20, NULL, 0);
+    host_unhex("01d61b45fa7122e72db3a83905ac9e7f944d8f77", expected, 20);
+    host_check(memcmp(output, expected, 20) == 0, "CTR_DRBG known answer after reseed");
+
+    drbg.reseed_counter = FLIPPER_RNG_DRBG_RESEED_INTERVAL + 1;
+    host_check(!flipper_rng_drbg_generate(&drbg, output, 16, NULL, 0), "CTR_DRBG refuses output past reseed interval");
+    flipper_rng_drbg_wipe(&drbg);
+
+    // FIPS 180-4 examples, plus 1000 bytes fed in uneven pieces across block boundaries
+    uint8_t digest[FLIPPER_RNG_SHA256_DIGEST_SIZE];
+    flipper_rng_sha256((const uint8_t*)"abc", 3, digest);
+    host_unhex("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", expected, 32);
+    host_check(memcmp(digest, expected, 32) == 0, "SHA-256 one-block known answer");
+
+    const char* two_blocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    flipper_rng_sha256((const uint8_t*)two_blocks, strlen(two_blocks), digest);
+    host_unhex("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", expected, 32);
+    host_check(memcmp(digest, expected, 32) == 0, "SHA-256 two-block known answer");
+
+    uint8_t a_bytes[1000];
+    memset(a_bytes, 'a', sizeof(a_bytes));
+    FlipperRngSha256 sha;
+    flipper_rng_sha256_init(&sha);
+    for(size_t offset = 0, step = 1; offset < sizeof(a_bytes); offset += step, step = step * 3 % 97 + 1) {
+        flipper_rng_sha256_update(&sha, &a_bytes[offset], MIN(step, sizeof(a_bytes) - offset));
+    }
+    flipper_rng_sha256_final(&sha, digest);
+    host_unhex("41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3", expected, 32);
+    host_check(memcmp(digest, expected, 32) == 0, "SHA-256 streaming updates match the one-shot digest");
+
+    // RFC 7693 appendix B, the empty message, and the same uneven 1000-byte feed
+    flipper_rng_blake2s((const uint8_t*)"abc", 3, digest);
+    host_unhex("508c5e8c327c14e2e1a72ba34eeb452f37458b209ed63a294d999b4c86675982", expected, 32);
+    host_check(memcmp(digest, expected, 32) == 0, "BLAKE2s-256 known answer");
+
+    flipper_rng_blake2s(NULL, 0, digest);
+    host_unhex("69217a3079908094e11121d042354a7c1f55b6482ca1a51e1b250dfd1ed0eef9", expected, 32);
+    host_check(memcmp(digest, expected, 32) == 0, "BLAKE2s-256 empty message");
+
+    FlipperRngBlake2s blake;
+    flipper_rng_blake2s_init(&blake, FLIPPER_RNG_BLAKE2S_DIGEST_SIZE);
+    for(size_t offset = 0, step = 1; offset < sizeof(a_bytes); offset += step, step = step * 3 % 97 + 1) {
+        flipper_rng_blake2s_update(&blake, &a_bytes[offset], MIN(step, sizeof(a_bytes) - offset));
+    }
+    flipper_rng_blake2s_final(&blake, digest);
+    host_unhex("a4691c2bf852334ece63c024234338fc6c150bdf04fa3f6e0e4c5209b326438d", expected, 32);
+    host_check(memcmp(digest, expected, 32) == 0, "BLAKE2s streaming updates match the one-shot digest");
+}
+
+// The conditioner is the selected hash over the raw batch, and its digest goes out with the batch's credit
+static void host_conditioner(FlipperRngState* state) {
+    uint32_t raw[40];
+    for(size_t i = 0; i < COUNT_OF(raw); i++) raw[i] = 560 + (furi_hal_random_get() & 0x1F);
+
+    FlipperRngConditioner conditioner;
+    uint8_t digest[FLIPPER_RNG_CONDITIONER_OUTPUT], expected[FLIPPER_RNG_CONDITIONER_OUTPUT];
+    flipper_rng_conditioner_begin(&conditioner);
+    flipper_rng_conditioner_add(&conditioner, raw, 24 * sizeof(uint32_t), 12);
+    for(size_t i = 24; i < COUNT_OF(raw); i++) flipper_rng_conditioner_add_word(&conditioner, raw[i], 1);
+    uint32_t bits = flipper_rng_conditioner_finish(&conditioner, digest);
+#ifdef FLIPPER_RNG_CONDITIONER_SHA256
+    flipper_rng_sha256((const uint8_t*)raw, sizeof(raw), expected);
+    bool backend = strcmp(flipper_rng_conditioner_name(), "sha256") == 0;
+#else
+    flipper_rng_blake2s((const uint8_t*)raw, sizeof(raw), expected);
+    bool backend = strcmp(flipper_rng_conditioner_name(), "blake2s") == 0;
+#endif
+    host_check(
+        backend && bits == 28 && memcmp(digest, expected, sizeof(digest)) == 0,
+        "conditioner digest is the selected hash of the whole batch");
+
+    flipper_rng_conditioner_begin(&conditioner);
+    flipper_rng_conditioner_add(&conditioner, raw, sizeof(raw), 1000);
+    host_check(
+        flipper_rng_conditioner_finish(&conditioner, digest) == FLIPPER_RNG_CONDITIONER_OUTPUT * 8,
+        "conditioner credit is capped at the digest size");
+
+    // 70 bits go out as 32 + 32 + 6 on the source's ring
+    flipper_rng_drain_samples(state);
+    flipper_rng_conditioner_begin(&conditioner);
+    flipper_rng_conditioner_add(&conditioner, raw, sizeof(raw), 70);
+    uint32_t queued = flipper_rng_push_conditioned(state, FlipperRngSourceInfrared, &conditioner);
+    FlipperRngSample samples[4];
+    size_t count = 0;
+    while(count < COUNT_OF(samples) && flipper_rng_ring_pop(&state->sample_rings[FlipperRngSourceInfrared], &samples[count])) {
+        count++;
+    }
+    host_check(
+        queued == 70 && count == 3 && samples[0].bits == 32 && samples[1].bits == 32 && samples[2].bits == 6,
+        "conditioned batches are queued as digest words carrying their credit");
+
+    // A stuck source is caught on its raw readings, before the hash hides it
+    flipper_rng_init_health(state);
+    flipper_rng_init_estimators(state);
+    uint32_t stuck[32];
+    for(size_t i = 0; i < COUNT_OF(stuck); i++) stuck[i] = 600;
+    size_t passed = 0;
+    queued = 0;
+    for(int signal = 0; signal < 4; signal++) {
+        flipper_rng_conditioner_begin(&conditioner);
+        size_t signal_passed =
+            flipper_rng_condition_raw(state, FlipperRngSourceInfrared, &conditioner, stuck, COUNT_OF(stuck), 1);
+        if(signal_passed > 0) {
+            flipper_rng_conditioner_credit(&conditioner, 16 * signal_passed / COUNT_OF(stuck));
+            queued += flipper_rng_push_conditioned(state, FlipperRngSourceInfrared, &conditioner);
+        }
+        passed += signal_passed;
+    }
+    uint32_t ir_before = state->bits_from_infrared;
+    flipper_rng_drain_samples(state);
+    host_check(
+        flipper_rng_health_is_quarantined(&state->health[FlipperRngSourceInfrared]) &&
+            passed == (size_t)flipper_rng_health_rct_cutoff(1) - 1,
+        "stuck raw readings quarantine the source before they are conditioned");
+    host_check(
+        queued == 16 * passed / COUNT_OF(stuck) && state->bits_from_infrared - ir_before == queued &&
+            state->estimators[FlipperRngSourceInfrared].samples == 4 * COUNT_OF(stuck),
+        "only readings before the failure are credited, and the estimator sees every raw reading");
+
+    // Readings queued raw from another thread get the same treatment in the drain
+    flipper_rng_init_health(state);
+    flipper_rng_init_estimators(state);
+    ir_before = state->bits_from_infrared;
+    for(int signal = 0; signal < 4; signal++) {
+        flipper_rng_push_raw(state, FlipperRngSourceInfrared, 0x12345678, stuck, COUNT_OF(stuck), 16);
+        flipper_rng_drain_samples(state);
+    }
+    host_check(
+        flipper_rng_health_is_quarantined(&state->health[FlipperRngSourceInfrared]) &&
+            state->bits_from_infrared - ir_before == queued &&
+            state->estimators[FlipperRngSourceInfrared].samples == 4 * COUNT_OF(stuck),
+        "raw groups are health tested and conditioned by the drain, credited like condition_raw");
+
+    // A group is queued whole or not at all, so the drain never conditions half a signal
+    flipper_rng_init_health(state);
+    flipper_rng_init_estimators(state);
+    uint32_t dropped_before = flipper_rng_ring_dropped(&state->sample_rings[FlipperRngSourceInfrared]);
+    bool first = flipper_rng_push_raw(state, FlipperRngSourceInfrared, 1, stuck, COUNT_OF(stuck), 16);
+    unsigned ring_used = atomic_load(&state->sample_rings[FlipperRngSourceInfrared].head) -
+                         atomic_load(&state->sample_rings[FlipperRngSourceInfrared].tail);
+    bool second = flipper_rng_push_raw(state, FlipperRngSourceInfrared, 2, raw, COUNT_OF(raw), 16);
+    uint32_t dropped = flipper_rng_ring_dropped(&state->sample_rings[FlipperRngSourceInfrared]) - dropped_before;
+    ir_before = state->bits_from_infrared;
+    flipper_rng_drain_samples(state);
+    host_check(
+        first && !second && ring_used == COUNT_OF(stuck) + 2 && dropped == FLIPPER_RNG_RAW_MAX_READINGS + 2 &&
+            state->bits_from_infrared - ir_before == queued,
+        "raw groups that do not fit are dropped whole");
+    flipper_rng_init_health(state);
+    flipper_rng_init_estimators(state);
+}
+
+#define HOST_RING_SAMPLES 200000
+
+static int32_t host_ring_producer(void* context) {
+    FlipperRngState* state = context;
+    for(uint32_t i = 0; i < HOST_RING_SAMPLES; i++) {
+        // Retry on a full ring so the test counts every sample
+        while(!flipper_rng_push_sample(state, FlipperRngSourceInfrared, i, 8)) {
+            furi_thread_yield();
+        }
+    }
+    return 0;
+}
+
+// A producer thread pushes while this thread drains, as the IR worker and generator worker do
+static void host_ring_concurrency(FlipperRngState* state) {
+    FlipperRngSampleRing ring;
+    flipper_rng_ring_init(&ring);
+    host_check(flipper_rng_ring_push(&ring, 1, 8, FlipperRngSourceInfrared), "ring accepts a sample");
+    for(int i = 1; i < FLIPPER_RNG_RING_SIZE; i++) flipper_rng_ring_push(&ring, (uint32_t)i, 8, FlipperRngSourceInfrared);
+    host_check(!flipper_rng_ring_push(&ring, 0, 8, FlipperRngSourceInfrared) && flipper_rng_ring_dropped(&ring) == 1, "full ring drops and counts");
+
+    uint32_t bits_before = state->bits_from_infrared;
+    uint32_t dropped_before = flipper_rng_samples_dropped(state);
+    FuriThread* producer = furi_thread_alloc_ex("RingProducer", 1024, host_ring_producer, state);
+    furi_thread_start(producer);
+
+    uint64_t credited = 0;
+    while(credited < (uint64_t)HOST_RING_SAMPLES * 8) {
+        credited += flipper_rng_drain_samples(state);
+        furi_thread_yield();
+    }
+    furi_thread_join(producer);
+    furi_thread_free(producer);
+
+    host_check(credited == (uint64_t)HOST_RING_SAMPLES * 8, "drain credits every pushed sample exactly once");
+    host_check(
+        state->bits_from_infrared - bits_before == HOST_RING_SAMPLES * 8, "drain updates the per-source bit counter");
+    printf(
+        "# producer retried on full ring %lu times\n",
+        (unsigned long)(flipper_rng_samples_dropped(state) - dropped_before));
+}
+
+// The batch path must leave the pool exactly as the same samples added one at a time
+static void host_add_entropy_batch(FlipperRngState* state) {
+    static uint8_t expected_pool[RNG_POOL_SIZE];
+    FlipperRngSample batch[97];
+    for(size_t i = 0; i < COUNT_OF(batch); i++) {
+        batch[i].sample = furi_hal_random_get();
+        batch[i].bits = (uint8_t)((i % 4 + 1) * 8 - (i % 3));  // Mix of 1-4 byte samples
+        batch[i].source = (uint8_t)(i % FlipperRngSourceCount);
+    }
+
+    size_t start_pos = state->entropy_pool_pos;
+    for(size_t i = 0; i < COUNT_OF(batch); i++) {
+        flipper_rng_add_entropy(state, batch[i].sample, batch[i].bits);
+    }
+    memcpy(expected_pool, state->entropy_pool, RNG_POOL_SIZE);
+    size_t expected_pos = state->entropy_pool_pos;
+
+    // Undo by XORing the same bytes back in, then replay as a batch
+    state->entropy_pool_pos = start_pos;
+    for(size_t i = 0; i < COUNT_OF(batch); i++) {
+        flipper_rng_add_entropy(state, batch[i].sample, batch[i].bits);
+    }
+    state->entropy_pool_pos = start_pos;
+
+    uint32_t hw_before = state->bits_from_hw_rng;
+    uint32_t subghz_before = state->bits_from_subghz_rssi;
+    uint32_t ir_before = state->bits_from_infrared;
+    uint32_t credited = flipper_rng_add_entropy_batch(state, batch, COUNT_OF(batch));
+
+    uint32_t expected_credit = 0, expected_source[FlipperRngSourceCount] = {0};
+    for(size_t i = 0; i < COUNT_OF(batch); i++) {
+        expected_credit += batch[i].bits;
+        expected_source[batch[i].source] += batch[i].bits;
+    }
+
+    host_check(
+        memcmp(expected_pool, state->entropy_pool, RNG_POOL_SIZE) == 0 && state->entropy_pool_pos == expected_pos,
+        "add_entropy_batch matches per-sample add_entropy");
+    host_check(credited == expected_credit, "add_entropy_batch returns credited bits");
+    host_check(
+        state->bits_from_hw_rng - hw_before == expected_source[FlipperRngSourceHardwareRNG] &&
+            state->bits_from_subghz_rssi - subghz_before == expected_source[FlipperRngSourceSubGhzRSSI] &&
+            state->bits_from_infrared - ir_before == expected_source[FlipperRngSourceInfrared],
+        "add_entropy_batch credits each source");
+}
+
+// Stuck and biased sources are quarantined, good data passes, and a source recovers once it behaves
+static void host_health_tests(FlipperRngState* state) {
+    host_check(
+        flipper_rng_health_rct_cutoff(32) == 2 && flipper_rng_health_rct_cutoff(4) == 6 &&
+            flipper_rng_health_rct_cutoff(1) == 21,
+        "RCT cutoffs are 1 + ceil(20 / H)");
+    host_check(
+        flipper_rng_health_apt_cutoff(1) == 311 && flipper_rng_health_apt_cutoff(8) == 13 &&
+            flipper_rng_health_apt_cutoff(32) == 2,
+        "APT cutoffs match the binomial table");
+
+    FlipperRngHealth health;
+    flipper_rng_health_init(&health);
+    for(uint32_t i = 0; i < 200000; i++) {
+        flipper_rng_health_test(&health, furi_hal_random_get(), 32);
+    }
+    host_check(flipper_rng_health_failures(&health) == 0, "TRNG words pass the health tests");
+
+    // A stuck value at H = 4 fails the RCT on its 6th repeat
+    flipper_rng_health_init(&health);
+    int passed = 0;
+    while(flipper_rng_health_test(&health, 0x42, 4) == FlipperRngHealthPass) passed++;
+    host_check(passed == 5 && health.rct_failures == 1, "RCT fails a stuck source at the cutoff");
+
+    // Alternating values never repeat back to back but fill half of every APT window
+    flipper_rng_health_init(&health);
+    for(uint32_t i = 0; i < FLIPPER_RNG_HEALTH_APT_WINDOW; i++) {
+        flipper_rng_health_test(&health, (i & 1) ? 0xAA : 0x55, 8);
+    }
+    host_check(health.rct_failures == 0 && health.apt_failures > 0, "APT fails a two-valued source");
+
+    // Through the batch path: a stuck IR source stops being credited and leaves the pool alone
+    static uint8_t pool_before[RNG_POOL_SIZE];
+    FlipperRngSample batch[16];
+    for(size_t i = 0; i < COUNT_OF(batch); i++) {
+        batch[i].sample = 0xDEADBEEF;
+        batch[i].bits = 8;
+        batch[i].source = FlipperRngSourceInfrared;
+    }
+    flipper_rng_init_health(state);
+    uint32_t ir_before = state->bits_from_infrared;
+    uint32_t credited = flipper_rng_add_entropy_batch(state, batch, COUNT_OF(batch));
+    host_check(credited == 3 * 8 && state->bits_from_infrared - ir_before == 3 * 8, "stuck source loses its credit");
+    host_check(flipper_rng_health_is_quarantined(&state->health[FlipperRngSourceInfrared]), "stuck source is quarantined");
+
+    memcpy(pool_before, state->entropy_pool, RNG_POOL_SIZE);
+    credited = flipper_rng_add_entropy_batch(state, batch, COUNT_OF(batch));
+    host_check(
+        credited == 0 && memcmp(pool_before, state->entropy_pool, RNG_POOL_SIZE) == 0,
+        "quarantined samples never reach the pool");
+
+    // Other sources keep flowing while one is quarantined
+    FlipperRngSample hw = {furi_hal_random_get(), 32, FlipperRngSourceHardwareRNG};
+    host_check(flipper_rng_add_entropy_batch(state, &hw, 1) == 32, "healthy sources are still credited");
+
+    // Good samples work off the quarantine, then credit resumes
+    uint32_t recovered_after = 0;
+    for(uint32_t i = 0; i < 2 * FLIPPER_RNG_HEALTH_QUARANTINE; i++) {
+        FlipperRngSample good = {furi_hal_random_get(), 8, FlipperRngSourceInfrared};
+        if(flipper_rng_add_entropy_batch(state, &good, 1)) {
+            recovered_after = i;
+            break;
+        }
+    }
+    host_check(
+        recovered_after == FLIPPER_RNG_HEALTH_QUARANTINE &&
+            !flipper_rng_health_is_quarantined(&state->health[FlipperRngSourceInfrared]),
+        "source recovers after the quarantine");
+    printf(
+        "# health: IR %lu failures, %lu bits discarded\n",
+        (unsigned long)flipper_rng_health_failures(&state->health[FlipperRngSourceInfrared]),
+        (unsigned long)state->health[FlipperRngSourceInfrared].bits_discarded);
+    flipper_rng_init_health(state);
+}
+
+// Estimates track what a source really delivers per sample, whatever it is credited with
+static void host_min_entropy_estimators(FlipperRngState* state) {
+    FlipperRngEstimator estimator;
+    flipper_rng_estimator_init(&estimator);
+    for(int i = 0; i < 2000; i++) flipper_rng_estimator_add(&estimator, furi_hal_random_get(), 32);
+    flipper_rng_estimator_update(&estimator);
+    printf(
+        "# TRNG estimate: mcv %.2f, collision %.2f, markov %.2f bits/byte, %.1f of %.0f bits/sample\n",
+        estimator.mcv,
+        estimator.collision,
+        estimator.markov,
+        estimator.per_sample,
+        estimator.credited_per_sample);
+    // The collision estimate of a true 8-bit source spreads down to about 5.7 over 2000 runs
+    host_check(estimator.valid && estimator.min_entropy > 5.0f, "TRNG bytes estimate close to 8 bits");
+    host_check(estimator.total <= FLIPPER_RNG_ESTIMATOR_WINDOW, "estimator window stays bounded");
+
+    // Credited 16 bits, but only two bits per byte ever change
+    flipper_rng_estimator_init(&estimator);
+    for(int i = 0; i < 2000; i++) flipper_rng_estimator_add(&estimator, furi_hal_random_get() & 0x0303, 16);
+    flipper_rng_estimator_update(&estimator);
+    printf(
+        "# 2-bit source estimate: mcv %.2f, collision %.2f, markov %.2f bits/byte, %.1f of %.0f bits/sample\n",
+        estimator.mcv,
+        estimator.collision,
+        estimator.markov,
+        estimator.per_sample,
+        estimator.credited_per_sample);
+    host_check(
+        estimator.per_sample < 4.5f && estimator.credited_per_sample == 16.0f, "over-credited source is exposed");
+
+    flipper_rng_estimator_init(&estimator);
+    for(int i = 0; i < 1000; i++) flipper_rng_estimator_add(&estimator, 0x5A, 8);
+    flipper_rng_estimator_update(&estimator);
+    host_check(estimator.min_entropy < 0.1f, "constant source estimates near zero");
+
+    flipper_rng_estimator_init(&estimator);
+    for(int i = 0; i < 10; i++) flipper_rng_estimator_add(&estimator, furi_hal_random_get(), 32);
+    flipper_rng_estimator_update(&estimator);
+    host_check(!estimator.valid, "no estimate until enough bytes are seen");
+
+    // The batch path feeds the per-source estimators and update_quality_metric publishes them
+    flipper_rng_init_estimators(state);
+    FlipperRngSample batch[64];
+    for(int round = 0; round < 16; round++) {
+        for(size_t i = 0; i < COUNT_OF(batch); i++) {
+            batch[i].sample = furi_hal_random_get();
+            batch[i].bits = 32;
+            batch[i].source = FlipperRngSourceHardwareRNG;
+        }
+        flipper_rng_add_entropy_batch(state, batch, COUNT_OF(batch));
+    }
+    flipper_rng_update_quality_metric(state);
+    const FlipperRngEstimator* hw = &state->estimators[FlipperRngSourceHardwareRNG];
+    host_check(hw->valid && hw->per_sample > 20.0f, "worker path publishes the TRNG estimate");
+    host_check(!state->estimators[FlipperRngSourceInfrared].valid, "idle source has no estimate");
+
+    uint64_t start = flipper_rng_hw_get_time_ns();
+    for(int i = 0; i < 100000; i++) flipper_rng_estimator_add(&estimator, (uint32_t)i * 2654435761u, 32);
+    printf("# estimator: %.1f ns per 32-bit sample\n", (double)(flipper_rng_hw_get_time_ns() - start) / 100000.0);
+}
+
+// The pre-word-wide extraction loop: 8 taps with % per byte, one jitter per byte
+static void host_pool_read_scalar(
+    const uint8_t* pool,
+    size_t* pos,
+    uint8_t* out,
+    size_t count,
+    const uint8_t* jitter) {
+    const size_t prime_offsets[8] = {511, 1023, 1531, 2047, 2557, 3067, 3583, 4093};
+    for(size_t byte_idx = 0; byte_idx < count; byte_idx++) {
+        size_t base_pos = *pos;
+        uint8_t result = pool[base_pos];
+        for(int t = 0; t < 7; t++) {
+            result ^= pool[(base_pos + prime_offsets[t]) % RNG_POOL_SIZE];
+        }
+        out[byte_idx] = result;
+        *pos = (*pos + 1 + (jitter[byte_idx] & 0x7)) % RNG_POOL_SIZE;
+    }
+}
+
+static void host_pool_read_kernel(void) {
+    static uint8_t pool[RNG_POOL_SIZE];
+    uint32_t jitter_words[64];
+    uint8_t jitter[COUNT_OF(jitter_words) * RNG_POOL_READ_JITTERS_PER_WORD];
+    uint8_t expected[sizeof(jitter)], actual[sizeof(jitter)];
+
+    static const size_t counts[] = {1, 3, 4, 9, 10, 11, 48, 333, sizeof(jitter)};
+    static const size_t starts[] = {0, 1234, RNG_POOL_SIZE - 3};
+    bool match = true;
+    for(int round = 0; round < 50; round++) {
+        furi_hal_random_fill_buf(pool, sizeof(pool));
+        for(size_t w = 0; w < COUNT_OF(jitter_words); w++) {
+            jitter_words[w] = furi_hal_random_get();
+            // Ten 3-bit fields per word, low bits first; the top two bits are unused
+            for(int j = 0; j < RNG_POOL_READ_JITTERS_PER_WORD; j++) {
+                jitter[w * RNG_POOL_READ_JITTERS_PER_WORD + j] = (jitter_words[w] >> (3 * j)) & 0x7;
+            }
+        }
+
+        for(size_t c = 0; c < COUNT_OF(counts); c++) {
+            for(size_t s = 0; s < COUNT_OF(starts); s++) {
+                size_t scalar_pos = starts[s], kernel_pos = starts[s];
+                host_pool_read_scalar(pool, &scalar_pos, expected, counts[c], jitter);
+                flipper_rng_pool_read_kernel(pool, &kernel_pos, actual, counts[c], jitter_words);
+                if(memcmp(expected, actual, counts[c]) != 0 || scalar_pos != kernel_pos) match = false;
+            }
+        }
+    }
+    host_check(match, "word-wide pool read matches the scalar kernel for the same jitter");
+}
+
+// Bytes outside [start, end) are unchanged and at least one inside changed
+static bool host_pool_changed_only_in(const uint8_t* before, const uint8_t* after, size_t start, size_t end) {
+    bool changed = false;
+    for(size_t i = 0; i < RNG_POOL_SIZE; i++) {
+        if(before[i] == after[i]) continue;
+        if(i < start || i >= end) return false;
+        changed = true;
+    }
+    return changed;
+}
+
+static void host_dirty_region_mixing(FlipperRngState* state) {
+    static uint8_t before[RNG_POOL_SIZE];
+    uint32_t saved_interval = state->full_mix_interval;
+    MixingMode saved_mode = state->mixing_mode;
+    state->full_mix_interval = 1000;
+    state->mixes_since_full = 0;
+
+    static const MixingMode modes[] = {MixingModeHardware, MixingModeSoftware};
+    for(size_t m = 0; m < COUNT_OF(modes); m++) {
+        state->mixing_mode = modes[m];
+        flipper_rng_mix_entropy_pool(state);  // Clear whatever earlier tests left dirty
+
+        // One sample in region 1 (bytes 256-511)
+        state->entropy_pool_pos = RNG_POOL_REGION_SIZE + 44;
+        flipper_rng_add_entropy(state, 0xA5A5A5A5, 32);
+        host_check(state->dirty_regions == (1u << 1), "add_entropy marks only the region it wrote");
+
+        memcpy(before, state->entropy_pool, RNG_POOL_SIZE);
+        flipper_rng_mix_entropy_pool(state);
+        host_check(
+            host_pool_changed_only_in(before, state->entropy_pool, RNG_POOL_REGION_SIZE, 2 * RNG_POOL_REGION_SIZE),
+            modes[m] == MixingModeHardware ? "hardware mix touches only the dirty region" :
+                                             "software mix touches only the dirty region");
+        host_check(state->dirty_regions == 0, "mix clears the dirty mask");
+    }
+
+    // Nothing dirty: no work until the full sweep comes round
+    state->full_mix_interval = 4;
+    state->mixes_since_full = 0;
+    uint32_t mix_counter = state->mix_counter;
+    memcpy(before, state->entropy_pool, RNG_POOL_SIZE);
+    for(int i = 0; i < 3; i++) flipper_rng_mix_entropy_pool(state);
+    host_check(
+        memcmp(before, state->entropy_pool, RNG_POOL_SIZE) == 0 && state->mix_counter == mix_counter,
+        "mix with no dirty regions is skipped");
+
+    flipper_rng_mix_entropy_pool(state);
+    bool every_region = true;
+    for(size_t r = 0; r < RNG_POOL_REGIONS; r++) {
+        size_t offset = r * RNG_POOL_REGION_SIZE;
+        if(memcmp(&before[offset], &state->entropy_pool[offset], RNG_POOL_REGION_SIZE) == 0) every_region = false;
+    }
+    host_check(every_region && state->mix_counter == mix_counter + 1, "full sweep mixes every region at the interval");
+
+    state->full_mix_interval = saved_interval;
+    state->mixing_mode = saved_mode;
+}
+
+static bool host_fortuna_pool_is_initial(const FlipperRngFortuna* fortuna, size_t pool) {
+    uint32_t initial[8];
+    flipper_rng_sha256_initial_state(initial);
+    return memcmp(fortuna->pools[pool], initial, sizeof(initial)) == 0;
+}
+
+static void host_fortuna(FlipperRngState* state) {
+    // 2^i must divide the reseed number for pool i to be drained
+    static FlipperRngFortuna fortuna;
+    uint8_t seed[FLIPPER_RNG_DRBG_SEED_SIZE], previous[FLIPPER_RNG_DRBG_SEED_SIZE];
+    flipper_rng_fortuna_init(&fortuna);
+    static const uint8_t expected_pools[] = {1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1, 5};
+    bool schedule = true;
+    memset(previous, 0, sizeof(previous));
+    for(size_t r = 0; r < COUNT_OF(expected_pools); r++) {
+        schedule &= flipper_rng_fortuna_reseed(&fortuna, seed, sizeof(seed), 0) == expected_pools[r];
+        schedule &= memcmp(seed, previous, sizeof(seed)) != 0;
+        memcpy(previous, seed, sizeof(seed));
+    }
+    host_check(schedule, "Fortuna reseed n drains pool i only when 2^i divides n, with fresh seeds");
+
+    // Each source walks the pools on its own: 32 events from one source touch every
+    // pool once and leave the other sources' positions alone
+    flipper_rng_fortuna_init(&fortuna);
+    for(size_t i = 0; i < FLIPPER_RNG_FORTUNA_POOLS * FLIPPER_RNG_FORTUNA_EVENT_BYTES; i++) {
+        flipper_rng_fortuna_add(&fortuna, FlipperRngSourceInfrared, (uint32_t)i * 2654435761u, 8);
+    }
+    bool every_pool = true;
+    for(size_t i = 0; i < FLIPPER_RNG_FORTUNA_POOLS; i++) every_pool &= !host_fortuna_pool_is_initial(&fortuna, i);
+    host_check(
+        every_pool && fortuna.events == FLIPPER_RNG_FORTUNA_POOLS &&
+            fortuna.next_pool[FlipperRngSourceInfrared] == 0 && fortuna.next_pool[FlipperRngSourceHardwareRNG] == 0 &&
+            fortuna.pool0_bytes == FLIPPER_RNG_FORTUNA_EVENT_BYTES,
+        "Fortuna spreads a source's events round-robin over all 32 pools");
+
+    // Scheduled reseeds need 64 bytes in pool 0 and 100 ms since the last one
+    host_check(!flipper_rng_fortuna_reseed_due(&fortuna, 0), "Fortuna waits for 64 bytes in pool 0");
+    for(size_t i = 0; i < FLIPPER_RNG_FORTUNA_POOLS * FLIPPER_RNG_FORTUNA_EVENT_BYTES / 4; i++) {
+        flipper_rng_fortuna_add(&fortuna, FlipperRngSourceHardwareRNG, furi_hal_random_get(), 32);
+    }
+    bool due_first = flipper_rng_fortuna_reseed_due(&fortuna, 0);
+    flipper_rng_fortuna_reseed(&fortuna, seed, sizeof(seed), 1000);
+    for(size_t i = 0; i < FLIPPER_RNG_FORTUNA_POOLS * FLIPPER_RNG_FORTUNA_EVENT_BYTES / 4 * 2; i++) {
+        flipper_rng_fortuna_add(&fortuna, FlipperRngSourceHardwareRNG, furi_hal_random_get(), 32);
+    }
+    host_check(
+        due_first && !flipper_rng_fortuna_reseed_due(&fortuna, 1099) && flipper_rng_fortuna_reseed_due(&fortuna, 1100) &&
+            !host_fortuna_pool_is_initial(&fortuna, 0),
+        "Fortuna reseeds at most every 100 ms");
+
+    // Through the state: Fortuna mode leaves the XOR pool alone and reseeds the DRBG from a mix
+    static uint8_t pool_before[RNG_POOL_SIZE];
+    MixingMode saved_mode = state->mixing_mode;
+    state->mixing_mode = MixingModeFortuna;
+    memcpy(pool_before, state->entropy_pool, RNG_POOL_SIZE);
+    uint32_t events = state->fortuna.events;
+    FlipperRngSample samples[RNG_HW_BATCH_WORDS];
+    for(int batch = 0; batch < 64; batch++) {
+        for(size_t i = 0; i < COUNT_OF(samples); i++) {
+            samples[i].sample = furi_hal_random_get();
+            samples[i].bits = 32;
+            samples[i].source = FlipperRngSourceHardwareRNG;
+        }
+        flipper_rng_add_entropy_batch(state, samples, COUNT_OF(samples));
+    }
+    flipper_rng_add_entropy(state, furi_hal_random_get(), 32);
+    host_check(
+        memcmp(pool_before, state->entropy_pool, RNG_POOL_SIZE) == 0 && state->fortuna.events > events &&
+            state->fortuna.staged_len[FlipperRngSourceCount] == 4,
+        "Fortuna mode feeds the Fortuna pools instead of the XOR pool");
+
+    state->fortuna.last_reseed_ms = furi_get_tick() - FLIPPER_RNG_FORTUNA_RESEED_MS;
+    uint32_t reseeds = state->fortuna.reseed_count;
+    flipper_rng_mix_entropy_pool(state);
+    host_check(
+        state->fortuna.reseed_count == reseeds + 1 && state->drbg_seed_mix_counter == state->mix_counter &&
+            memcmp(pool_before, state->entropy_pool, RNG_POOL_SIZE) == 0,
+        "Fortuna mix reseeds the CTR_DRBG on schedule without touching the XOR pool");
+    flipper_rng_mix_entropy_pool(state);
+    host_check(state->fortuna.reseed_count == reseeds + 1, "Fortuna mix skips the reseed until pool 0 refills");
+
+    static uint8_t output[16384];
+    flipper_rng_extract_random_bytes(state, output, sizeof(output));
+    double chi = host_chi_square(output, sizeof(output));
+    host_check(chi < 400.0, "Fortuna mode output is roughly uniform");
+    state->mixing_mode = saved_mode;
+}
+
+// Feed count 8-bit readings from source, the same readings whatever the TRNG seed
+static void host_fortuna_feed(FlipperRngState* state, uint8_t source, size_t count, uint32_t salt) {
+    FlipperRngSample samples[8];
+    for(size_t done = 0; done < count; done += COUNT_OF(samples)) {
+        size_t batch = MIN(count - done, COUNT_OF(samples));
+        for(size_t i = 0; i < batch; i++) {
+            samples[i].sample = ((uint32_t)(done + i) ^ salt) * 2654435761u >> 24;
+            samples[i].bits = 8;
+            samples[i].source = source;
+        }
+        flipper_rng_add_entropy_batch(state, samples, batch);
+    }
+}
+
+// Fortuna start-up with only SubGHz and IR: nothing is drawn from the pools before
+// pool 0 has its 64 bytes, so the first output differs with the TRNG, not fixed
+static void host_fortuna_startup(FlipperRngState* state) {
+    static const uint64_t seeds[] = {1, 2, 3};
+    uint8_t output[COUNT_OF(seeds)][32];
+    MixingMode saved_mode = state->mixing_mode;
+    state->mixing_mode = MixingModeFortuna;
+    bool untouched = true, not_ready = true;
+    size_t pool_pos = state->entropy_pool_pos;
+
+    for(size_t s = 0; s < COUNT_OF(seeds); s++) {
+        furi_hal_random_host_seed(seeds[s]);
+        flipper_rng_init_health(state);
+        flipper_rng_fortuna_init(&state->fortuna);
+        flipper_rng_drbg_wipe(&state->drbg);
+        state->drbg_reserve_len = 0;
+        state->entropy_credit = 0;
+        state->entropy_ready = false;
+
+        // 40 bytes each: credit past the ready mark, but no event reaches pool 0 yet
+        host_fortuna_feed(state, FlipperRngSourceSubGhzRSSI, 40, 0);
+        host_fortuna_feed(state, FlipperRngSourceInfrared, 40, 1);
+        not_ready &= state->entropy_credit >= RNG_CREDIT_READY_BITS && !state->entropy_ready;
+        flipper_rng_extract_random_bytes(state, output[s], sizeof(output[s]));
+        untouched &= state->fortuna.reseed_count == 0 && state->drbg.instantiated;
+    }
+    host_check(not_ready, "Fortuna is not ready on credit alone");
+    host_check(
+        !flipper_rng_debit_entropy_wait(state, 8, 1, NULL) && state->entropy_claimed == 0,
+        "no credit is spent before the first Fortuna reseed");
+    host_check(untouched, "Fortuna pools are not drained before pool 0 has its minimum");
+    host_check(state->entropy_pool_pos == pool_pos, "Fortuna fallback seeds do not read the stale XOR pool");
+
+    flipper_rng_set_mixing_mode(state, MixingModeHardware);
+    bool hardware_ready = state->entropy_ready;
+    flipper_rng_set_mixing_mode(state, MixingModeFortuna);
+    host_check(hardware_ready && !state->entropy_ready, "switching mixing mode re-evaluates readiness");
+    host_check(
+        memcmp(output[0], output[1], sizeof(output[0])) != 0 && memcmp(output[1], output[2], sizeof(output[0])) != 0 &&
+            memcmp(output[0], output[2], sizeof(output[0])) != 0,
+        "Fortuna start-up output differs across TRNG seeds with SubGHz and IR only");
+
+    // One full event from each source puts 124 bytes in pool 0
+    host_fortuna_feed(state, FlipperRngSourceSubGhzRSSI, FLIPPER_RNG_FORTUNA_EVENT_BYTES, 2);
+    host_fortuna_feed(state, FlipperRngSourceInfrared, FLIPPER_RNG_FORTUNA_EVENT_BYTES, 3);
+    state->drbg_seed_mix_counter = state->mix_counter - 1;
+    flipper_rng_extract_random_bytes(state, output[0], sizeof(output[0]));
+    host_check(state->fortuna.reseed_count == 1 && state->entropy_ready, "first real Fortuna reseed makes entropy ready");
+    host_check(flipper_rng_debit_entropy_wait(state, 8, 0, NULL), "credit can be spent after the first Fortuna reseed");
+
+    furi_hal_random_init();
+    flipper_rng_init_health(state);
+    state->mixing_mode = saved_mode;
+}
+
+// Step the sweep once per "worker tick" until it goes back to idle
+// Returns the number of steps, or 0 if it never started or never finished
+static uint32_t host_subghz_run_sweep(FlipperRngState* state, uint64_t* max_step_ns) {
+    bool started = false;
+    for(uint32_t step = 1; step <= 1000; step++) {
+        uint64_t start = flipper_rng_hw_get_time_ns();
+        FlipperRngSubGhzSweepPhase phase = flipper_rng_subghz_sweep_step(state);
+        uint64_t elapsed = flipper_rng_hw_get_time_ns() - start;
+        if(elapsed > *max_step_ns) *max_step_ns = elapsed;
+
+        if(phase != FlipperRngSubGhzSweepIdle) {
+            started = true;
+        } else if(started) {
+            return step;
+        }
+        furi_delay_ms(1);
+    }
+    return 0;
+}
+
+static void host_subghz_sweep(FlipperRngState* state) {
+    if(!furi_hal_subghz_host_load_trace(HOST_SUBGHZ_TRACE)) {
+        host_check(false, "SubGHz RSSI trace " HOST_SUBGHZ_TRACE " loads");
+        return;
+    }
+
+    uint32_t saved_sources = state->entropy_sources;
+    state->entropy_sources = EntropySourceSubGhzRSSI;
+    state->is_running = true;
+    flipper_rng_drain_samples(state);
+
+    uint32_t bits_before = state->bits_from_subghz_rssi;
+    uint64_t sweep_start = flipper_rng_hw_get_time_ns();
+    uint64_t max_step_ns = 0;
+    uint32_t steps = host_subghz_run_sweep(state, &max_step_ns);
+    uint64_t sweep_ns = flipper_rng_hw_get_time_ns() - sweep_start;
+    flipper_rng_drain_samples(state);
+
+    printf(
+        "# SubGHz sweep: %u steps over %.1f ms, longest step %.1f us\n",
+        (unsigned)steps,
+        (double)sweep_ns / 1e6,
+        (double)max_step_ns / 1e3);
+    host_check(steps > 0, "SubGHz sweep runs to completion one step at a time");
+    host_check(
+        state->bits_from_subghz_rssi - bits_before ==
+            FLIPPER_RNG_SUBGHZ_BYTES_PER_SWEEP * FLIPPER_RNG_SUBGHZ_BITS_PER_BYTE,
+        "SubGHz sweep queues one credited byte per frequency");
+    host_check(
+        furi_hal_subghz_host_trace_reads() == FLIPPER_RNG_SUBGHZ_BYTES_PER_SWEEP * FLIPPER_RNG_SUBGHZ_RSSI_SAMPLES,
+        "SubGHz sweep reads every RSSI sample from the trace");
+    host_check(
+        sweep_ns >= FLIPPER_RNG_SUBGHZ_BYTES_PER_SWEEP * FLIPPER_RNG_SUBGHZ_SETTLE_US * 1000ULL,
+        "SubGHz sweep waits out RSSI settling on each frequency");
+    host_check(max_step_ns < 1000000, "no SubGHz sweep step blocks for a millisecond");
+    host_check(furi_hal_subghz_host_is_asleep(), "radio sleeps after a sweep");
+
+    // Stop request in the middle of a sweep releases the radio on the next step
+    FlipperRngSubGhzSweepPhase phase = FlipperRngSubGhzSweepIdle;
+    for(int i = 0; i <= FLIPPER_RNG_SUBGHZ_SWEEP_INTERVAL && phase == FlipperRngSubGhzSweepIdle; i++) {
+        phase = flipper_rng_subghz_sweep_step(state);
+    }
+    state->is_running = false;
+    phase = flipper_rng_subghz_sweep_step(state);
+    host_check(
+        phase == FlipperRngSubGhzSweepIdle && furi_hal_subghz_host_is_asleep(),
+        "stopping mid-sweep puts the radio back to sleep");
+
+    flipper_rng_drain_samples(state);
+    furi_hal_subghz_host_unload_trace();
+    state->entropy_sources = saved_sources;
+}
+
+static void host_file_writer(void) {
+    static const char* path = "/ext/apps_data/entropylab/writer_test.bin";
+    static uint8_t expected[200000];
+    static uint8_t actual[sizeof(expected) + 1];
+    const size_t prefix = 1000;  // Existing file content, so the first hand-off is short
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_common_remove(storage, path);
+    File* file = storage_file_alloc(storage);
+    furi_hal_random_fill_buf(expected, sizeof(expected));
+    storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    storage_file_write(file, expected, prefix);
+    storage_file_close(file);
+
+    uint64_t io_before = storage_host_io_calls();
+    FlipperRngFileWriter* writer = flipper_rng_file_writer_open(path, FLIPPER_RNG_FILE_WRITER_BUFFER_SIZE);
+    host_check(writer != NULL, "file writer opens for append");
+    if(!writer) {
+        storage_file_free(file);
+        furi_record_close(RECORD_STORAGE);
+        return;
+    }
+
+    // Worker-sized 256-byte chunks, yielding like the worker does between iterations
+    // Whatever the writer accepts must land in order
+    size_t accepted = prefix;
+    for(size_t offset = prefix; offset < sizeof(expected); offset += 256) {
+        size_t chunk = MIN((size_t)256, sizeof(expected) - offset);
+        size_t taken = flipper_rng_file_writer_write(writer, &expected[offset], chunk);
+        memmove(&expected[accepted], &expected[offset], taken);
+        accepted += taken;
+        furi_thread_yield();
+    }
+
+    FlipperRngFileWriterStats stats;
+    flipper_rng_file_writer_get_stats(writer, &stats);
+    flipper_rng_file_writer_close(writer);
+    uint64_t writes = storage_host_io_calls() - io_before;
+
+    storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING);
+    size_t read = storage_file_read(file, actual, sizeof(actual));
+    storage_file_close(file);
+    storage_file_free(file);
+    storage_common_remove(storage, path);
+    furi_record_close(RECORD_STORAGE);
+
+    size_t payload = sizeof(expected) - prefix;
+    printf(
+        "# file writer: %zu of %zu bytes accepted in %lu SD writes\n",
+        accepted - prefix,
+        payload,
+        (unsigned long)writes);
+    host_check(read == accepted && memcmp(expected, actual, accepted) == 0, "file writer output lands in order");
+    host_check(
+        stats.bytes_dropped + (accepted - prefix) == payload, "file writer accounts for every byte offered");
+    host_check(
+        writes <= payload / FLIPPER_RNG_FILE_WRITER_BUFFER_SIZE + 2, "file writer issues one SD write per buffer");
+
+    // A card that fills up mid-capture: the short writes show up as failed bytes
+    const size_t total = 3 * FLIPPER_RNG_FILE_WRITER_BUFFER_SIZE;
+    const size_t room = FLIPPER_RNG_FILE_WRITER_BUFFER_SIZE + 100;
+    storage = furi_record_open(RECORD_STORAGE);
+    storage_common_remove(storage, path);
+    writer = flipper_rng_file_writer_open(path, FLIPPER_RNG_FILE_WRITER_BUFFER_SIZE);
+    host_check(writer != NULL, "file writer opens a fresh file");
+    if(writer) {
+        storage_host_set_write_budget(room);
+        flipper_rng_file_writer_write_wait(writer, expected, total);
+        for(int i = 0; i < 2000; i++) {
+            flipper_rng_file_writer_get_stats(writer, &stats);
+            if(stats.bytes_written + stats.bytes_failed >= total) break;
+            furi_delay_ms(1);
+        }
+        flipper_rng_file_writer_close(writer);
+        storage_host_set_write_budget(UINT64_MAX);
+        host_check(
+            stats.bytes_written == room && stats.bytes_failed == total - room && stats.write_errors == 2 &&
+                stats.bytes_dropped == 0,
+            "short card writes are counted as failed bytes");
+    }
+    storage_common_remove(storage, path);
+    furi_record_close(RECORD_STORAGE);
+}
+
+// The one-byte-per-call line reader the buffered reader replaced, kept as the reference
+static bool host_read_line_bytewise(File* file, char* buffer, size_t buffer_size) {
+    size_t pos = 0;
+    uint8_t byte;
+    bool consumed = false;
+    while(storage_file_read(file, &byte, 1) == 1) {
+        consumed = true;
+        if(byte == '\n') break;
+        if(byte != '\r' && pos < buffer_size - 1) buffer[pos++] = byte;
+    }
+    buffer[pos] = '\0';
+    return consumed;
+}
+
+// Index the EFF list both ways, then check seeks, CRLF and overlong lines on a small file
+static void host_line_reader(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    static uint32_t reference[EFF_LONG_SIZE];
+    static uint32_t buffered[EFF_LONG_SIZE];
+    char line[64], expected[64];
+
+    bool opened = storage_file_open(file, PASSPHRASE_EFF_LONG_PATH, FSAM_READ, FSOM_OPEN_EXISTING);
+    host_check(opened, "EFF wordlist opens");
+    if(opened) {
+        uint64_t calls = storage_host_io_calls();
+        uint64_t start = flipper_rng_hw_get_time_ns();
+        size_t lines = 0;
+        while(lines < EFF_LONG_SIZE) {
+            reference[lines] = (uint32_t)storage_file_tell(file);
+            if(!host_read_line_bytewise(file, line, sizeof(line))) break;
+            lines++;
+        }
+        uint64_t bytewise_ns = flipper_rng_hw_get_time_ns() - start;
+        uint64_t bytewise_calls = storage_host_io_calls() - calls;
+
+        FlipperRngLineReader reader;
+        flipper_rng_line_reader_init(&reader, file);
+        calls = storage_host_io_calls();
+        start = flipper_rng_hw_get_time_ns();
+        size_t buffered_lines = 0;
+        while(buffered_lines < EFF_LONG_SIZE) {
+            buffered[buffered_lines] = flipper_rng_line_reader_tell(&reader);
+            if(!flipper_rng_line_reader_read_line(&reader, line, sizeof(line))) break;
+            buffered_lines++;
+        }
+        uint64_t buffered_ns = flipper_rng_hw_get_time_ns() - start;
+        uint64_t buffered_calls = storage_host_io_calls() - calls;
+
+        printf(
+            "# line reader: indexing %zu lines took %lu reads/%.2f ms bytewise, %lu reads/%.2f ms buffered\n",
+            lines,
+            (unsigned long)bytewise_calls,
+            bytewise_ns / 1e6,
+            (unsigned long)buffered_calls,
+            buffered_ns / 1e6);
+        host_check(
+            lines == EFF_LONG_SIZE && buffered_lines == lines &&
+                memcmp(reference, buffered, sizeof(reference)) == 0,
+            "buffered reader finds the same line offsets");
+        host_check(buffered_calls * 100 < bytewise_calls, "buffered reader makes a fraction of the storage calls");
+
+        // A seek inside the window is served without touching storage
+        flipper_rng_line_reader_seek(&reader, reference[2]);
+        flipper_rng_line_reader_read_line(&reader, line, sizeof(line));
+        calls = storage_host_io_calls();
+        bool same_window = flipper_rng_line_reader_seek(&reader, reference[5]) &&
+                           flipper_rng_line_reader_read_line(&reader, line, sizeof(line));
+        host_check(same_window && storage_host_io_calls() == calls, "seek within the window needs no reads");
+
+        // Far seeks land on the right line
+        bool far_ok = true;
+        for(size_t i = 0; i < EFF_LONG_SIZE; i += 997) {
+            storage_file_seek(file, reference[i], true);
+            host_read_line_bytewise(file, expected, sizeof(expected));
+            far_ok = far_ok && flipper_rng_line_reader_seek(&reader, reference[i]) &&
+                     flipper_rng_line_reader_read_line(&reader, line, sizeof(line)) && strcmp(line, expected) == 0;
+        }
+        host_check(far_ok, "seeks across the file return the same lines as bytewise reads");
+        storage_file_close(file);
+    }
+
+    // CRLF endings, an overlong line and a last line without a newline
+    const char* path = "/ext/apps_data/entropylab/line_reader_test.txt";
+    static char text[3 * FLIPPER_RNG_LINE_READER_WINDOW];
+    size_t length = 0;
+    length += snprintf(&text[length], sizeof(text) - length, "alpha\r\n\r\n");
+    memset(&text[length], 'x', 2 * FLIPPER_RNG_LINE_READER_WINDOW);
+    length += 2 * FLIPPER_RNG_LINE_READER_WINDOW;
+    length += snprintf(&text[length], sizeof(text) - length, "\nomega");
+    bool written = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                   storage_file_write(file, text, length) == length;
+    storage_file_close(file);
+
+    if(written && storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        FlipperRngLineReader reader;
+        flipper_rng_line_reader_init(&reader, file);
+        bool ok = flipper_rng_line_reader_read_line(&reader, line, sizeof(line)) && strcmp(line, "alpha") == 0;
+        ok = ok && flipper_rng_line_reader_read_line(&reader, line, sizeof(line)) && line[0] == '\0';
+        ok = ok && flipper_rng_line_reader_read_line(&reader, line, sizeof(line)) && strlen(line) == sizeof(line) - 1;
+        ok = ok && flipper_rng_line_reader_read_line(&reader, line, sizeof(line)) && strcmp(line, "omega") == 0;
+        ok = ok && flipper_rng_line_reader_tell(&reader) == length;
+        ok = ok && !flipper_rng_line_reader_read_line(&reader, line, sizeof(line));
+        host_check(ok, "line reader handles CRLF, overlong lines and a missing final newline");
+        storage_file_close(file);
+    } else {
+        host_check(false, "line reader test file is written");
+    }
+    storage_common_remove(storage, path);
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+// Every list decodes from the RAM arena exactly as it reads from SD, and generation does no I/O
+static void host_wordlist_arena(FlipperRngState* state) {
+    static const PassphraseListType lists[] = {PassphraseListEFFLong, PassphraseListBIP39, PassphraseListSLIP39};
+
+    for(size_t l = 0; l < COUNT_OF(lists); l++) {
+        PassphraseSDContext* arena = flipper_rng_passphrase_sd_alloc();
+        PassphraseSDContext* sd = flipper_rng_passphrase_sd_alloc();
+        sd->use_arena = false;
+        bool ok = flipper_rng_passphrase_sd_load(arena, lists[l]) &&
+                  flipper_rng_passphrase_sd_build_index(arena, NULL, NULL) &&
+                  flipper_rng_passphrase_sd_load(sd, lists[l]) &&
+                  flipper_rng_passphrase_sd_build_index(sd, NULL, NULL);
+        host_check(ok && flipper_rng_word_arena_is_ready(&arena->arena), "wordlist loads into the RAM arena");
+        if(!ok) {
+            flipper_rng_passphrase_sd_free(arena);
+            flipper_rng_passphrase_sd_free(sd);
+            continue;
+        }
+
+        size_t mismatches = 0;
+        char word[32];
+        for(uint16_t i = 0; i < arena->word_count; i++) {
+            strcpy(word, flipper_rng_passphrase_sd_get_word_indexed(sd, i));
+            const char* decoded = flipper_rng_passphrase_sd_get_word_indexed(arena, i);
+            mismatches += !decoded || strcmp(decoded, word) != 0;
+        }
+        size_t memory = flipper_rng_word_arena_memory(&arena->arena);
+        printf(
+            "# arena: %u words in %zu bytes (%zu bytes of offsets on the SD path)\n",
+            arena->word_count,
+            memory,
+            arena->word_count * sizeof(uint32_t));
+        host_check(mismatches == 0, "arena words match the SD wordlist");
+        if(lists[l] == PassphraseListEFFLong) {
+            host_check(memory <= 30 * 1024, "EFF arena fits in 30 KB");
+
+            char passphrase[256];
+            uint64_t calls = storage_host_io_calls();
+            flipper_rng_passphrase_generate_sd(state, arena, passphrase, sizeof(passphrase), 12);
+            host_check(
+                storage_host_io_calls() == calls && strlen(passphrase) > 0,
+                "passphrase generation from the arena does no storage I/O");
+        }
+
+        flipper_rng_passphrase_sd_free(arena);
+        flipper_rng_passphrase_sd_free(sd);
+    }
+}
+
+// Top the credit up to the pool size with TRNG samples
+static void host_fill_credit(FlipperRngState* state) {
+    for(int i = 0; i < 4096 && state->entropy_credit < RNG_CREDIT_MAX_BITS; i++) {
+        flipper_rng_add_entropy(state, furi_hal_random_get(), 32);
+    }
+}
+
+// Indices are drawn against credit, so draw large runs a pool's worth at a time
+static size_t host_credited_indices(FlipperRngState* state, uint16_t* indices, size_t count, uint16_t bound) {
+    const size_t run = 2000;  // 26000 bits at 13 per index, under RNG_CREDIT_MAX_BITS
+    size_t consumed = 0;
+    for(size_t done = 0; done < count; done += run) {
+        host_fill_credit(state);
+        consumed += flipper_rng_passphrase_get_random_indices(state, &indices[done], MIN(count - done, run), bound);
+    }
+    return consumed;
+}
+
+// Bounded indices: uniform for small and list-sized bounds, 4 bytes per index from one extraction
+static void host_random_indices(FlipperRngState* state) {
+    static uint16_t indices[60000];
+    uint32_t counts[6] = {0};
+    size_t consumed = host_credited_indices(state, indices, COUNT_OF(indices), 6);
+    bool in_range = true;
+    for(size_t i = 0; i < COUNT_OF(indices); i++) {
+        in_range = in_range && indices[i] < 6;
+        if(indices[i] < 6) counts[indices[i]]++;
+    }
+    double chi = 0;
+    for(size_t i = 0; i < 6; i++) {
+        double expected = COUNT_OF(indices) / 6.0;
+        chi += (counts[i] - expected) * (counts[i] - expected) / expected;
+    }
+    host_check(in_range, "bounded indices stay below the bound");
+    host_check(chi < 20.5, "bounded indices are uniform (chi-square, 5 dof)");
+    host_check(consumed == COUNT_OF(indices) * 4, "small bounds never reject a draw");
+
+    // Top half vs bottom half of the EFF list, and the last index is reachable
+    size_t high = 0;
+    bool last_seen = false;
+    host_credited_indices(state, indices, COUNT_OF(indices), EFF_LONG_SIZE);
+    for(size_t i = 0; i < COUNT_OF(indices); i++) {
+        high += indices[i] >= EFF_LONG_SIZE / 2;
+        last_seen = last_seen || indices[i] == EFF_LONG_SIZE - 1;
+    }
+    host_check(high > 29000 && high < 31000, "EFF-sized indices split evenly");
+    host_check(last_seen, "largest index is reachable");
+
+    uint16_t single = UINT16_MAX;
+    host_check(
+        flipper_rng_passphrase_get_random_index(state, 1, &single) && single == 0,
+        "bound of one always gives zero");
+
+    host_fill_credit(state);
+    uint64_t generated = state->bytes_generated;
+    consumed = flipper_rng_passphrase_get_random_indices(state, indices, PASSPHRASE_MAX_WORDS, EFF_LONG_SIZE);
+    printf("# %d-word passphrase indices: %zu random bytes\n", PASSPHRASE_MAX_WORDS, consumed);
+    host_check(
+        state->bytes_generated - generated == consumed && consumed >= PASSPHRASE_MAX_WORDS * 4,
+        "consumed bytes match what was extracted");
+}
+
+typedef struct {
+    char* text;
+    size_t length;
+    size_t capacity;
+    size_t writes;
+} HostBulkCapture;
+
+static void host_bulk_capture(const uint8_t* data, size_t length, void* context) {
+    HostBulkCapture* capture = context;
+    if(capture->length + length < capture->capacity) {
+        memcpy(&capture->text[capture->length], data, length);
+        capture->length += length;
+        capture->text[capture->length] = '\0';
+    }
+    capture->writes++;
+}
+
+static int host_compare_words(const void* a, const void* b) {
+    return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+// Bulk mode: every line is a full passphrase of list words, keys have the right length and alphabet
+static void host_bulk_generation(FlipperRngApp* app) {
+    FlipperRngState* state = app->state;
+    static char text[256 * 1024];
+    static char list_words[EFF_LONG_SIZE][16];
+    static const char* sorted[EFF_LONG_SIZE];
+    HostBulkCapture capture = {text, 0, sizeof(text), 0};
+
+    for(int arena = 1; arena >= 0; arena--) {
+        PassphraseSDContext* ctx = flipper_rng_passphrase_sd_alloc();
+        ctx->use_arena = arena;
+        bool loaded = flipper_rng_passphrase_sd_load(ctx, PassphraseListEFFLong) &&
+                      flipper_rng_passphrase_sd_build_index(ctx, NULL, NULL);
+        host_check(loaded, "bulk: wordlist loads");
+        if(!loaded) {
+            flipper_rng_passphrase_sd_free(ctx);
+            continue;
+        }
+        for(uint16_t i = 0; i < EFF_LONG_SIZE; i++) {
+            strlcpy(list_words[i], flipper_rng_passphrase_sd_get_word_indexed(ctx, i), sizeof(list_words[i]));
+            sorted[i] = list_words[i];
+        }
+        qsort(sorted, EFF_LONG_SIZE, sizeof(sorted[0]), host_compare_words);
+
+        FlipperRngBulkConfig config;
+        flipper_rng_bulk_config_default(&config);
+        config.count = 2000;
+        config.wait_for_credit = true;  // Far more than a pool's credit, so the worker has to keep up
+        capture.length = 0;
+        capture.writes = 0;
+        FlipperRngBulkStats stats;
+        entropylab_host_worker_start(app);
+        uint64_t calls = storage_host_io_calls();
+        bool ok = flipper_rng_bulk_generate(state, ctx, &config, host_bulk_capture, &capture, &stats);
+        uint64_t reads = storage_host_io_calls() - calls;
+        entropylab_host_worker_stop(app);
+
+        size_t lines = 0;
+        bool words_ok = true;
+        for(char* line = strtok(text, "\n"); line; line = strtok(NULL, "\n")) {
+            size_t words = 0;
+            for(char* word = line; word; words++) {
+                char* space = strchr(word, ' ');
+                if(space) *space = '\0';
+                words_ok = words_ok && bsearch(&word, sorted, EFF_LONG_SIZE, sizeof(sorted[0]), host_compare_words);
+                word = space ? space + 1 : NULL;
+            }
+            words_ok = words_ok && words == config.num_words;
+            lines++;
+        }
+        printf(
+            "# bulk (%s): %lu passphrases, %lu bytes in %zu writes, %llu storage reads, %lu/s\n",
+            arena ? "arena" : "SD offsets",
+            (unsigned long)stats.generated,
+            (unsigned long)stats.bytes_out,
+            capture.writes,
+            (unsigned long long)reads,
+            (unsigned long)stats.per_sec);
+        host_check(ok && stats.generated == config.count && lines == config.count, "bulk writes one line per passphrase");
+        host_check(words_ok, "bulk passphrases use only list words");
+        host_check(stats.bytes_out == capture.length && capture.writes < lines / 4, "bulk output is chunked");
+        host_check(ctx->cache_size == 0, "bulk wipes the word cache when done");
+        flipper_rng_passphrase_sd_free(ctx);
+    }
+
+    FlipperRngBulkFormat formats[] = {FlipperRngBulkHex, FlipperRngBulkBase32};
+    const char* alphabets[] = {"0123456789abcdef", "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567"};
+    size_t widths[] = {64, 52};
+    for(size_t f = 0; f < COUNT_OF(formats); f++) {
+        FlipperRngBulkConfig config;
+        flipper_rng_bulk_config_default(&config);
+        config.format = formats[f];
+        config.count = 100;
+        config.wait_for_credit = true;  // Keys debit every bit, 25600 for the run
+        capture.length = 0;
+        FlipperRngBulkStats stats;
+        entropylab_host_worker_start(app);
+        bool ok = flipper_rng_bulk_generate(state, NULL, &config, host_bulk_capture, &capture, &stats);
+        entropylab_host_worker_stop(app);
+        bool shape = capture.length == config.count * (widths[f] + 1);
+        for(size_t i = 0; shape && i < capture.length; i++) {
+            bool newline = (i % (widths[f] + 1)) == widths[f];
+            shape = newline ? text[i] == '\n' : strchr(alphabets[f], text[i]) != NULL;
+        }
+        host_check(ok && shape, "bulk keys have the expected length and alphabet");
+    }
+
+    // Without the wait, keys are only made against credit that is already there
+    FlipperRngBulkConfig keys;
+    flipper_rng_bulk_config_default(&keys);
+    keys.format = FlipperRngBulkHex;
+    FlipperRngBulkStats key_stats;
+    state->entropy_credit = 0;
+    host_check(
+        !flipper_rng_bulk_generate(state, NULL, &keys, host_bulk_capture, &capture, &key_stats) &&
+            key_stats.generated == 0,
+        "bulk keys stop when the credit runs out");
+
+    // Cancel stops before the next batch
+    atomic_bool cancel;
+    atomic_init(&cancel, true);
+    FlipperRngBulkConfig config;
+    flipper_rng_bulk_config_default(&config);
+    config.format = FlipperRngBulkHex;
+    config.cancel = &cancel;
+    FlipperRngBulkStats stats;
+    flipper_rng_bulk_generate(state, NULL, &config, host_bulk_capture, &capture, &stats);
+    host_check(stats.generated == 0, "bulk honours cancel");
+}
+
+// Word cache: repeat lookups hit without I/O, wiping clears every slot
+static void host_word_cache(void) {
+    PassphraseSDContext* ctx = flipper_rng_passphrase_sd_alloc();
+    ctx->use_arena = false;
+    bool ok = flipper_rng_passphrase_sd_load(ctx, PassphraseListEFFLong) &&
+              flipper_rng_passphrase_sd_build_index(ctx, NULL, NULL);
+    host_check(ok && ctx->word_cache, "word cache slab is allocated");
+    if(ok && ctx->word_cache) {
+        char first[32];
+        strcpy(first, flipper_rng_passphrase_sd_get_word_indexed(ctx, 1234));
+        uint64_t calls = storage_host_io_calls();
+        const char* again = flipper_rng_passphrase_sd_get_word_indexed(ctx, 1234);
+        host_check(
+            ctx->cache_hits == 1 && ctx->cache_misses == 1 && strcmp(again, first) == 0 &&
+                storage_host_io_calls() == calls,
+            "repeat lookup is a cache hit with no storage I/O");
+
+        // Same slot, different word: replaced, not confused
+        const char* other = flipper_rng_passphrase_sd_get_word_indexed(ctx, 1234 + PASSPHRASE_CACHE_CAPACITY);
+        host_check(ctx->cache_misses == 2 && other && strcmp(other, first) != 0, "colliding index replaces the slot");
+
+        for(uint16_t i = 0; i < 4 * PASSPHRASE_CACHE_CAPACITY; i++) {
+            flipper_rng_passphrase_sd_get_word_indexed(ctx, i % 100);
+        }
+        host_check(
+            ctx->cache_hits + ctx->cache_misses == 3 + 4 * PASSPHRASE_CACHE_CAPACITY, "every lookup is counted");
+        host_check(ctx->cache_size == PASSPHRASE_CACHE_CAPACITY, "cache fills every slot");
+
+        flipper_rng_passphrase_sd_wipe_cache(ctx);
+        bool zeroed = true;
+        for(size_t i = 0; i < PASSPHRASE_CACHE_CAPACITY * sizeof(ctx->current_word); i++) {
+            zeroed = zeroed && ctx->word_cache[i] == 0;
+        }
+        host_check(zeroed && ctx->cache_size == 0 && ctx->current_word[0] == '\0', "wipe clears cached words");
+        uint32_t misses = ctx->cache_misses;
+        flipper_rng_passphrase_sd_get_word_indexed(ctx, 1234);
+        host_check(ctx->cache_misses == misses + 1, "lookup after a wipe misses");
+    }
+    flipper_rng_passphrase_sd_free(ctx);
+}
+
+// SD fallback index: first build scans and saves the .idx sidecar, later builds load it in one read
+static void host_passphrase_index(void) {
+    const char* idx_path = "/ext/apps_data/entropylab/eff_large_wordlist.txt" PASSPHRASE_INDEX_SUFFIX;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_common_remove(storage, idx_path);
+
+    PassphraseSDContext* ctx = flipper_rng_passphrase_sd_alloc();
+    ctx->use_arena = false;
+    uint64_t calls = storage_host_io_calls();
+    bool built = flipper_rng_passphrase_sd_load(ctx, PassphraseListEFFLong) &&
+                 flipper_rng_passphrase_sd_build_index(ctx, NULL, NULL);
+    uint64_t scan_calls = storage_host_io_calls() - calls;
+    host_check(built, "wordlist scan builds the index");
+    host_check(storage_common_stat(storage, idx_path, NULL) == FSE_OK, "scan saves the .idx sidecar");
+
+    PassphraseSDContext* cached = flipper_rng_passphrase_sd_alloc();
+    cached->use_arena = false;
+    calls = storage_host_io_calls();
+    bool loaded = flipper_rng_passphrase_sd_load(cached, PassphraseListEFFLong) &&
+                  flipper_rng_passphrase_sd_build_index(cached, NULL, NULL);
+    uint64_t load_calls = storage_host_io_calls() - calls;
+    printf("# wordlist index: %lu storage calls to scan, %lu to load the sidecar\n",
+        (unsigned long)scan_calls, (unsigned long)load_calls);
+    host_check(loaded && cached->is_indexed, "sidecar index loads");
+    host_check(load_calls < 20, "sidecar load takes a handful of storage calls");
+    host_check(
+        built && loaded &&
+            memcmp(ctx->line_offsets, cached->line_offsets, ctx->word_count * sizeof(uint32_t)) == 0,
+        "sidecar offsets match the scan");
+    flipper_rng_passphrase_sd_free(cached);
+
+    // Flip one offset: the checksum rejects it and the next build rescans and rewrites it
+    File* file = storage_file_alloc(storage);
+    uint32_t bogus = 1;
+    bool tampered = storage_file_open(file, idx_path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING) &&
+                    storage_file_seek(file, sizeof(PassphraseIndexHeader) + 100 * sizeof(uint32_t), true) &&
+                    storage_file_write(file, &bogus, sizeof(bogus)) == sizeof(bogus);
+    storage_file_close(file);
+    storage_file_free(file);
+    host_check(tampered, "sidecar can be modified");
+
+    PassphraseSDContext* rebuilt = flipper_rng_passphrase_sd_alloc();
+    rebuilt->use_arena = false;
+    calls = storage_host_io_calls();
+    bool ok = flipper_rng_passphrase_sd_load(rebuilt, PassphraseListEFFLong) &&
+              flipper_rng_passphrase_sd_build_index(rebuilt, NULL, NULL);
+    host_check(ok && storage_host_io_calls() - calls > scan_calls / 2, "corrupt sidecar is ignored and the list rescanned");
+    host_check(
+        ok && memcmp(ctx->line_offsets, rebuilt->line_offsets, ctx->word_count * sizeof(uint32_t)) == 0,
+        "rescan after a corrupt sidecar gives the same offsets");
+    flipper_rng_passphrase_sd_free(rebuilt);
+
+    flipper_rng_passphrase_sd_free(ctx);
+    furi_record_close(RECORD_STORAGE);
+}
+
+typedef struct {
+    FlipperRngState* state;
+    uint32_t bits;
+    bool debited;
+    atomic_bool done;
+} HostCreditWaiter;
+
+static int32_t host_credit_waiter(void* context) {
+    HostCreditWaiter* waiter = context;
+    waiter->debited = flipper_rng_debit_entropy_wait(waiter->state, waiter->bits, 2000, NULL);
+    atomic_store(&waiter->done, true);
+    return 0;
+}
+
+// Sources add credit, credited output spends it, and readiness follows the balance
+static void host_credit_accounting(FlipperRngApp* app) {
+    FlipperRngState* state = app->state;
+    state->entropy_credit = 0;
+    state->entropy_ready = false;
+    flipper_rng_init_health(state);
+
+    FlipperRngSample batch[8];
+    for(size_t i = 0; i < COUNT_OF(batch); i++) {
+        batch[i].sample = furi_hal_random_get();
+        batch[i].bits = 32;
+        batch[i].source = FlipperRngSourceHardwareRNG;
+    }
+    flipper_rng_add_entropy_batch(state, batch, 4);
+    host_check(state->entropy_credit == 128 && !state->entropy_ready, "credit accumulates below the ready mark");
+    flipper_rng_add_entropy_batch(state, &batch[4], 4);
+    host_check(state->entropy_credit == RNG_CREDIT_READY_BITS && state->entropy_ready, "ready at 256 credited bits");
+
+    // Quarantined samples add nothing
+    for(size_t i = 0; i < COUNT_OF(batch); i++) {
+        batch[i].sample = 0x1234;
+        batch[i].bits = 8;
+        batch[i].source = FlipperRngSourceInfrared;
+    }
+    flipper_rng_add_entropy_batch(state, batch, COUNT_OF(batch));
+    host_check(state->entropy_credit == RNG_CREDIT_READY_BITS + 3 * 8, "only health-tested bits are credited");
+    flipper_rng_init_health(state);
+
+    host_check(
+        !flipper_rng_debit_entropy_wait(state, RNG_CREDIT_MAX_BITS, 1, NULL) && state->entropy_claimed == 0,
+        "a debit never takes more than the credit");
+    host_check(
+        flipper_rng_debit_entropy_wait(state, 24, 0, NULL) && state->entropy_credit == RNG_CREDIT_READY_BITS,
+        "streaming spends credit above the ready reserve");
+    host_check(!flipper_rng_debit_entropy_wait(state, 8, 0, NULL), "streaming leaves the ready reserve");
+
+    uint16_t indices[6];
+    flipper_rng_passphrase_get_random_indices(state, indices, COUNT_OF(indices), EFF_LONG_SIZE);
+    host_check(state->entropy_credit == RNG_CREDIT_READY_BITS - 6 * 13 && !state->entropy_ready, "passphrase indices debit 13 bits each");
+    host_check(
+        flipper_rng_debit_entropy_wait(state, RNG_CREDIT_READY_BITS - 6 * 13, 1, NULL) && state->entropy_credit == 0,
+        "a waiting debit may spend the reserve");
+
+    for(int i = 0; i < 2000; i++) flipper_rng_add_entropy(state, furi_hal_random_get(), 32);
+    host_check(state->entropy_credit == RNG_CREDIT_MAX_BITS, "credit is capped at the pool size");
+    state->entropy_credit = 0;
+    host_check(
+        !flipper_rng_debit_entropy_wait(state, 1, 5, NULL) && state->entropy_claimed == 0,
+        "waiting without sources times out and drops its claim");
+
+    // A waiter's claim keeps streaming output off the credit it is waiting for
+    HostCreditWaiter waiter = {.state = state, .bits = 1024};
+    atomic_init(&waiter.done, false);
+    FuriThread* thread = furi_thread_alloc_ex("HostCreditWaiter", 1024, host_credit_waiter, &waiter);
+    furi_thread_start(thread);
+    uint32_t streamed = 0;
+    while(!atomic_load(&waiter.done)) {
+        if(state->entropy_claimed == waiter.bits && state->entropy_credit < waiter.bits) {
+            flipper_rng_add_entropy(state, furi_hal_random_get(), 32);
+        }
+        streamed += flipper_rng_debit_entropy_wait(state, 32, 0, NULL);
+        furi_delay_ms(1);
+    }
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+    host_check(waiter.debited && streamed == 0, "streaming cannot take credit a waiter has claimed");
+    uint16_t index;
+    host_check(!flipper_rng_passphrase_get_random_index(state, EFF_LONG_SIZE, &index), "no credit means no index, not index 0");
+
+    // Bulk output waiting on credit can still be cancelled
+    atomic_bool cancel;
+    atomic_init(&cancel, true);
+    FlipperRngBulkConfig config;
+    flipper_rng_bulk_config_default(&config);
+    config.format = FlipperRngBulkHex;
+    config.cancel = &cancel;
+    config.wait_for_credit = true;
+    FlipperRngBulkStats stats;
+    host_check(
+        flipper_rng_bulk_generate(state, NULL, &config, host_bulk_capture, NULL, &stats) && stats.generated == 0,
+        "bulk waiting for credit honours cancel");
+
+    // Start-up latency: the worker resets credit and readiness, then the TRNG fills it
+    uint32_t start = furi_get_tick();
+    entropylab_host_worker_start(app);
+    bool ready = flipper_rng_debit_entropy_wait(state, RNG_CREDIT_READY_BITS, 2000, NULL);
+    uint32_t latency = furi_get_tick() - start;
+    entropylab_host_worker_stop(app);
+    printf("# worker start to %d credited bits: %lu ms\n", RNG_CREDIT_READY_BITS, (unsigned long)latency);
+    host_check(ready && latency < 2000, "entropy is ready well before the old 2 s timer");
+}
+
+typedef struct {
+    uint8_t payload[8 * FLIPPER_RNG_FRAME_PAYLOAD];
+    size_t length;
+    uint8_t flags;  // OR of every frame's flags
+    uint32_t unhealthy_frames;
+} HostFrameCapture;
+
+static void host_frame_capture(const FlipperRngFrame* frame, void* context) {
+    HostFrameCapture* capture = context;
+    size_t take = MIN((size_t)frame->length, sizeof(capture->payload) - capture->length);
+    memcpy(&capture->payload[capture->length], frame->payload, take);
+    capture->length += take;
+    capture->flags |= frame->flags;
+    if(frame->flags & FLIPPER_RNG_FRAME_FLAGS_UNHEALTHY) capture->unhealthy_frames++;
+}
+
+// Run the worker in framed UART mode into a pipe and decode what comes out
+static void host_framed_uart_run(FlipperRngApp* app, FlipperRngFrameDecoder* decoder, HostFrameCapture* capture) {
+    static uint8_t stream[64 * 1024];
+    int fds[2];
+    furi_check(pipe(fds) == 0);
+
+    furi_hal_serial_host_attach_fd(FuriHalSerialIdUsart, fds[1]);
+    app->state->output_mode = OutputModeUART;
+    app->state->uart_format = UartFormatFramed;
+    app->state->serial_handle = furi_hal_serial_control_acquire(FuriHalSerialIdUsart);
+    furi_hal_serial_init(app->state->serial_handle, 9600);  // The worker applies uart_baud itself
+
+    // Short enough that the output fits in the pipe without a reader
+    entropylab_host_worker_start(app);
+    furi_delay_ms(150);
+    entropylab_host_worker_stop(app);
+
+    furi_hal_serial_deinit(app->state->serial_handle);
+    furi_hal_serial_control_release(app->state->serial_handle);
+    app->state->serial_handle = NULL;
+    app->state->output_mode = OutputModeNone;
+    app->state->uart_format = UartFormatRaw;
+    furi_hal_serial_host_attach_fd(FuriHalSerialIdUsart, -1);
+    close(fds[1]);
+
+    flipper_rng_frame_decoder_init(decoder);
+    memset(capture, 0, sizeof(HostFrameCapture));
+    ssize_t got;
+    while((got = read(fds[0], stream, sizeof(stream))) > 0) {
+        flipper_rng_frame_decoder_feed(decoder, stream, (size_t)got, host_frame_capture, capture);
+    }
+    close(fds[0]);
+}
+
+// Frame round trip, gap and corruption recovery, then the worker's framed UART output
+static void host_frames(FlipperRngApp* app) {
+    FlipperRngState* state = app->state;
+    host_check(flipper_rng_crc32(0, (const uint8_t*)"123456789", 9) == 0xCBF43926, "CRC-32 check value");
+
+    // Junk, frame 0, frame 1 corrupted, frame 2, frame 3 flagged, fed in odd-sized pieces
+    static uint8_t frames[4][FLIPPER_RNG_FRAME_MAX_SIZE];
+    static uint8_t stream[4 * FLIPPER_RNG_FRAME_MAX_SIZE + 16];
+    static const uint16_t lengths[4] = {FLIPPER_RNG_FRAME_PAYLOAD, 100, FLIPPER_RNG_FRAME_PAYLOAD, 1};
+    size_t stream_len = 0;
+    for(size_t i = 0; i < 5; i++) stream[stream_len++] = (i & 1) ? FLIPPER_RNG_FRAME_MAGIC0 : 0x00;
+    for(uint16_t i = 0; i < 4; i++) {
+        furi_hal_random_fill_buf(&frames[i][FLIPPER_RNG_FRAME_HEADER_SIZE], lengths[i]);
+        uint8_t flags = i == 3 ? FlipperRngFrameFlagHealthFailed : 0;
+        size_t size = flipper_rng_frame_encode(frames[i], 1000 + i, flags, lengths[i]);
+        memcpy(&stream[stream_len], frames[i], size);
+        if(i == 1) stream[stream_len + FLIPPER_RNG_FRAME_HEADER_SIZE + 50] ^= 0x01;
+        stream_len += size;
+    }
+
+    FlipperRngFrameDecoder decoder;
+    HostFrameCapture* capture = malloc(sizeof(HostFrameCapture));
+    flipper_rng_frame_decoder_init(&decoder);
+    memset(capture, 0, sizeof(HostFrameCapture));
+    for(size_t offset = 0; offset < stream_len; offset += 7) {
+        flipper_rng_frame_decoder_feed(
+            &decoder, &stream[offset], MIN((size_t)7, stream_len - offset), host_frame_capture, capture);
+    }
+    const uint8_t* payload = capture->payload;
+    bool intact = capture->length == (size_t)(lengths[0] + lengths[2] + lengths[3]) &&
+                  memcmp(payload, &frames[0][FLIPPER_RNG_FRAME_HEADER_SIZE], lengths[0]) == 0 &&
+                  memcmp(&payload[lengths[0]], &frames[2][FLIPPER_RNG_FRAME_HEADER_SIZE], lengths[2]) == 0 &&
+                  memcmp(&payload[lengths[0] + lengths[2]], &frames[3][FLIPPER_RNG_FRAME_HEADER_SIZE], lengths[3]) == 0;
+    host_check(decoder.frames == 3 && intact, "decoder returns every intact frame's payload");
+    host_check(decoder.crc_errors >= 1 && decoder.lost_frames == 1, "corrupted frame is rejected and counted as lost");
+    host_check(decoder.flagged_frames == 1 && capture->unhealthy_frames == 1, "health flags reach the decoder");
+    host_check(decoder.fill == 0, "decoder resyncs without holding bytes back");
+    host_check(
+        (FLIPPER_RNG_FRAME_MAX_SIZE - FLIPPER_RNG_FRAME_PAYLOAD) * 100 < 3 * FLIPPER_RNG_FRAME_PAYLOAD,
+        "frame overhead under 3%");
+
+    // Healthy sources: clean, contiguous, unflagged frames
+    flipper_rng_init_health(state);
+    host_framed_uart_run(app, &decoder, capture);
+    printf(
+        "# framed UART: %lu frames, %lu payload bytes\n",
+        (unsigned long)decoder.frames,
+        (unsigned long)decoder.payload_bytes);
+    host_check(
+        decoder.frames > 0 && decoder.crc_errors == 0 && decoder.lost_frames == 0 && decoder.discarded_bytes == 0,
+        "worker framed UART output decodes cleanly");
+    host_check(capture->unhealthy_frames == 0, "healthy sources produce unflagged frames");
+
+    // A quarantined source marks every frame produced while it lasts
+    state->health[FlipperRngSourceInfrared].quarantine = FLIPPER_RNG_HEALTH_QUARANTINE;
+    host_framed_uart_run(app, &decoder, capture);
+    host_check(
+        decoder.frames > 0 && capture->unhealthy_frames == decoder.frames &&
+            (capture->flags & FlipperRngFrameFlagQuarantined),
+        "frames produced during a quarantine are flagged");
+    flipper_rng_init_health(state);
+    free(capture);
+}
+
+static uint64_t host_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ull + (uint64_t)ts.tv_nsec / 1000;
+}
+
+// Run the worker in raw UART mode into a pipe paced at baud, TX stats left in the state
+// Returns the baud rate the port ran at
+static uint32_t host_paced_uart_run(FlipperRngApp* app, uint32_t baud, uint32_t duration_ms) {
+    int fds[2];
+    furi_check(pipe(fds) == 0);
+    furi_hal_serial_host_attach_fd(FuriHalSerialIdUsart, fds[1]);
+    furi_hal_serial_host_set_paced(FuriHalSerialIdUsart, true);
+    app->state->output_mode = OutputModeUART;
+    app->state->uart_baud = baud;
+    app->state->serial_handle = furi_hal_serial_control_acquire(FuriHalSerialIdUsart);
+    furi_hal_serial_init(app->state->serial_handle, 9600);  // The worker applies uart_baud itself
+
+    // Short enough that the output fits in the pipe without a reader
+    entropylab_host_worker_start(app);
+    furi_delay_ms(duration_ms);
+    entropylab_host_worker_stop(app);
+    uint32_t line_baud = furi_hal_serial_host_get_baud(FuriHalSerialIdUsart);
+
+    furi_hal_serial_deinit(app->state->serial_handle);
+    furi_hal_serial_control_release(app->state->serial_handle);
+    app->state->serial_handle = NULL;
+    app->state->output_mode = OutputModeNone;
+    app->state->uart_baud = 115200;
+    furi_hal_serial_host_set_paced(FuriHalSerialIdUsart, false);
+    furi_hal_serial_host_attach_fd(FuriHalSerialIdUsart, -1);
+    close(fds[0]);
+    close(fds[1]);
+    return line_baud;
+}
+
+// Double-buffered TX against a serial port paced like the real USART
+static void host_uart_writer(FlipperRngApp* app) {
+    static uint8_t expected[16 * 1024];
+    static uint8_t actual[sizeof(expected) + 1];
+    int fds[2];
+    furi_check(pipe(fds) == 0);
+    furi_hal_serial_host_attach_fd(FuriHalSerialIdUsart, fds[1]);
+    furi_hal_serial_host_set_paced(FuriHalSerialIdUsart, true);
+    FuriHalSerialHandle* handle = furi_hal_serial_control_acquire(FuriHalSerialIdUsart);
+    furi_hal_serial_init(handle, 460800);
+
+    // A whole buffer takes ~22 ms on the wire; handing it off must not
+    FlipperRngUartWriter* writer = flipper_rng_uart_writer_open(handle, FLIPPER_RNG_UART_WRITER_BUFFER_SIZE);
+    furi_hal_random_fill_buf(expected, sizeof(expected));
+    uint64_t start = host_now_us();
+    flipper_rng_uart_writer_write(writer, expected, FLIPPER_RNG_UART_WRITER_BUFFER_SIZE);
+    uint64_t handoff_us = host_now_us() - start;
+    host_check(handoff_us < 5000, "UART chunk is queued without waiting for the line");
+
+    // Worker-sized 128-byte chunks, far faster than the line drains them
+    for(size_t offset = FLIPPER_RNG_UART_WRITER_BUFFER_SIZE; offset < sizeof(expected); offset += 128) {
+        flipper_rng_uart_writer_write(writer, &expected[offset], 128);
+    }
+    FlipperRngUartWriterStats stats;
+    flipper_rng_uart_writer_get_stats(writer, &stats);
+    flipper_rng_uart_writer_close(writer);
+
+    furi_hal_serial_deinit(handle);
+    furi_hal_serial_control_release(handle);
+    furi_hal_serial_host_set_paced(FuriHalSerialIdUsart, false);
+    furi_hal_serial_host_attach_fd(FuriHalSerialIdUsart, -1);
+    close(fds[1]);
+    size_t read_total = 0;
+    ssize_t got;
+    while((got = read(fds[0], &actual[read_total], sizeof(actual) - read_total)) > 0) read_total += (size_t)got;
+    close(fds[0]);
+
+    host_check(
+        read_total == sizeof(expected) && memcmp(expected, actual, sizeof(expected)) == 0,
+        "UART writer output arrives complete and in order");
+    host_check(stats.stall_ms > 0 && stats.stall_percent > 0, "UART writer reports time waiting on the line");
+
+    // The worker's achieved rate follows the baud rate, and the stall share says why
+    uint32_t slow_baud = host_paced_uart_run(app, 115200, 300);
+    uint32_t slow_bps = app->state->uart_tx_bps;
+    uint8_t slow_stall = app->state->uart_tx_stall_percent;
+    uint32_t fast_baud = host_paced_uart_run(app, 921600, 300);
+    uint32_t fast_bps = app->state->uart_tx_bps;
+    printf(
+        "# UART TX: %lu B/s (%u%% stalled) at 115200, %lu B/s (%u%% stalled) at 921600\n",
+        (unsigned long)slow_bps,
+        slow_stall,
+        (unsigned long)fast_bps,
+        app->state->uart_tx_stall_percent);
+    host_check(slow_bps > 9000 && slow_bps <= 11520, "UART at 115200 runs at line rate");
+    host_check(slow_stall > 25, "UART at 115200 shows the line as the bottleneck");
+    host_check(slow_baud == 115200 && fast_baud == 921600, "the worker runs the UART at the configured baud rate");
+}
+
+// The device side of a pull-mode pty: master to the serial shim, slave left open and raw
+static int host_pull_open(FlipperRngApp* app, int* slave_fd, char* slave_path, size_t slave_path_size) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    furi_check(master >= 0 && grantpt(master) == 0 && unlockpt(master) == 0);
+    furi_check(ptsname_r(master, slave_path, slave_path_size) == 0);
+    *slave_fd = open(slave_path, O_RDWR | O_NOCTTY);
+    furi_check(*slave_fd >= 0);
+    struct termios tio;
+    tcgetattr(*slave_fd, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(*slave_fd, TCSANOW, &tio);
+
+    furi_hal_serial_host_attach_fd(FuriHalSerialIdUsart, master);
+    app->state->output_mode = OutputModeUART;
+    app->state->uart_format = UartFormatPull;
+    app->state->serial_handle = furi_hal_serial_control_acquire(FuriHalSerialIdUsart);
+    furi_hal_serial_init(app->state->serial_handle, 115200);
+    return master;
+}
+
+static void host_pull_close(FlipperRngApp* app, int master, int slave_fd) {
+    furi_hal_serial_deinit(app->state->serial_handle);
+    furi_hal_serial_control_release(app->state->serial_handle);
+    app->state->serial_handle = NULL;
+    app->state->output_mode = OutputModeNone;
+    app->state->uart_format = UartFormatRaw;
+    furi_hal_serial_host_attach_fd(FuriHalSerialIdUsart, -1);
+    close(slave_fd);
+    close(master);
+}
+
+// Pull mode over a pty loopback: served from the reservoir, idle in between, bad requests refused
+typedef struct {
+    uint8_t flags[64];
+    size_t frames;
+} HostPullFlags;
+
+static void host_pull_flags_send(const uint8_t* frame, size_t size, void* context) {
+    UNUSED(size);
+    HostPullFlags* sent = context;
+    if(sent->frames < COUNT_OF(sent->flags)) sent->flags[sent->frames++] = frame[6];
+}
+
+static void host_pull_request(FlipperRngPullServer* server, uint16_t count, HostPullFlags* sent) {
+    uint8_t request[FLIPPER_RNG_PULL_REQUEST_SIZE];
+    size_t size = flipper_rng_pull_encode_request(request, 0, FlipperRngPullCommandRead, count);
+    flipper_rng_pull_server_receive(server, request, size);
+    flipper_rng_pull_server_serve(server, host_pull_flags_send, sent);
+}
+
+// A frame's flags are those raised while its own bytes were made, not whatever was pending when it went out
+static void host_pull_flags(void) {
+    static FlipperRngPullServer server;
+    uint8_t data[100] = {0};
+    HostPullFlags sent = {0};
+    flipper_rng_pull_server_init(&server);
+    flipper_rng_pull_server_fill(&server, data, 100, 0);
+    flipper_rng_pull_server_fill(&server, data, 100, FlipperRngFrameFlagHealthFailed);
+    flipper_rng_pull_server_fill(&server, data, 100, 0);
+    host_pull_request(&server, 100, &sent);
+    host_pull_request(&server, 150, &sent);
+    host_pull_request(&server, 50, &sent);
+    host_check(
+        sent.frames == 3 && sent.flags[0] == 0 && sent.flags[1] == FlipperRngFrameFlagHealthFailed && sent.flags[2] == 0,
+        "pull frames carry the flags of the reservoir bytes they hold");
+
+    // More flag changes than runs: the newest run absorbs the rest and keeps their flags
+    memset(&sent, 0, sizeof(sent));
+    for(int i = 0; i < 48; i++) {
+        flipper_rng_pull_server_fill(&server, data, 8, (i & 1) ? FlipperRngFrameFlagQuarantined : 0);
+    }
+    bool covered = true;
+    for(int i = 0; i < 48; i++) {
+        host_pull_request(&server, 8, &sent);
+        covered &= !(i & 1) || (sent.flags[i] & FlipperRngFrameFlagQuarantined);
+    }
+    host_check(covered && server.reservoir_fill == 0 && server.segment_count == 0, "merged reservoir runs lose no flags");
+}
+
+static void host_pull_mode(FlipperRngApp* app) {
+    FlipperRngState* state = app->state;
+    static uint8_t bytes[3 * FLIPPER_RNG_PULL_RESERVOIR];
+    char slave_path[64];
+    int slave_fd;
+    int master = host_pull_open(app, &slave_fd, slave_path, sizeof(slave_path));
+    EntropyLabPullClient* client = entropylab_pull_client_open(slave_path, 115200);
+    host_check(client != NULL, "pull client opens the pty");
+    if(!client) {
+        host_pull_close(app, master, slave_fd);
+        return;
+    }
+
+    // Nothing is sent until asked for, and the worker parks once the reservoir is full
+    // With a trace loaded the first SubGHz sweep is still running when it does
+    bool trace = furi_hal_subghz_host_load_trace(HOST_SUBGHZ_TRACE);
+    flipper_rng_init_health(state);
+    entropylab_host_worker_start(app);
+    furi_delay_ms(200);
+    struct pollfd pfd = {.fd = slave_fd, .events = POLLIN};
+    host_check(poll(&pfd, 1, 0) == 0, "pull mode sends nothing unrequested");
+    uint32_t hw_bits = state->bits_from_hw_rng;
+    furi_delay_ms(150);
+    host_check(state->bits_from_hw_rng == hw_bits, "pull mode stops collecting once the reservoir is full");
+    host_check(trace && furi_hal_subghz_host_is_asleep(), "a parked pull worker gives the radio back");
+
+    // Producers keep queueing while the worker is parked; it still drains them
+    uint32_t ir_bits = state->bits_from_infrared;
+    uint32_t ir_dropped = flipper_rng_ring_dropped(&state->sample_rings[FlipperRngSourceInfrared]);
+    for(int i = 0; i < 2 * FLIPPER_RNG_RING_SIZE; i++) {
+        flipper_rng_push_sample(state, FlipperRngSourceInfrared, furi_hal_random_get(), 8);
+        if(i % 32 == 31) furi_delay_ms(2 * 50);
+    }
+    host_check(
+        state->bits_from_infrared > ir_bits &&
+            flipper_rng_ring_dropped(&state->sample_rings[FlipperRngSourceInfrared]) == ir_dropped,
+        "a parked pull worker still drains the sample rings");
+
+    uint8_t flags = 0;
+    uint64_t start = host_now_us();
+    size_t got = entropylab_pull_client_read(client, bytes, FLIPPER_RNG_PULL_RESERVOIR, &flags);
+    uint64_t reservoir_us = host_now_us() - start;
+    host_check(got == FLIPPER_RNG_PULL_RESERVOIR && flags == 0, "a reservoir-sized request is served");
+    host_check(host_chi_square(bytes, got) < 330.0, "pulled bytes look uniform");
+
+    // Small requests: latency is one round trip once the reservoir has refilled
+    furi_delay_ms(100);
+    uint64_t worst_us = 0;
+    size_t small_total = 0;
+    for(int i = 0; i < 32; i++) {
+        start = host_now_us();
+        small_total += entropylab_pull_client_read(client, bytes, 32, NULL);
+        uint64_t elapsed = host_now_us() - start;
+        if(elapsed > worst_us) worst_us = elapsed;
+    }
+    host_check(small_total == 32 * 32, "32-byte requests are served");
+
+    // Larger than the reservoir: streamed as it is generated
+    got = entropylab_pull_client_read(client, bytes, sizeof(bytes), NULL);
+    host_check(got == sizeof(bytes), "requests larger than the reservoir are streamed");
+    printf(
+        "# pull: %d bytes from the reservoir in %lu us, worst 32-byte request %lu us\n",
+        FLIPPER_RNG_PULL_RESERVOIR,
+        (unsigned long)reservoir_us,
+        (unsigned long)worst_us);
+
+    EntropyLabPullClientStats stats;
+    entropylab_pull_client_get_stats(client, &stats);
+    host_check(stats.retries == 0 && stats.lost_frames == 0 && stats.crc_errors == 0, "pull loopback loses nothing");
+
+    // An unknown command gets an empty rejection frame
+    uint8_t request[FLIPPER_RNG_PULL_REQUEST_SIZE];
+    size_t size = flipper_rng_pull_encode_request(request, 0, 0x7F, 16);
+    host_check(write(slave_fd, request, size) == (ssize_t)size, "raw request written");
+    FlipperRngFrameDecoder decoder;
+    HostFrameCapture* capture = malloc(sizeof(HostFrameCapture));
+    flipper_rng_frame_decoder_init(&decoder);
+    memset(capture, 0, sizeof(HostFrameCapture));
+    while(decoder.frames == 0 && poll(&pfd, 1, 1000) > 0) {
+        ssize_t n = read(slave_fd, bytes, sizeof(bytes));
+        if(n <= 0) break;
+        flipper_rng_frame_decoder_feed(&decoder, bytes, (size_t)n, host_frame_capture, capture);
+    }
+    host_check(
+        decoder.frames == 1 && capture->length == 0 && (capture->flags & FlipperRngFrameFlagRejected),
+        "unknown pull command is rejected");
+    free(capture);
+
+    entropylab_host_worker_stop(app);
+    furi_hal_subghz_host_unload_trace();
+    entropylab_pull_client_close(client);
+    host_pull_close(app, master, slave_fd);
+}
+
+static bool host_passphrase(FlipperRngState* state, uint8_t num_words, char* out, size_t out_size) {
+    PassphraseSDContext* ctx = flipper_rng_passphrase_sd_alloc();
+    bool ok = flipper_rng_passphrase_sd_load(ctx, PassphraseListEFFLong) &&
+              flipper_rng_passphrase_sd_build_index(ctx, NULL, NULL);
+    if(ok) {
+        flipper_rng_passphrase_generate_sd(state, ctx, out, out_size, num_words);
+    }
+    flipper_rng_passphrase_sd_free(ctx);
+    return ok;
+}
+
+static int host_selftest(void) {
+    host_crypto_known_answers();
+    host_pool_read_kernel();
+
+    FlipperRngApp* app = entropylab_host_app_alloc();
+    FlipperRngState* state = app->state;
+
+    // Pool input
+    uint8_t before[RNG_POOL_SIZE];
+    memcpy(before, state->entropy_pool, sizeof(before));
+    for(uint32_t i = 0; i < 10000; i++) {
+        flipper_rng_add_entropy(state, furi_hal_random_get(), 32);
+    }
+    host_check(state->samples_collected == 10000, "add_entropy counts every sample");
+    host_check(memcmp(before, state->entropy_pool, sizeof(before)) != 0, "add_entropy changes the pool");
+
+    host_ring_concurrency(state);
+    host_add_entropy_batch(state);
+    host_health_tests(state);
+    host_min_entropy_estimators(state);
+    host_conditioner(state);
+    host_subghz_sweep(state);
+
+    // Mixing, both modes, full-pool sweeps
+    state->full_mix_interval = 1;
+    memcpy(before, state->entropy_pool, sizeof(before));
+    state->mixing_mode = MixingModeHardware;
+    flipper_rng_mix_entropy_pool(state);
+    host_check(memcmp(before, state->entropy_pool, sizeof(before)) != 0, "hardware (AES) mix changes the pool");
+
+    memcpy(before, state->entropy_pool, sizeof(before));
+    state->mixing_mode = MixingModeSoftware;
+    flipper_rng_mix_entropy_pool(state);
+    host_check(memcmp(before, state->entropy_pool, sizeof(before)) != 0, "software mix changes the pool");
+    state->mixing_mode = MixingModeHardware;
+    state->full_mix_interval = RNG_FULL_MIX_INTERVAL_DEFAULT;
+    host_dirty_region_mixing(state);
+
+    // Extraction at the worker's cadence: 32 iterations of 32 bytes between mixes
+    static uint8_t output[65536];
+    for(size_t offset = 0; offset < sizeof(output); offset += 1024) {
+        flipper_rng_extract_random_bytes(state, &output[offset], 1024);
+        for(int i = 0; i < 8; i++) flipper_rng_add_entropy(state, furi_hal_random_get(), 32);
+        flipper_rng_mix_entropy_pool(state);
+    }
+    double chi = host_chi_square(output, sizeof(output));
+    printf("# chi-square over %zu extracted bytes: %.1f\n", sizeof(output), chi);
+    host_check(chi < 400.0, "extracted bytes are roughly uniform");
+    host_check(state->bytes_generated == sizeof(output), "extract counts generated bytes");
+    host_check(state->drbg.instantiated, "extraction seeds the CTR_DRBG from the pool");
+    host_check(state->drbg_seed_mix_counter == state->mix_counter - 1, "CTR_DRBG reseeds after each mix");
+
+    // Single bytes come from the buffered DRBG output
+    memset(output, 0, 256);
+    for(int i = 0; i < 256; i++) output[i] = flipper_rng_extract_random_byte(state);
+    int zeros = 0;
+    for(int i = 0; i < 256; i++) zeros += (output[i] == 0);
+    host_check(zeros < 16, "extract_random_byte produces varied output");
+    host_fortuna(state);
+    host_fortuna_startup(state);
+
+    host_file_writer();
+
+    host_credit_accounting(app);
+    host_frames(app);
+    host_pull_flags();
+    host_pull_mode(app);
+    host_uart_writer(app);
+
+    // Worker loop
+    entropylab_host_worker_start(app);
+    furi_delay_ms(300);
+    entropylab_host_worker_stop(app);
+    host_check(state->bytes_generated > sizeof(output), "worker thread generates output");
+    host_check(state->bits_from_hw_rng > 0, "worker collects hardware RNG bits");
+
+    // Passphrase from the shipped EFF wordlist
+    char passphrase[256];
+    host_line_reader();
+    host_passphrase_index();
+    host_wordlist_arena(state);
+    host_word_cache();
+    host_random_indices(state);
+    host_bulk_generation(app);
+    host_fill_credit(state);
+    bool loaded = host_passphrase(state, 6, passphrase, sizeof(passphrase));
+    host_check(loaded, "EFF wordlist loads and indexes");
+    if(loaded) {
+        int spaces = 0;
+        for(const char* p = passphrase; *p; p++) spaces += (*p == ' ');
+        host_check(spaces == 5, "6-word passphrase generated");
+    }
+
+    entropylab_host_app_free(app);
+
+    printf("# %s\n", host_failures ? "FAILED" : "all checks passed");
+    return host_failures ? 1 : 0;
+}
+
+static int host_uart(uint32_t duration_ms, bool framed, uint32_t baud) {
+    FlipperRngApp* app = entropylab_host_app_alloc();
+
+    furi_hal_serial_host_attach_fd(FuriHalSerialIdUsart, STDOUT_FILENO);
+    furi_hal_serial_host_set_paced(FuriHalSerialIdUsart, baud != 0);
+    app->state->output_mode = OutputModeUART;
+    app->state->uart_format = framed ? UartFormatFramed : UartFormatRaw;
+    if(baud) app->state->uart_baud = baud;
+    app->state->serial_handle = furi_hal_serial_control_acquire(FuriHalSerialIdUsart);
+    furi_hal_serial_init(app->state->serial_handle, app->state->uart_baud);
+
+    entropylab_host_worker_start(app);
+    furi_delay_ms(duration_ms);
+    entropylab_host_worker_stop(app);
+    fprintf(
+        stderr,
+        "uart: %lu B/s, %u%% stalled at %lu baud%s\n",
+        (unsigned long)app->state->uart_tx_bps,
+        app->state->uart_tx_stall_percent,
+        (unsigned long)app->state->uart_baud,
+        baud ? "" : " (unpaced)");
+
+    furi_hal_serial_deinit(app->state->serial_handle);
+    furi_hal_serial_control_release(app->state->serial_handle);
+    app->state->serial_handle = NULL;
+
+    entropylab_host_app_free(app);
+    return 0;
+}
+
+typedef struct {
+    bool strict;
+    uint32_t skipped;
+} HostDecodeContext;
+
+static void host_decode_frame(const FlipperRngFrame* frame, void* context) {
+    HostDecodeContext* ctx = context;
+    if(frame->lost) fprintf(stderr, "decode: %u frame(s) lost before seq %u\n", frame->lost, frame->seq);
+    if(frame->flags) fprintf(stderr, "decode: seq %u flags 0x%02X\n", frame->seq, frame->flags);
+    if(ctx->strict && (frame->flags & FLIPPER_RNG_FRAME_FLAGS_UNHEALTHY)) {
+        ctx->skipped++;
+        return;
+    }
+    fwrite(frame->payload, 1, frame->length, stdout);
+}
+
+static int host_decode(bool strict) {
+    static uint8_t buffer[4096];
+    FlipperRngFrameDecoder decoder;
+    HostDecodeContext ctx = {.strict = strict};
+    flipper_rng_frame_decoder_init(&decoder);
+
+    ssize_t got;
+    while((got = read(STDIN_FILENO, buffer, sizeof(buffer))) > 0) {
+        flipper_rng_frame_decoder_feed(&decoder, buffer, (size_t)got, host_decode_frame, &ctx);
+    }
+    fflush(stdout);
+    fprintf(
+        stderr,
+        "decode: %lu frames, %lu payload bytes, %lu lost, %lu CRC errors, %lu bytes discarded, %lu flagged, %lu skipped\n",
+        (unsigned long)decoder.frames,
+        (unsigned long)decoder.payload_bytes,
+        (unsigned long)decoder.lost_frames,
+        (unsigned long)decoder.crc_errors,
+        (unsigned long)decoder.discarded_bytes,
+        (unsigned long)decoder.flagged_frames,
+        (unsigned long)ctx.skipped);
+    return decoder.crc_errors || decoder.lost_frames ? 1 : 0;
+}
+
+static int host_pull(uint32_t duration_ms) {
+    FlipperRngApp* app = entropylab_host_app_alloc();
+    char slave_path[64];
+    int slave_fd;
+    int master = host_pull_open(app, &slave_fd, slave_path, sizeof(slave_path));
+    fprintf(stderr, "pull: serving on %s for %lu ms\n", slave_path, (unsigned long)duration_ms);
+
+    entropylab_host_worker_start(app);
+    furi_delay_ms(duration_ms);
+    entropylab_host_worker_stop(app);
+
+    host_pull_close(app, master, slave_fd);
+    entropylab_host_app_free(app);
+    return 0;
+}
+
+static int host_generate_passphrase(uint8_t num_words) {
+    FlipperRngApp* app = entropylab_host_app_alloc();
+
+    // Let the worker fill the pool the same way it would before the user presses OK
+    entropylab_host_worker_start(app);
+    furi_delay_ms(50);
+    entropylab_host_worker_stop(app);
+
+    char passphrase[512];
+    bool ok = host_passphrase(app->state, num_words, passphrase, sizeof(passphrase));
+    if(ok) {
+        printf("%s\n", passphrase);
+    } else {
+        fprintf(stderr, "wordlist not found under $ENTROPYLAB_HOST_EXT/apps_data/entropylab\n");
+    }
+
+    entropylab_host_app_free(app);
+    return ok ? 0 : 1;
+}
+
+static void host_bulk_stdout(const uint8_t* data, size_t length, void* context) {
+    UNUSED(context);
+    fwrite(data, 1, length, stdout);
+}
+
+static int host_bulk(int argc, char** argv) {
+    FlipperRngBulkConfig config;
+    flipper_rng_bulk_config_default(&config);
+    PassphraseListType list = PassphraseListEFFLong;
+
+    if(argc > 0) config.count = (uint32_t)strtoul(argv[0], NULL, 0);
+    const char* kind = argc > 1 ? argv[1] : "eff";
+    if(strcmp(kind, "bip39") == 0) {
+        list = PassphraseListBIP39;
+    } else if(strcmp(kind, "slip39") == 0) {
+        list = PassphraseListSLIP39;
+    } else if(strcmp(kind, "hex") == 0) {
+        config.format = FlipperRngBulkHex;
+    } else if(strcmp(kind, "base32") == 0) {
+        config.format = FlipperRngBulkBase32;
+    } else if(strcmp(kind, "eff") != 0) {
+        fprintf(stderr, "unknown list or format: %s\n", kind);
+        return 2;
+    }
+    if(argc > 2) {
+        uint32_t size = (uint32_t)strtoul(argv[2], NULL, 0);
+        if(config.format == FlipperRngBulkPassphrase) {
+            config.num_words = (uint8_t)size;
+        } else {
+            config.key_bytes = (uint16_t)size;
+        }
+    }
+
+    // The worker keeps feeding credit while the run waits on it, as on the device
+    FlipperRngApp* app = entropylab_host_app_alloc();
+    config.wait_for_credit = true;
+    entropylab_host_worker_start(app);
+
+    PassphraseSDContext* ctx = flipper_rng_passphrase_sd_alloc();
+    bool ok = config.format != FlipperRngBulkPassphrase ||
+              (flipper_rng_passphrase_sd_load(ctx, list) && flipper_rng_passphrase_sd_build_index(ctx, NULL, NULL));
+    FlipperRngBulkStats stats;
+    ok = ok && flipper_rng_bulk_generate(app->state, ctx, &config, host_bulk_stdout, NULL, &stats);
+    entropylab_host_worker_stop(app);
+    if(ok) {
+        fprintf(
+            stderr,
+            "%lu %s, %lu bytes in %lu ms (%lu/s)\n",
+            (unsigned long)stats.generated,
+            flipper_rng_bulk_format_name(config.format),
+            (unsigned long)stats.bytes_out,
+            (unsigned long)stats.elapsed_ms,
+            (unsigned long)stats.per_sec);
+    } else {
+        fprintf(stderr, "bulk generation failed (wordlists under $ENTROPYLAB_HOST_EXT/apps_data/entropylab?)\n");
+    }
+
+    flipper_rng_passphrase_sd_free(ctx);
+    entropylab_host_app_free(app);
+    return ok ? 0 : 1;
+}
+
+static void host_write_stdout(const char* text, void* context) {
+    UNUSED(context);
+    fputs(text, stdout);
+}
+
+static int host_bench(int argc, char** argv) {
+    FlipperRngApp* app = entropylab_host_app_alloc();
+
+    FlipperRngBenchConfig config;
+    flipper_rng_bench_config_default(&config);
+    config.iterations = 2000;
+
+    if(argc > 0) {
+        config.iterations = (uint32_t)strtoul(argv[0], NULL, 0);
+    }
+    if(argc > 1) {
+        config.batch_count = 0;
+        for(int i = 1; i < argc && config.batch_count < FLIPPER_RNG_BENCH_MAX_BATCHES; i++) {
+            config.batch_sizes[config.batch_count++] = (size_t)strtoul(argv[i], NULL, 0);
+        }
+    }
+
+    FlipperRngBenchResult results[2 + FLIPPER_RNG_BENCH_MAX_BATCHES * 10];
+    size_t count = flipper_rng_bench_run(app->state, &config, results, COUNT_OF(results));
+    flipper_rng_bench_write_json(results, count, host_write_stdout, NULL);
+
+    entropylab_host_app_free(app);
+    return count ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    entropylab_host_set_ext_root(HOST_DEFAULT_EXT);
+    furi_hal_random_init();
+
+    const char* command = argc > 1 ? argv[1] : "selftest";
+
+    if(strcmp(command, "selftest") == 0) {
+        return host_selftest();
+    } else if(strcmp(command, "uart") == 0) {
+        bool framed = false;
+        uint32_t baud = 0;
+        for(int i = 3; i < argc; i++) {
+            if(strcmp(argv[i], "framed") == 0) {
+                framed = true;
+            } else {
+                baud = (uint32_t)strtoul(argv[i], NULL, 0);
+            }
+        }
+        return host_uart(argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 0) : 1000, framed, baud);
+    } else if(strcmp(command, "pull") == 0) {
+        return host_pull(argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 0) : 10000);
+    } else if(strcmp(command, "decode") == 0) {
+        return host_decode(argc > 2 && strcmp(argv[2], "strict") == 0);
+    } else if(strcmp(command, "passphrase") == 0) {
+        return host_generate_passphrase(argc > 2 ? (uint8_t)atoi(argv[2]) : PASSPHRASE_DEFAULT_WORDS);
+    } else if(strcmp(command, "bench") == 0) {
+        return host_bench(argc - 2, argv + 2);
+    } else if(strcmp(command, "bulk") == 0) {
+        return host_bulk(argc - 2, argv + 2);
+    }
+
+    fprintf(stderr, "usage: %s [selftest | uart <ms> [framed] [baud] | pull <ms> | decode [strict] | passphrase [words] | bench [iterations] [batch...] | bulk [count] [eff|bip39|slip39|hex|base32] [words|bytes]]\n", argv[0]);
+    return 2;
+}
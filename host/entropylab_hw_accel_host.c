@@ -0,0 +1,153 @@
+/**
+ * Host port of the hardware acceleration module
+ * The STM32WB55 AES1 peripheral is replaced by the portable software AES-256
+ * so MixingModeHardware behaves like it does on the device, just slower.
+ * Cycle counts come from the TSC on x86 and the furi_hal_cortex DWT shim elsewhere.
+ */
+
+#include "entropylab_hw_accel.h"
+#include "entropylab_aes.h"
+#include <furi.h>
+#include <furi_hal.h>
+#include <furi_hal_cortex.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define TAG "EntropyLab_HW"
+
+static bool hw_aes_peripheral_ready = false;
+static FuriMutex* hw_aes_mutex = NULL;
+
+// Initialize hardware acceleration
+void flipper_rng_hw_accel_init(void) {
+    if(!hw_aes_mutex) {
+        hw_aes_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    }
+    hw_aes_peripheral_ready = true;
+    FURI_LOG_I(TAG, "Host acceleration initialized (software AES)");
+}
+
+void flipper_rng_hw_accel_deinit(void) {
+    if(hw_aes_mutex) {
+        furi_mutex_free(hw_aes_mutex);
+        hw_aes_mutex = NULL;
+    }
+    hw_aes_peripheral_ready = false;
+}
+
+// Same contract as the AES1 version: encrypt each 16-byte block and XOR it back into the pool
+bool flipper_rng_hw_aes_mix_pool(uint8_t* pool, size_t pool_size, uint32_t* key) {
+    if(!hw_aes_mutex || !hw_aes_peripheral_ready) return false;
+
+    if(furi_mutex_acquire(hw_aes_mutex, 10) != FuriStatusOk) {
+        FURI_LOG_D(TAG, "AES mutex busy, using software mixing");
+        return false;
+    }
+
+    // Key words are loaded big-endian like the KEYRx registers, upper half mixed with fresh TRNG
+    uint8_t key_bytes[32];
+    for(int i = 0; i < 8; i++) {
+        uint32_t word = (i < 4) ? key[i] : (key[i] ^ furi_hal_random_get());
+        key_bytes[i * 4 + 0] = (uint8_t)(word >> 24);
+        key_bytes[i * 4 + 1] = (uint8_t)(word >> 16);
+        key_bytes[i * 4 + 2] = (uint8_t)(word >> 8);
+        key_bytes[i * 4 + 3] = (uint8_t)word;
+    }
+
+    FlipperRngAes256 aes;
+    flipper_rng_aes256_init(&aes, key_bytes);
+
+    for(size_t i = 0; i + 16 <= pool_size; i += 16) {
+        uint8_t block[16];
+        flipper_rng_aes256_encrypt_block(&aes, &pool[i], block);
+        for(int j = 0; j < 16; j++) pool[i + j] ^= block[j];
+    }
+
+    memset(key_bytes, 0, sizeof(key_bytes));
+    flipper_rng_aes256_wipe(&aes);
+
+    furi_mutex_release(hw_aes_mutex);
+    return true;
+}
+
+// Standard AES-256-ECB, same contract as the AES1 version
+bool flipper_rng_hw_aes_encrypt_blocks(const uint8_t* key, const uint8_t* input, uint8_t* output, size_t blocks) {
+    if(!hw_aes_mutex || !hw_aes_peripheral_ready) return false;
+
+    if(furi_mutex_acquire(hw_aes_mutex, 10) != FuriStatusOk) {
+        return false;
+    }
+
+    FlipperRngAes256 aes;
+    flipper_rng_aes256_init(&aes, key);
+    for(size_t i = 0; i < blocks; i++) {
+        flipper_rng_aes256_encrypt_block(&aes, &input[i * 16], &output[i * 16]);
+    }
+    flipper_rng_aes256_wipe(&aes);
+
+    furi_mutex_release(hw_aes_mutex);
+    return true;
+}
+
+uint32_t flipper_rng_hw_rotate_left(uint32_t value, uint8_t shift) {
+    return (value << shift) | (value >> (32 - shift));
+}
+
+uint32_t flipper_rng_hw_rotate_right(uint32_t value, uint8_t shift) {
+    return (value >> shift) | (value << (32 - shift));
+}
+
+uint32_t flipper_rng_hw_clz(uint32_t value) {
+    return value ? __builtin_clz(value) : 32;
+}
+
+uint32_t flipper_rng_hw_bswap32(uint32_t value) {
+    return __builtin_bswap32(value);
+}
+
+void flipper_rng_hw_xor_mix(uint32_t* dest, const uint32_t* src, size_t words) {
+    for(size_t i = 0; i < words; i++) {
+        dest[i] ^= src[i];
+    }
+}
+
+bool flipper_rng_hw_uart_tx_dma(FuriHalSerialHandle* handle, const uint8_t* data, size_t size) {
+    if(!handle || !data || size == 0) {
+        return false;
+    }
+
+    furi_hal_serial_tx(handle, data, size);
+
+    return true;
+}
+
+void flipper_rng_hw_uart_tx_bulk(FuriHalSerialHandle* handle, const uint8_t* data, size_t size) {
+    if(!handle || !data || size == 0) return;
+    furi_hal_serial_tx(handle, data, size);
+}
+
+// Real CPU cycles from the TSC where available, otherwise the 64 MHz DWT emulation.
+// TSC ticks are not 64 MHz, so use flipper_rng_hw_get_time_ns() for wall time.
+uint32_t flipper_rng_hw_get_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__rdtsc();
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+uint32_t flipper_rng_hw_cycles_elapsed(uint32_t start) {
+    return flipper_rng_hw_get_cycles() - start;
+}
+
+uint32_t flipper_rng_hw_cycles_to_us(uint32_t cycles) {
+    return cycles / 64;
+}
+
+uint64_t flipper_rng_hw_get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
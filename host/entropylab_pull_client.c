@@ -0,0 +1,188 @@
+/**
+ * Host client for the pull-mode UART protocol
+ */
+
+#include "entropylab_pull_client.h"
+#include "entropylab_pull.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+struct EntropyLabPullClient {
+    int fd;
+    bool owns_fd;
+    uint16_t request_seq;
+    FlipperRngFrameDecoder decoder;
+
+    // The read in progress
+    uint8_t* out;
+    size_t wanted;
+    size_t got;
+    uint8_t flags;
+    bool rejected;
+
+    EntropyLabPullClientStats stats;
+};
+
+static uint64_t pull_client_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static speed_t pull_client_speed(uint32_t baud) {
+    switch(baud) {
+    case 9600:
+        return B9600;
+    case 19200:
+        return B19200;
+    case 38400:
+        return B38400;
+    case 57600:
+        return B57600;
+#ifdef B230400
+    case 230400:
+        return B230400;
+#endif
+#ifdef B460800
+    case 460800:
+        return B460800;
+#endif
+#ifdef B921600
+    case 921600:
+        return B921600;
+#endif
+    default:
+        return B115200;
+    }
+}
+
+EntropyLabPullClient* entropylab_pull_client_from_fd(int fd) {
+    EntropyLabPullClient* client = calloc(1, sizeof(EntropyLabPullClient));
+    if(!client) return NULL;
+    client->fd = fd;
+    flipper_rng_frame_decoder_init(&client->decoder);
+    return client;
+}
+
+EntropyLabPullClient* entropylab_pull_client_open(const char* path, uint32_t baud) {
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if(fd < 0) return NULL;
+
+    // Raw 8N1: no echo, no line buffering, no CR/LF translation
+    if(isatty(fd)) {
+        struct termios tio;
+        if(tcgetattr(fd, &tio) == 0) {
+            cfmakeraw(&tio);
+            cfsetispeed(&tio, pull_client_speed(baud));
+            cfsetospeed(&tio, pull_client_speed(baud));
+            tio.c_cflag |= CLOCAL | CREAD;
+            tio.c_cc[VMIN] = 0;
+            tio.c_cc[VTIME] = 0;
+            tcsetattr(fd, TCSANOW, &tio);
+            tcflush(fd, TCIOFLUSH);
+        }
+    }
+
+    EntropyLabPullClient* client = entropylab_pull_client_from_fd(fd);
+    if(!client) {
+        close(fd);
+        return NULL;
+    }
+    client->owns_fd = true;
+    return client;
+}
+
+void entropylab_pull_client_close(EntropyLabPullClient* client) {
+    if(!client) return;
+    if(client->owns_fd) close(client->fd);
+    free(client);
+}
+
+static void pull_client_frame(const FlipperRngFrame* frame, void* context) {
+    EntropyLabPullClient* client = context;
+    if(frame->flags & FlipperRngFrameFlagRejected) {
+        client->stats.rejected++;
+        client->rejected = true;
+        return;
+    }
+    if(frame->flags & FLIPPER_RNG_FRAME_FLAGS_UNHEALTHY) client->stats.flagged_frames++;
+
+    // Late frames from a request that already timed out can overshoot; the surplus is dropped
+    size_t take = client->wanted - client->got;
+    if(take > frame->length) take = frame->length;
+    if(client->out) memcpy(&client->out[client->got], frame->payload, take);
+    client->got += take;
+    client->flags |= frame->flags;
+}
+
+static bool pull_client_send_request(EntropyLabPullClient* client, uint16_t count) {
+    uint8_t request[FLIPPER_RNG_PULL_REQUEST_SIZE];
+    size_t size = flipper_rng_pull_encode_request(request, client->request_seq++, FlipperRngPullCommandRead, count);
+    for(size_t offset = 0; offset < size;) {
+        ssize_t written = write(client->fd, &request[offset], size - offset);
+        if(written < 0) {
+            if(errno == EINTR || errno == EAGAIN) continue;
+            return false;
+        }
+        offset += (size_t)written;
+    }
+    client->stats.requests++;
+    return true;
+}
+
+// Feed whatever arrives until target bytes are in, false on a timeout or a dead descriptor
+static bool pull_client_wait(EntropyLabPullClient* client, size_t target) {
+    uint8_t buffer[1024];
+    while(client->got < target && !client->rejected) {
+        struct pollfd pfd = {.fd = client->fd, .events = POLLIN};
+        int ready = poll(&pfd, 1, ENTROPYLAB_PULL_CLIENT_TIMEOUT_MS);
+        if(ready < 0 && errno == EINTR) continue;
+        if(ready <= 0) return false;
+
+        ssize_t got = read(client->fd, buffer, sizeof(buffer));
+        if(got < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+        if(got <= 0) return false;
+        flipper_rng_frame_decoder_feed(&client->decoder, buffer, (size_t)got, pull_client_frame, client);
+    }
+    return client->got >= target;
+}
+
+size_t entropylab_pull_client_read(EntropyLabPullClient* client, uint8_t* out, size_t length, uint8_t* flags) {
+    client->out = out;
+    client->wanted = length;
+    client->got = 0;
+    client->flags = 0;
+    client->rejected = false;
+
+    uint64_t start = pull_client_now_ns();
+    uint32_t retries = 0;
+    while(client->got < length && !client->rejected) {
+        size_t count = length - client->got;
+        if(count > UINT16_MAX) count = UINT16_MAX;
+        if(!pull_client_send_request(client, (uint16_t)count)) break;
+
+        // A lost frame only shows up as silence, so ask again for what is missing
+        if(!pull_client_wait(client, client->got + count) && !client->rejected) {
+            if(retries++ >= ENTROPYLAB_PULL_CLIENT_RETRIES) break;
+            client->stats.retries++;
+        }
+    }
+    if(client->got == length) client->stats.last_latency_ns = pull_client_now_ns() - start;
+
+    if(flags) *flags = client->flags;
+    client->out = NULL;
+    return client->got;
+}
+
+void entropylab_pull_client_get_stats(EntropyLabPullClient* client, EntropyLabPullClientStats* stats) {
+    *stats = client->stats;
+    stats->frames = client->decoder.frames;
+    stats->lost_frames = client->decoder.lost_frames;
+    stats->crc_errors = client->decoder.crc_errors;
+}
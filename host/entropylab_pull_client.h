@@ -0,0 +1,38 @@
+#pragma once
+
+/**
+ * Host client for the pull-mode UART protocol (entropylab_pull.h)
+ * Opens the device's serial port in raw mode, sends read requests and
+ * collects the framed responses. One request is in flight at a time.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define ENTROPYLAB_PULL_CLIENT_TIMEOUT_MS 1000  // Silence before re-requesting the shortfall
+#define ENTROPYLAB_PULL_CLIENT_RETRIES 3
+
+typedef struct EntropyLabPullClient EntropyLabPullClient;
+
+typedef struct {
+    uint32_t requests;
+    uint32_t retries;        // Requests re-sent after a timeout
+    uint32_t frames;
+    uint32_t lost_frames;
+    uint32_t crc_errors;
+    uint32_t flagged_frames; // Frames with a health flag set
+    uint32_t rejected;       // Requests the device did not understand
+    uint64_t last_latency_ns;  // Request sent to last byte received, last complete read
+} EntropyLabPullClientStats;
+
+// path is a tty (configured raw at baud) or any other descriptor-backed file
+EntropyLabPullClient* entropylab_pull_client_open(const char* path, uint32_t baud);
+EntropyLabPullClient* entropylab_pull_client_from_fd(int fd);
+void entropylab_pull_client_close(EntropyLabPullClient* client);
+
+// Read length random bytes; returns how many arrived, fewer only after every retry timed out.
+// flags (optional) gets the OR of the flags of every frame used
+size_t entropylab_pull_client_read(EntropyLabPullClient* client, uint8_t* out, size_t length, uint8_t* flags);
+
+void entropylab_pull_client_get_stats(EntropyLabPullClient* client, EntropyLabPullClientStats* stats);
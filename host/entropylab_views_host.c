@@ -0,0 +1,25 @@
+/**
+ * Host stand-in for the view layer
+ * The worker pushes visualization snapshots here; the host keeps the latest one
+ * so harnesses can check that the refresh path ran.
+ */
+
+#include "entropylab.h"
+#include "entropylab_views.h"
+#include "entropylab_host.h"
+
+static uint32_t host_visualization_updates = 0;
+static uint8_t host_visualization_data[128];
+
+void flipper_rng_visualization_update(FlipperRngApp* app, uint8_t* data, size_t length) {
+    UNUSED(app);
+    size_t copy_len = MIN(length, sizeof(host_visualization_data));
+    if(data && copy_len > 0) {
+        memcpy(host_visualization_data, data, copy_len);
+    }
+    host_visualization_updates++;
+}
+
+uint32_t entropylab_host_visualization_updates(void) {
+    return host_visualization_updates;
+}
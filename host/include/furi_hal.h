@@ -0,0 +1,14 @@
+#pragma once
+
+/**
+ * Host shim umbrella header, mirrors the firmware's furi_hal.h
+ */
+
+#include <furi_hal_cortex.h>
+#include <furi_hal_random.h>
+#include <furi_hal_adc.h>
+#include <furi_hal_power.h>
+#include <furi_hal_serial.h>
+#include <furi_hal_light.h>
+#include <furi_hal_infrared.h>
+#include <furi_hal_subghz.h>
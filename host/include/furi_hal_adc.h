@@ -0,0 +1,27 @@
+#pragma once
+
+/**
+ * Host shim for furi_hal_adc.h
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FuriHalAdcHandle FuriHalAdcHandle;
+
+typedef enum {
+    FuriHalAdcChannelVREFINT,
+    FuriHalAdcChannelTEMPSENSOR,
+    FuriHalAdcChannelVBAT,
+} FuriHalAdcChannel;
+
+FuriHalAdcHandle* furi_hal_adc_acquire(void);
+void furi_hal_adc_release(FuriHalAdcHandle* handle);
+uint16_t furi_hal_adc_read(FuriHalAdcHandle* handle, FuriHalAdcChannel channel);
+
+#ifdef __cplusplus
+}
+#endif
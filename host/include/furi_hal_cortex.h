@@ -0,0 +1,39 @@
+#pragma once
+
+/**
+ * Host shim for furi_hal_cortex.h
+ * DWT->CYCCNT is emulated with a 64 MHz-scaled monotonic clock so code that
+ * measures intervals in cycles keeps the same units as on the STM32WB55.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FURI_HAL_CORTEX_HOST_CLOCK_HZ 64000000U
+
+typedef struct {
+    volatile uint32_t CYCCNT;
+} FuriHostDwt;
+
+// Refreshes CYCCNT from the host clock on every access
+FuriHostDwt* furi_hal_cortex_host_dwt(void);
+#define DWT (furi_hal_cortex_host_dwt())
+
+typedef struct {
+    uint32_t start;
+    uint32_t value;
+} FuriHalCortexTimer;
+
+void furi_hal_cortex_delay_us(uint32_t microseconds);
+uint32_t furi_hal_cortex_instructions_per_microsecond(void);
+FuriHalCortexTimer furi_hal_cortex_timer_get(uint32_t timeout_us);
+bool furi_hal_cortex_timer_is_expired(FuriHalCortexTimer cortex_timer);
+void furi_hal_cortex_timer_wait(FuriHalCortexTimer cortex_timer);
+
+#ifdef __cplusplus
+}
+#endif
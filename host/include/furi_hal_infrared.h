@@ -0,0 +1,17 @@
+#pragma once
+
+/**
+ * Host shim for furi_hal_infrared.h
+ */
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool furi_hal_infrared_is_busy(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * Host shim for furi_hal_light.h
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    LightRed = (1 << 0),
+    LightGreen = (1 << 1),
+    LightBlue = (1 << 2),
+    LightBacklight = (1 << 3),
+} Light;
+
+void furi_hal_light_set(Light light, uint8_t value);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,25 @@
+#pragma once
+
+/**
+ * Host shim for furi_hal_power.h
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    FuriHalPowerICCharger,
+    FuriHalPowerICFuelGauge,
+} FuriHalPowerIC;
+
+float furi_hal_power_get_battery_voltage(FuriHalPowerIC ic);
+float furi_hal_power_get_battery_current(FuriHalPowerIC ic);
+float furi_hal_power_get_battery_temperature(FuriHalPowerIC ic);
+uint8_t furi_hal_power_get_pct(void);
+
+#ifdef __cplusplus
+}
+#endif
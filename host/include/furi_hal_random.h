@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * Host shim for furi_hal_random.h
+ * The TRNG is replaced by xoshiro256** seeded from getrandom(), or from
+ * furi_hal_random_host_seed() when a reproducible stream is needed.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void furi_hal_random_init(void);
+uint32_t furi_hal_random_get(void);
+void furi_hal_random_fill_buf(uint8_t* buf, uint32_t len);
+
+// Host only: make the "TRNG" stream deterministic
+void furi_hal_random_host_seed(uint64_t seed);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,64 @@
+#pragma once
+
+/**
+ * Host shim for furi_hal_serial.h
+ * A serial handle wraps a file descriptor (pty, pipe or regular file) that
+ * the host harness attaches with furi_hal_serial_host_attach_fd().
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    FuriHalSerialIdUsart,
+    FuriHalSerialIdLpuart,
+    FuriHalSerialIdMax,
+} FuriHalSerialId;
+
+typedef struct FuriHalSerialHandle FuriHalSerialHandle;
+
+typedef enum {
+    FuriHalSerialRxEventData = (1 << 0),
+    FuriHalSerialRxEventIdle = (1 << 1),
+    FuriHalSerialRxEventFrameError = (1 << 2),
+    FuriHalSerialRxEventNoiseError = (1 << 3),
+    FuriHalSerialRxEventOverrunError = (1 << 4),
+} FuriHalSerialRxEvent;
+
+typedef void (*FuriHalSerialAsyncRxCallback)(FuriHalSerialHandle* handle, FuriHalSerialRxEvent event, void* context);
+
+FuriHalSerialHandle* furi_hal_serial_control_acquire(FuriHalSerialId serial_id);
+void furi_hal_serial_control_release(FuriHalSerialHandle* handle);
+void furi_hal_serial_init(FuriHalSerialHandle* handle, uint32_t baud);
+void furi_hal_serial_deinit(FuriHalSerialHandle* handle);
+void furi_hal_serial_set_br(FuriHalSerialHandle* handle, uint32_t baud);
+void furi_hal_serial_tx(FuriHalSerialHandle* handle, const uint8_t* buffer, size_t buffer_size);
+void furi_hal_serial_tx_wait_complete(FuriHalSerialHandle* handle);
+
+// Host: a reader thread on the attached descriptor calls back with whatever each read() returned
+void furi_hal_serial_async_rx_start(
+    FuriHalSerialHandle* handle,
+    FuriHalSerialAsyncRxCallback callback,
+    void* context,
+    bool report_errors);
+void furi_hal_serial_async_rx_stop(FuriHalSerialHandle* handle);
+bool furi_hal_serial_async_rx_available(FuriHalSerialHandle* handle);
+uint8_t furi_hal_serial_async_rx(FuriHalSerialHandle* handle);
+
+// Host only: route a serial id to an already open file descriptor
+void furi_hal_serial_host_attach_fd(FuriHalSerialId serial_id, int fd);
+
+// Host only: make furi_hal_serial_tx() take as long as the bytes would at the set baud
+void furi_hal_serial_host_set_paced(FuriHalSerialId serial_id, bool paced);
+
+// Host only: the baud rate last set by furi_hal_serial_init() or furi_hal_serial_set_br()
+uint32_t furi_hal_serial_host_get_baud(FuriHalSerialId serial_id);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+
+/**
+ * Host shim for furi_hal_subghz.h
+ * There is no CC1101 on the host: frequencies report as invalid, so the
+ * RSSI collector takes its "radio unavailable" path, unless a recorded RSSI
+ * trace is loaded with furi_hal_subghz_host_load_trace().
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void furi_hal_subghz_reset(void);
+void furi_hal_subghz_sleep(void);
+void furi_hal_subghz_idle(void);
+void furi_hal_subghz_rx(void);
+void furi_hal_subghz_load_custom_preset(const uint8_t* preset_data);
+void furi_hal_subghz_load_registers(const uint8_t* data);
+uint32_t furi_hal_subghz_set_frequency(uint32_t value);
+bool furi_hal_subghz_is_frequency_valid(uint32_t value);
+float furi_hal_subghz_get_rssi(void);
+uint8_t furi_hal_subghz_get_lqi(void);
+
+// Host only: replay "rssi_dbm,lqi" lines (# comments) as RX readings
+bool furi_hal_subghz_host_load_trace(const char* path);
+void furi_hal_subghz_host_unload_trace(void);
+size_t furi_hal_subghz_host_trace_reads(void);  // Readings consumed since the trace was loaded
+bool furi_hal_subghz_host_is_asleep(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,11 @@
+#pragma once
+
+/**
+ * Host shim for gui/gui.h - GUI objects only appear as opaque pointers
+ */
+
+#include <gui/view.h>
+
+typedef struct Gui Gui;
+
+#define RECORD_GUI "gui"
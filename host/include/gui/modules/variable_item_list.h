@@ -0,0 +1,6 @@
+#pragma once
+
+#include <gui/view.h>
+
+typedef struct VariableItemList VariableItemList;
+typedef struct VariableItem VariableItem;
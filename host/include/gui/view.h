@@ -0,0 +1,12 @@
+#pragma once
+
+/**
+ * Host shim for gui/view.h - views are never drawn on the host
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct View View;
+typedef struct Canvas Canvas;
+typedef struct InputEvent InputEvent;
@@ -0,0 +1,34 @@
+#pragma once
+
+/**
+ * Host shim for infrared.h
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    InfraredProtocolUnknown = -1,
+    InfraredProtocolNEC = 0,
+    InfraredProtocolNECext,
+    InfraredProtocolNEC42,
+    InfraredProtocolSamsung32,
+    InfraredProtocolRC6,
+    InfraredProtocolRC5,
+    InfraredProtocolSIRC,
+} InfraredProtocol;
+
+typedef struct {
+    InfraredProtocol protocol;
+    uint32_t address;
+    uint32_t command;
+    bool repeat;
+} InfraredMessage;
+
+#ifdef __cplusplus
+}
+#endif
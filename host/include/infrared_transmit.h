@@ -0,0 +1,7 @@
+#pragma once
+
+/**
+ * Host shim for infrared_transmit.h (transmit is never used by Entropy Lab)
+ */
+
+#include <infrared.h>
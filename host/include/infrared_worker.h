@@ -0,0 +1,47 @@
+#pragma once
+
+/**
+ * Host shim for infrared_worker.h
+ * The host worker never receives anything by itself; tests inject signals
+ * with infrared_worker_host_inject_raw() / infrared_worker_host_inject_decoded().
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <infrared.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct InfraredWorker InfraredWorker;
+typedef struct InfraredWorkerSignal InfraredWorkerSignal;
+
+typedef void (*InfraredWorkerReceivedSignalCallback)(void* context, InfraredWorkerSignal* received_signal);
+
+InfraredWorker* infrared_worker_alloc(void);
+void infrared_worker_free(InfraredWorker* instance);
+void infrared_worker_rx_start(InfraredWorker* instance);
+void infrared_worker_rx_stop(InfraredWorker* instance);
+void infrared_worker_rx_set_received_signal_callback(
+    InfraredWorker* instance,
+    InfraredWorkerReceivedSignalCallback callback,
+    void* context);
+void infrared_worker_rx_enable_blink_on_receiving(InfraredWorker* instance, bool enable);
+void infrared_worker_rx_enable_signal_decoding(InfraredWorker* instance, bool enable);
+
+bool infrared_worker_signal_is_decoded(const InfraredWorkerSignal* signal);
+const InfraredMessage* infrared_worker_get_decoded_signal(const InfraredWorkerSignal* signal);
+void infrared_worker_get_raw_signal(
+    const InfraredWorkerSignal* signal,
+    const uint32_t** timings,
+    size_t* timings_cnt);
+
+// Host only: deliver a signal to the callback of a started worker
+void infrared_worker_host_inject_raw(InfraredWorker* instance, const uint32_t* timings, size_t timings_cnt);
+void infrared_worker_host_inject_decoded(InfraredWorker* instance, const InfraredMessage* message);
+
+#ifdef __cplusplus
+}
+#endif
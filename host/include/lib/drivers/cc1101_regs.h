@@ -0,0 +1,9 @@
+#pragma once
+
+/**
+ * Host shim for lib/drivers/cc1101_regs.h (only the registers Entropy Lab touches)
+ */
+
+#define CC1101_AGCCTRL2 0x1B
+#define CC1101_AGCCTRL1 0x1C
+#define CC1101_AGCCTRL0 0x1D
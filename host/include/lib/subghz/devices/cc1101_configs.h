@@ -0,0 +1,9 @@
+#pragma once
+
+/**
+ * Host shim for lib/subghz/devices/cc1101_configs.h
+ */
+
+#include <stdint.h>
+
+extern const uint8_t subghz_device_cc1101_preset_ook_650khz_async_regs[];
@@ -0,0 +1,9 @@
+#pragma once
+
+/**
+ * Host shim for notification/notification_messages.h
+ */
+
+typedef struct NotificationApp NotificationApp;
+
+#define RECORD_NOTIFICATION "notification"
@@ -0,0 +1,7 @@
+#pragma once
+
+/**
+ * Host shim for toolbox/stream/file_stream.h (streams are not used by the core)
+ */
+
+#include <storage/storage.h>
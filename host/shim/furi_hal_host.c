@@ -0,0 +1,415 @@
+/**
+ * Host implementation of the furi_hal shims used by Entropy Lab
+ */
+
+#define _GNU_SOURCE
+#include <furi.h>
+#include <furi_hal.h>
+#include <lib/subghz/devices/cc1101_configs.h>
+#include <pthread.h>
+#include <sys/random.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdatomic.h>
+#include <time.h>
+
+// Random: xoshiro256** stands in for the STM32WB55 TRNG
+static uint64_t furi_hal_random_host_state[4];
+static bool furi_hal_random_host_ready = false;
+static pthread_mutex_t furi_hal_random_host_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static uint64_t furi_hal_random_host_splitmix(uint64_t* x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t furi_hal_random_host_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+void furi_hal_random_host_seed(uint64_t seed) {
+    pthread_mutex_lock(&furi_hal_random_host_lock);
+    for(int i = 0; i < 4; i++) {
+        furi_hal_random_host_state[i] = furi_hal_random_host_splitmix(&seed);
+    }
+    furi_hal_random_host_ready = true;
+    pthread_mutex_unlock(&furi_hal_random_host_lock);
+}
+
+void furi_hal_random_init(void) {
+    uint64_t seed = 0;
+    const char* env = getenv("ENTROPYLAB_HOST_SEED");
+    if(env) {
+        seed = strtoull(env, NULL, 0);
+    } else if(getrandom(&seed, sizeof(seed), 0) != sizeof(seed)) {
+        seed = (uint64_t)furi_get_tick() ^ ((uint64_t)getpid() << 32);
+    }
+    furi_hal_random_host_seed(seed);
+}
+
+uint32_t furi_hal_random_get(void) {
+    if(!furi_hal_random_host_ready) {
+        furi_hal_random_init();
+    }
+
+    pthread_mutex_lock(&furi_hal_random_host_lock);
+    uint64_t* s = furi_hal_random_host_state;
+    uint64_t result = furi_hal_random_host_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = furi_hal_random_host_rotl(s[3], 45);
+    pthread_mutex_unlock(&furi_hal_random_host_lock);
+
+    return (uint32_t)(result >> 32);
+}
+
+void furi_hal_random_fill_buf(uint8_t* buf, uint32_t len) {
+    for(uint32_t i = 0; i < len; i += 4) {
+        uint32_t value = furi_hal_random_get();
+        uint32_t chunk = (len - i < 4) ? (len - i) : 4;
+        memcpy(&buf[i], &value, chunk);
+    }
+}
+
+// ADC and power: fixed readings with a little TRNG noise in the low bits
+struct FuriHalAdcHandle {
+    uint8_t unused;
+};
+
+static FuriHalAdcHandle furi_hal_adc_host_handle;
+
+FuriHalAdcHandle* furi_hal_adc_acquire(void) {
+    return &furi_hal_adc_host_handle;
+}
+
+void furi_hal_adc_release(FuriHalAdcHandle* handle) {
+    UNUSED(handle);
+}
+
+uint16_t furi_hal_adc_read(FuriHalAdcHandle* handle, FuriHalAdcChannel channel) {
+    UNUSED(handle);
+    static const uint16_t nominal[] = {1650, 1024, 2900};
+    return nominal[channel] + (furi_hal_random_get() & 0x7);
+}
+
+float furi_hal_power_get_battery_voltage(FuriHalPowerIC ic) {
+    UNUSED(ic);
+    return 4.1f;
+}
+
+float furi_hal_power_get_battery_current(FuriHalPowerIC ic) {
+    UNUSED(ic);
+    return -0.05f;
+}
+
+float furi_hal_power_get_battery_temperature(FuriHalPowerIC ic) {
+    UNUSED(ic);
+    return 25.0f;
+}
+
+uint8_t furi_hal_power_get_pct(void) {
+    return 100;
+}
+
+// Light
+void furi_hal_light_set(Light light, uint8_t value) {
+    UNUSED(light);
+    UNUSED(value);
+}
+
+// Infrared
+bool furi_hal_infrared_is_busy(void) {
+    return false;
+}
+
+// SubGHz: no radio, every frequency is reported as blocked, until an RSSI
+// trace is loaded; then the CC1101 bands are valid and RX readings replay
+// the trace in order (wrapping at the end)
+const uint8_t subghz_device_cc1101_preset_ook_650khz_async_regs[] = {0, 0};
+
+typedef struct {
+    float rssi;
+    uint8_t lqi;
+} FuriHalSubGhzHostReading;
+
+static struct {
+    FuriHalSubGhzHostReading* readings;
+    size_t count;
+    size_t next;
+    size_t reads;
+    bool rx;
+    bool asleep;
+} furi_hal_subghz_host = {.asleep = true};
+
+bool furi_hal_subghz_host_load_trace(const char* path) {
+    furi_hal_subghz_host_unload_trace();
+
+    FILE* file = fopen(path, "r");
+    if(!file) return false;
+
+    size_t capacity = 0;
+    char line[128];
+    while(fgets(line, sizeof(line), file)) {
+        float rssi;
+        unsigned lqi;
+        if(line[0] == '#' || sscanf(line, "%f,%u", &rssi, &lqi) != 2) continue;
+
+        if(furi_hal_subghz_host.count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            furi_hal_subghz_host.readings =
+                realloc(furi_hal_subghz_host.readings, capacity * sizeof(FuriHalSubGhzHostReading));
+            furi_check(furi_hal_subghz_host.readings);
+        }
+        furi_hal_subghz_host.readings[furi_hal_subghz_host.count].rssi = rssi;
+        furi_hal_subghz_host.readings[furi_hal_subghz_host.count].lqi = (uint8_t)lqi;
+        furi_hal_subghz_host.count++;
+    }
+    fclose(file);
+
+    if(furi_hal_subghz_host.count == 0) {
+        furi_hal_subghz_host_unload_trace();
+        return false;
+    }
+    return true;
+}
+
+void furi_hal_subghz_host_unload_trace(void) {
+    free(furi_hal_subghz_host.readings);
+    furi_hal_subghz_host.readings = NULL;
+    furi_hal_subghz_host.count = 0;
+    furi_hal_subghz_host.next = 0;
+    furi_hal_subghz_host.reads = 0;
+}
+
+size_t furi_hal_subghz_host_trace_reads(void) {
+    return furi_hal_subghz_host.reads;
+}
+
+bool furi_hal_subghz_host_is_asleep(void) {
+    return furi_hal_subghz_host.asleep;
+}
+
+void furi_hal_subghz_reset(void) {
+    furi_hal_subghz_host.rx = false;
+    furi_hal_subghz_host.asleep = true;
+}
+
+void furi_hal_subghz_sleep(void) {
+    furi_hal_subghz_host.rx = false;
+    furi_hal_subghz_host.asleep = true;
+}
+
+void furi_hal_subghz_idle(void) {
+    furi_hal_subghz_host.rx = false;
+    furi_hal_subghz_host.asleep = false;
+}
+
+void furi_hal_subghz_rx(void) {
+    furi_hal_subghz_host.rx = true;
+    furi_hal_subghz_host.asleep = false;
+}
+
+void furi_hal_subghz_load_custom_preset(const uint8_t* preset_data) {
+    UNUSED(preset_data);
+}
+
+void furi_hal_subghz_load_registers(const uint8_t* data) {
+    UNUSED(data);
+}
+
+bool furi_hal_subghz_is_frequency_valid(uint32_t value) {
+    if(!furi_hal_subghz_host.count) return false;
+    // CC1101 bands
+    return (value >= 300000000 && value <= 348000000) || (value >= 387000000 && value <= 464000000) ||
+           (value >= 779000000 && value <= 928000000);
+}
+
+uint32_t furi_hal_subghz_set_frequency(uint32_t value) {
+    return furi_hal_subghz_is_frequency_valid(value) ? value : 0;
+}
+
+static const FuriHalSubGhzHostReading* furi_hal_subghz_host_current(void) {
+    if(!furi_hal_subghz_host.count || !furi_hal_subghz_host.rx) return NULL;
+    return &furi_hal_subghz_host.readings[furi_hal_subghz_host.next % furi_hal_subghz_host.count];
+}
+
+float furi_hal_subghz_get_rssi(void) {
+    const FuriHalSubGhzHostReading* reading = furi_hal_subghz_host_current();
+    return reading ? reading->rssi : -100.0f;
+}
+
+// The collector reads RSSI then LQI, so LQI completes a reading
+uint8_t furi_hal_subghz_get_lqi(void) {
+    const FuriHalSubGhzHostReading* reading = furi_hal_subghz_host_current();
+    if(!reading) return 0;
+    furi_hal_subghz_host.next++;
+    furi_hal_subghz_host.reads++;
+    return reading->lqi;
+}
+
+// Serial: writes go straight to the attached file descriptor
+struct FuriHalSerialHandle {
+    FuriHalSerialId id;
+    int fd;
+    uint32_t baud;
+    bool acquired;
+
+    // Paced TX: each write returns once its bytes would be off the wire at baud
+    bool paced;
+    uint64_t line_free_ns;
+
+    // Async RX: a reader thread stands in for the RXNE interrupt
+    pthread_t rx_thread;
+    atomic_bool rx_running;
+    FuriHalSerialAsyncRxCallback rx_callback;
+    void* rx_context;
+    uint8_t rx_buffer[64];
+    size_t rx_length;
+    size_t rx_pos;
+};
+
+static FuriHalSerialHandle furi_hal_serial_host_handles[FuriHalSerialIdMax] = {
+    {.id = FuriHalSerialIdUsart, .fd = -1},
+    {.id = FuriHalSerialIdLpuart, .fd = -1},
+};
+
+void furi_hal_serial_host_attach_fd(FuriHalSerialId serial_id, int fd) {
+    furi_check(serial_id < FuriHalSerialIdMax);
+    furi_hal_serial_host_handles[serial_id].fd = fd;
+}
+
+void furi_hal_serial_host_set_paced(FuriHalSerialId serial_id, bool paced) {
+    furi_check(serial_id < FuriHalSerialIdMax);
+    furi_hal_serial_host_handles[serial_id].paced = paced;
+    furi_hal_serial_host_handles[serial_id].line_free_ns = 0;
+}
+
+uint32_t furi_hal_serial_host_get_baud(FuriHalSerialId serial_id) {
+    furi_check(serial_id < FuriHalSerialIdMax);
+    return furi_hal_serial_host_handles[serial_id].baud;
+}
+
+static uint64_t furi_hal_serial_host_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Block like the USART busy-wait does: 8N1 is 10 bit times per byte
+static void furi_hal_serial_host_pace(FuriHalSerialHandle* handle, size_t size) {
+    if(!handle->paced || !handle->baud) return;
+    uint64_t now = furi_hal_serial_host_now_ns();
+    if(handle->line_free_ns < now) handle->line_free_ns = now;
+    handle->line_free_ns += (uint64_t)size * 10 * 1000000000ull / handle->baud;
+
+    struct timespec until = {
+        .tv_sec = (time_t)(handle->line_free_ns / 1000000000ull),
+        .tv_nsec = (long)(handle->line_free_ns % 1000000000ull),
+    };
+    while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, NULL) == EINTR) {
+    }
+}
+
+FuriHalSerialHandle* furi_hal_serial_control_acquire(FuriHalSerialId serial_id) {
+    furi_check(serial_id < FuriHalSerialIdMax);
+    FuriHalSerialHandle* handle = &furi_hal_serial_host_handles[serial_id];
+    if(handle->acquired) return NULL;
+    handle->acquired = true;
+    return handle;
+}
+
+void furi_hal_serial_control_release(FuriHalSerialHandle* handle) {
+    furi_check(handle);
+    handle->acquired = false;
+}
+
+void furi_hal_serial_init(FuriHalSerialHandle* handle, uint32_t baud) {
+    furi_check(handle);
+    handle->baud = baud;
+}
+
+void furi_hal_serial_deinit(FuriHalSerialHandle* handle) {
+    UNUSED(handle);
+}
+
+void furi_hal_serial_set_br(FuriHalSerialHandle* handle, uint32_t baud) {
+    furi_check(handle);
+    handle->baud = baud;
+}
+
+void furi_hal_serial_tx(FuriHalSerialHandle* handle, const uint8_t* buffer, size_t buffer_size) {
+    furi_check(handle);
+    if(handle->fd < 0) return;
+
+    size_t offset = 0;
+    while(offset < buffer_size) {
+        ssize_t written = write(handle->fd, buffer + offset, buffer_size - offset);
+        if(written < 0) {
+            if(errno == EINTR || errno == EAGAIN) continue;
+            return;
+        }
+        offset += (size_t)written;
+    }
+    furi_hal_serial_host_pace(handle, buffer_size);
+}
+
+void furi_hal_serial_tx_wait_complete(FuriHalSerialHandle* handle) {
+    UNUSED(handle);
+}
+
+static void* furi_hal_serial_host_rx_thread(void* context) {
+    FuriHalSerialHandle* handle = context;
+    while(atomic_load(&handle->rx_running)) {
+        struct pollfd pfd = {.fd = handle->fd, .events = POLLIN};
+        if(poll(&pfd, 1, 10) <= 0) continue;
+
+        // A pty master reports EIO while no one has the slave open
+        ssize_t got = read(handle->fd, handle->rx_buffer, sizeof(handle->rx_buffer));
+        if(got <= 0) {
+            usleep(1000);
+            continue;
+        }
+        handle->rx_length = (size_t)got;
+        handle->rx_pos = 0;
+        handle->rx_callback(handle, FuriHalSerialRxEventData, handle->rx_context);
+    }
+    return NULL;
+}
+
+void furi_hal_serial_async_rx_start(
+    FuriHalSerialHandle* handle,
+    FuriHalSerialAsyncRxCallback callback,
+    void* context,
+    bool report_errors) {
+    UNUSED(report_errors);
+    furi_check(handle && callback && handle->fd >= 0 && !atomic_load(&handle->rx_running));
+    handle->rx_callback = callback;
+    handle->rx_context = context;
+    handle->rx_length = 0;
+    handle->rx_pos = 0;
+    atomic_store(&handle->rx_running, true);
+    furi_check(pthread_create(&handle->rx_thread, NULL, furi_hal_serial_host_rx_thread, handle) == 0);
+}
+
+void furi_hal_serial_async_rx_stop(FuriHalSerialHandle* handle) {
+    furi_check(handle);
+    if(!atomic_exchange(&handle->rx_running, false)) return;
+    pthread_join(handle->rx_thread, NULL);
+    handle->rx_callback = NULL;
+}
+
+bool furi_hal_serial_async_rx_available(FuriHalSerialHandle* handle) {
+    return handle->rx_pos < handle->rx_length;
+}
+
+uint8_t furi_hal_serial_async_rx(FuriHalSerialHandle* handle) {
+    furi_check(handle->rx_pos < handle->rx_length);
+    return handle->rx_buffer[handle->rx_pos++];
+}
@@ -0,0 +1,371 @@
+/**
+ * Host implementation of the Furi core shim
+ * Mutexes, semaphores and threads map onto pthreads, ticks onto CLOCK_MONOTONIC (1 tick = 1 ms).
+ */
+
+#define _GNU_SOURCE
+#include <furi.h>
+#include <furi_hal_cortex.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+
+static FuriLogLevel furi_host_log_level = FuriLogLevelDefault;
+
+static FuriLogLevel furi_host_get_log_level(void) {
+    if(furi_host_log_level == FuriLogLevelDefault) {
+        // ENTROPYLAB_HOST_LOG=debug|info|warn|error|none, errors only by default
+        const char* env = getenv("ENTROPYLAB_HOST_LOG");
+        FuriLogLevel level = FuriLogLevelError;
+        if(env) {
+            if(strcmp(env, "none") == 0) level = FuriLogLevelNone;
+            else if(strcmp(env, "warn") == 0) level = FuriLogLevelWarn;
+            else if(strcmp(env, "info") == 0) level = FuriLogLevelInfo;
+            else if(strcmp(env, "debug") == 0) level = FuriLogLevelDebug;
+            else if(strcmp(env, "trace") == 0) level = FuriLogLevelTrace;
+        }
+        furi_host_log_level = level;
+    }
+    return furi_host_log_level;
+}
+
+void furi_log_set_level(FuriLogLevel level) {
+    furi_host_log_level = level;
+}
+
+void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
+    if(level > furi_host_get_log_level()) return;
+
+    static const char level_chars[] = {' ', ' ', 'E', 'W', 'I', 'D', 'T'};
+    char line[512];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    fprintf(stderr, "%lu [%c][%s] %s\n", (unsigned long)furi_get_tick(), level_chars[level], tag, line);
+}
+
+// Time
+static uint64_t furi_host_monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+uint32_t furi_get_tick(void) {
+    return (uint32_t)(furi_host_monotonic_ns() / 1000000ULL);
+}
+
+uint32_t furi_kernel_get_tick_frequency(void) {
+    return 1000;
+}
+
+void furi_thread_yield(void) {
+    sched_yield();
+}
+
+void furi_delay_tick(uint32_t ticks) {
+    furi_delay_ms(ticks);
+}
+
+void furi_delay_ms(uint32_t milliseconds) {
+    struct timespec ts = {
+        .tv_sec = milliseconds / 1000,
+        .tv_nsec = (long)(milliseconds % 1000) * 1000000L,
+    };
+    while(nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+}
+
+void furi_delay_us(uint32_t microseconds) {
+    furi_hal_cortex_delay_us(microseconds);
+}
+
+// Cortex
+static FuriHostDwt furi_host_dwt;
+
+FuriHostDwt* furi_hal_cortex_host_dwt(void) {
+    // ns * 64 / 1000 == cycles at 64 MHz, wraps at 32 bits just like the real counter
+    furi_host_dwt.CYCCNT = (uint32_t)((furi_host_monotonic_ns() * 64ULL) / 1000ULL);
+    return &furi_host_dwt;
+}
+
+void furi_hal_cortex_delay_us(uint32_t microseconds) {
+    uint64_t end = furi_host_monotonic_ns() + (uint64_t)microseconds * 1000ULL;
+    if(microseconds >= 1000) {
+        furi_delay_ms(microseconds / 1000);
+    }
+    while(furi_host_monotonic_ns() < end) {
+    }
+}
+
+uint32_t furi_hal_cortex_instructions_per_microsecond(void) {
+    return FURI_HAL_CORTEX_HOST_CLOCK_HZ / 1000000U;
+}
+
+FuriHalCortexTimer furi_hal_cortex_timer_get(uint32_t timeout_us) {
+    FuriHalCortexTimer timer = {
+        .start = DWT->CYCCNT,
+        .value = timeout_us * furi_hal_cortex_instructions_per_microsecond(),
+    };
+    return timer;
+}
+
+bool furi_hal_cortex_timer_is_expired(FuriHalCortexTimer cortex_timer) {
+    return (DWT->CYCCNT - cortex_timer.start) >= cortex_timer.value;
+}
+
+void furi_hal_cortex_timer_wait(FuriHalCortexTimer cortex_timer) {
+    while(!furi_hal_cortex_timer_is_expired(cortex_timer)) {
+    }
+}
+
+// Mutex
+struct FuriMutex {
+    pthread_mutex_t mutex;
+};
+
+FuriMutex* furi_mutex_alloc(FuriMutexType type) {
+    FuriMutex* instance = malloc(sizeof(FuriMutex));
+    furi_check(instance);
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(
+        &attr,
+        type == FuriMutexTypeRecursive ? PTHREAD_MUTEX_RECURSIVE : PTHREAD_MUTEX_ERRORCHECK);
+    pthread_mutex_init(&instance->mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    return instance;
+}
+
+void furi_mutex_free(FuriMutex* instance) {
+    furi_assert(instance);
+    pthread_mutex_destroy(&instance->mutex);
+    free(instance);
+}
+
+FuriStatus furi_mutex_acquire(FuriMutex* instance, uint32_t timeout) {
+    furi_assert(instance);
+    int ret;
+
+    if(timeout == FuriWaitForever) {
+        ret = pthread_mutex_lock(&instance->mutex);
+    } else if(timeout == 0) {
+        ret = pthread_mutex_trylock(&instance->mutex);
+    } else {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += timeout / 1000;
+        deadline.tv_nsec += (long)(timeout % 1000) * 1000000L;
+        if(deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        ret = pthread_mutex_timedlock(&instance->mutex, &deadline);
+    }
+
+    if(ret == 0) return FuriStatusOk;
+    if(ret == ETIMEDOUT || ret == EBUSY) return FuriStatusErrorTimeout;
+    return FuriStatusErrorResource;
+}
+
+FuriStatus furi_mutex_release(FuriMutex* instance) {
+    furi_assert(instance);
+    // Error-checking mutex: releasing an unowned mutex reports instead of corrupting state
+    return pthread_mutex_unlock(&instance->mutex) == 0 ? FuriStatusOk : FuriStatusErrorResource;
+}
+
+// Semaphore: counter guarded by a mutex/condvar pair
+struct FuriSemaphore {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t count;
+    uint32_t max_count;
+};
+
+FuriSemaphore* furi_semaphore_alloc(uint32_t max_count, uint32_t initial_count) {
+    furi_check(max_count > 0 && initial_count <= max_count);
+    FuriSemaphore* instance = malloc(sizeof(FuriSemaphore));
+    furi_check(instance);
+    pthread_mutex_init(&instance->mutex, NULL);
+    pthread_cond_init(&instance->cond, NULL);
+    instance->count = initial_count;
+    instance->max_count = max_count;
+    return instance;
+}
+
+void furi_semaphore_free(FuriSemaphore* instance) {
+    furi_assert(instance);
+    pthread_cond_destroy(&instance->cond);
+    pthread_mutex_destroy(&instance->mutex);
+    free(instance);
+}
+
+FuriStatus furi_semaphore_acquire(FuriSemaphore* instance, uint32_t timeout) {
+    furi_assert(instance);
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) {
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += timeout / 1000;
+        deadline.tv_nsec += (long)(timeout % 1000) * 1000000L;
+        if(deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    FuriStatus status = FuriStatusOk;
+    pthread_mutex_lock(&instance->mutex);
+    while(instance->count == 0) {
+        if(timeout == 0) {
+            status = FuriStatusErrorResource;
+            break;
+        }
+        int ret = (timeout == FuriWaitForever) ?
+                      pthread_cond_wait(&instance->cond, &instance->mutex) :
+                      pthread_cond_timedwait(&instance->cond, &instance->mutex, &deadline);
+        if(ret == ETIMEDOUT) {
+            status = FuriStatusErrorTimeout;
+            break;
+        }
+    }
+    if(status == FuriStatusOk) instance->count--;
+    pthread_mutex_unlock(&instance->mutex);
+    return status;
+}
+
+FuriStatus furi_semaphore_release(FuriSemaphore* instance) {
+    furi_assert(instance);
+    FuriStatus status = FuriStatusOk;
+    pthread_mutex_lock(&instance->mutex);
+    if(instance->count < instance->max_count) {
+        instance->count++;
+        pthread_cond_signal(&instance->cond);
+    } else {
+        status = FuriStatusErrorResource;
+    }
+    pthread_mutex_unlock(&instance->mutex);
+    return status;
+}
+
+uint32_t furi_semaphore_get_count(FuriSemaphore* instance) {
+    furi_assert(instance);
+    pthread_mutex_lock(&instance->mutex);
+    uint32_t count = instance->count;
+    pthread_mutex_unlock(&instance->mutex);
+    return count;
+}
+
+// Thread
+struct FuriThread {
+    pthread_t thread;
+    char name[32];
+    FuriThreadCallback callback;
+    void* context;
+    volatile FuriThreadState state;
+    int32_t return_code;
+    bool joinable;
+};
+
+FuriThread* furi_thread_alloc(void) {
+    FuriThread* thread = calloc(1, sizeof(FuriThread));
+    furi_check(thread);
+    thread->state = FuriThreadStateStopped;
+    return thread;
+}
+
+FuriThread* furi_thread_alloc_ex(
+    const char* name,
+    uint32_t stack_size,
+    FuriThreadCallback callback,
+    void* context) {
+    FuriThread* thread = furi_thread_alloc();
+    furi_thread_set_name(thread, name);
+    furi_thread_set_stack_size(thread, stack_size);
+    furi_thread_set_callback(thread, callback);
+    furi_thread_set_context(thread, context);
+    return thread;
+}
+
+void furi_thread_free(FuriThread* thread) {
+    furi_assert(thread);
+    if(thread->joinable) {
+        furi_thread_join(thread);
+    }
+    free(thread);
+}
+
+void furi_thread_set_name(FuriThread* thread, const char* name) {
+    snprintf(thread->name, sizeof(thread->name), "%s", name ? name : "");
+}
+
+void furi_thread_set_stack_size(FuriThread* thread, size_t stack_size) {
+    // Host threads get the default pthread stack, far larger than any firmware stack
+    UNUSED(thread);
+    UNUSED(stack_size);
+}
+
+void furi_thread_set_priority(FuriThread* thread, FuriThreadPriority priority) {
+    // Host threads share the default scheduling policy, which has no priorities to set
+    UNUSED(thread);
+    UNUSED(priority);
+}
+
+void furi_thread_set_callback(FuriThread* thread, FuriThreadCallback callback) {
+    thread->callback = callback;
+}
+
+void furi_thread_set_context(FuriThread* thread, void* context) {
+    thread->context = context;
+}
+
+static void* furi_thread_body(void* context) {
+    FuriThread* thread = context;
+    thread->state = FuriThreadStateRunning;
+    thread->return_code = thread->callback(thread->context);
+    thread->state = FuriThreadStateStopped;
+    return NULL;
+}
+
+void furi_thread_start(FuriThread* thread) {
+    furi_assert(thread);
+    furi_assert(thread->callback);
+    furi_assert(!thread->joinable);
+
+    thread->state = FuriThreadStateStarting;
+    furi_check(pthread_create(&thread->thread, NULL, furi_thread_body, thread) == 0);
+    thread->joinable = true;
+}
+
+bool furi_thread_join(FuriThread* thread) {
+    furi_assert(thread);
+    if(thread->joinable) {
+        pthread_join(thread->thread, NULL);
+        thread->joinable = false;
+    }
+    return true;
+}
+
+FuriThreadState furi_thread_get_state(FuriThread* thread) {
+    return thread->state;
+}
+
+int32_t furi_thread_get_return_code(FuriThread* thread) {
+    return thread->return_code;
+}
+
+// Records: only storage is meaningful on the host, everything else gets a dummy handle
+static char furi_host_record_dummy;
+
+void* furi_record_open(const char* name) {
+    UNUSED(name);
+    return &furi_host_record_dummy;
+}
+
+void furi_record_close(const char* name) {
+    UNUSED(name);
+}
@@ -0,0 +1,97 @@
+/**
+ * Host implementation of the infrared worker shim
+ * Nothing is received on its own; the harness injects signals, which are
+ * delivered synchronously on the caller's thread like the firmware's IR worker thread.
+ */
+
+#include <furi.h>
+#include <infrared_worker.h>
+
+#define INFRARED_HOST_MAX_TIMINGS 512
+
+struct InfraredWorkerSignal {
+    bool decoded;
+    InfraredMessage message;
+    const uint32_t* timings;
+    size_t timings_cnt;
+};
+
+struct InfraredWorker {
+    InfraredWorkerReceivedSignalCallback callback;
+    void* context;
+    bool running;
+    bool decoding;
+};
+
+InfraredWorker* infrared_worker_alloc(void) {
+    InfraredWorker* instance = calloc(1, sizeof(InfraredWorker));
+    furi_check(instance);
+    return instance;
+}
+
+void infrared_worker_free(InfraredWorker* instance) {
+    furi_check(instance);
+    free(instance);
+}
+
+void infrared_worker_rx_start(InfraredWorker* instance) {
+    instance->running = true;
+}
+
+void infrared_worker_rx_stop(InfraredWorker* instance) {
+    instance->running = false;
+}
+
+void infrared_worker_rx_set_received_signal_callback(
+    InfraredWorker* instance,
+    InfraredWorkerReceivedSignalCallback callback,
+    void* context) {
+    instance->callback = callback;
+    instance->context = context;
+}
+
+void infrared_worker_rx_enable_blink_on_receiving(InfraredWorker* instance, bool enable) {
+    UNUSED(instance);
+    UNUSED(enable);
+}
+
+void infrared_worker_rx_enable_signal_decoding(InfraredWorker* instance, bool enable) {
+    instance->decoding = enable;
+}
+
+bool infrared_worker_signal_is_decoded(const InfraredWorkerSignal* signal) {
+    return signal->decoded;
+}
+
+const InfraredMessage* infrared_worker_get_decoded_signal(const InfraredWorkerSignal* signal) {
+    return signal->decoded ? &signal->message : NULL;
+}
+
+void infrared_worker_get_raw_signal(
+    const InfraredWorkerSignal* signal,
+    const uint32_t** timings,
+    size_t* timings_cnt) {
+    *timings = signal->timings;
+    *timings_cnt = signal->timings_cnt;
+}
+
+void infrared_worker_host_inject_raw(InfraredWorker* instance, const uint32_t* timings, size_t timings_cnt) {
+    if(!instance->running || !instance->callback) return;
+
+    InfraredWorkerSignal signal = {
+        .decoded = false,
+        .timings = timings,
+        .timings_cnt = timings_cnt > INFRARED_HOST_MAX_TIMINGS ? INFRARED_HOST_MAX_TIMINGS : timings_cnt,
+    };
+    instance->callback(instance->context, &signal);
+}
+
+void infrared_worker_host_inject_decoded(InfraredWorker* instance, const InfraredMessage* message) {
+    if(!instance->running || !instance->callback) return;
+
+    InfraredWorkerSignal signal = {
+        .decoded = true,
+        .message = *message,
+    };
+    instance->callback(instance->context, &signal);
+}
@@ -0,0 +1,263 @@
+/**
+ * Host implementation of the storage shim
+ * Firmware paths are rebased onto a host directory:
+ *   /ext/... -> $ENTROPYLAB_HOST_EXT/...  (default "./ext")
+ *   /int/... -> $ENTROPYLAB_HOST_INT/...  (default "./int")
+ */
+
+#define _GNU_SOURCE
+#include <storage/storage.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <stdatomic.h>
+
+struct File {
+    int fd;
+    FS_Error error;
+};
+
+static atomic_uint_fast64_t storage_host_calls;
+static atomic_uint_fast64_t storage_host_write_budget = UINT64_MAX;
+
+uint64_t storage_host_io_calls(void) {
+    return atomic_load(&storage_host_calls);
+}
+
+void storage_host_set_write_budget(uint64_t bytes) {
+    atomic_store(&storage_host_write_budget, bytes);
+}
+
+static bool storage_host_path(const char* path, char* out, size_t out_size) {
+    const char* root = NULL;
+    const char* rest = NULL;
+
+    if(strncmp(path, "/ext", 4) == 0 && (path[4] == '/' || path[4] == '\0')) {
+        root = getenv("ENTROPYLAB_HOST_EXT");
+        if(!root) root = "ext";
+        rest = path + 4;
+    } else if(strncmp(path, "/int", 4) == 0 && (path[4] == '/' || path[4] == '\0')) {
+        root = getenv("ENTROPYLAB_HOST_INT");
+        if(!root) root = "int";
+        rest = path + 4;
+    } else {
+        return false;
+    }
+
+    int len = snprintf(out, out_size, "%s%s", root, rest);
+    return len > 0 && (size_t)len < out_size;
+}
+
+static FS_Error storage_host_errno(int err) {
+    switch(err) {
+    case ENOENT:
+        return FSE_NOT_EXIST;
+    case EEXIST:
+        return FSE_EXIST;
+    case EACCES:
+    case EPERM:
+        return FSE_DENIED;
+    case EINVAL:
+        return FSE_INVALID_PARAMETER;
+    case ENAMETOOLONG:
+        return FSE_INVALID_NAME;
+    default:
+        return FSE_INTERNAL;
+    }
+}
+
+File* storage_file_alloc(Storage* storage) {
+    UNUSED(storage);
+    File* file = malloc(sizeof(File));
+    furi_check(file);
+    file->fd = -1;
+    file->error = FSE_OK;
+    return file;
+}
+
+void storage_file_free(File* file) {
+    if(!file) return;
+    if(file->fd >= 0) {
+        storage_file_close(file);
+    }
+    free(file);
+}
+
+bool storage_file_open(File* file, const char* path, FS_AccessMode access_mode, FS_OpenMode open_mode) {
+    furi_check(file);
+    char host_path[PATH_MAX];
+    if(file->fd >= 0) {
+        file->error = FSE_ALREADY_OPEN;
+        return false;
+    }
+    if(!path || !storage_host_path(path, host_path, sizeof(host_path))) {
+        file->error = FSE_INVALID_NAME;
+        return false;
+    }
+
+    int flags = 0;
+    if((access_mode & FSAM_READ_WRITE) == FSAM_READ_WRITE) {
+        flags = O_RDWR;
+    } else if(access_mode & FSAM_WRITE) {
+        flags = O_WRONLY;
+    } else {
+        flags = O_RDONLY;
+    }
+
+    switch(open_mode) {
+    case FSOM_OPEN_EXISTING:
+        break;
+    case FSOM_OPEN_ALWAYS:
+        flags |= O_CREAT;
+        break;
+    case FSOM_OPEN_APPEND:
+        flags |= O_CREAT | O_APPEND;
+        break;
+    case FSOM_CREATE_NEW:
+        flags |= O_CREAT | O_EXCL;
+        break;
+    case FSOM_CREATE_ALWAYS:
+        flags |= O_CREAT | O_TRUNC;
+        break;
+    }
+
+    file->fd = open(host_path, flags | O_CLOEXEC, 0644);
+    if(file->fd < 0) {
+        file->error = storage_host_errno(errno);
+        return false;
+    }
+    file->error = FSE_OK;
+    return true;
+}
+
+bool storage_file_close(File* file) {
+    furi_check(file);
+    if(file->fd < 0) return false;
+    close(file->fd);
+    file->fd = -1;
+    return true;
+}
+
+bool storage_file_is_open(File* file) {
+    return file && file->fd >= 0;
+}
+
+size_t storage_file_read(File* file, void* buff, size_t bytes_to_read) {
+    furi_check(file);
+    atomic_fetch_add(&storage_host_calls, 1);
+    if(file->fd < 0) return 0;
+
+    ssize_t got = read(file->fd, buff, bytes_to_read);
+    if(got < 0) {
+        file->error = storage_host_errno(errno);
+        return 0;
+    }
+    return (size_t)got;
+}
+
+size_t storage_file_write(File* file, const void* buff, size_t bytes_to_write) {
+    furi_check(file);
+    atomic_fetch_add(&storage_host_calls, 1);
+    if(file->fd < 0) return 0;
+
+    uint64_t budget = atomic_load(&storage_host_write_budget);
+    if(budget != UINT64_MAX) {
+        if(bytes_to_write > budget) {
+            bytes_to_write = (size_t)budget;
+            file->error = FSE_INTERNAL;
+        }
+        atomic_fetch_sub(&storage_host_write_budget, bytes_to_write);
+    }
+
+    size_t offset = 0;
+    while(offset < bytes_to_write) {
+        ssize_t written = write(file->fd, (const uint8_t*)buff + offset, bytes_to_write - offset);
+        if(written < 0) {
+            if(errno == EINTR) continue;
+            file->error = storage_host_errno(errno);
+            break;
+        }
+        offset += (size_t)written;
+    }
+    return offset;
+}
+
+bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    furi_check(file);
+    if(file->fd < 0) return false;
+    off_t ret = lseek(file->fd, (off_t)offset, from_start ? SEEK_SET : SEEK_CUR);
+    return ret >= 0;
+}
+
+uint64_t storage_file_tell(File* file) {
+    furi_check(file);
+    if(file->fd < 0) return 0;
+    off_t pos = lseek(file->fd, 0, SEEK_CUR);
+    return pos < 0 ? 0 : (uint64_t)pos;
+}
+
+uint64_t storage_file_size(File* file) {
+    furi_check(file);
+    struct stat st;
+    if(file->fd < 0 || fstat(file->fd, &st) != 0) return 0;
+    return (uint64_t)st.st_size;
+}
+
+bool storage_file_sync(File* file) {
+    furi_check(file);
+    return file->fd >= 0 && fsync(file->fd) == 0;
+}
+
+bool storage_file_eof(File* file) {
+    return storage_file_tell(file) >= storage_file_size(file);
+}
+
+FS_Error storage_file_get_error(File* file) {
+    return file ? file->error : FSE_INVALID_PARAMETER;
+}
+
+bool storage_file_exists(Storage* storage, const char* path) {
+    FileInfo info;
+    return storage_common_stat(storage, path, &info) == FSE_OK && !(info.flags & FSF_DIRECTORY);
+}
+
+FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo) {
+    UNUSED(storage);
+    char host_path[PATH_MAX];
+    if(!path || !storage_host_path(path, host_path, sizeof(host_path))) return FSE_INVALID_NAME;
+
+    struct stat st;
+    if(stat(host_path, &st) != 0) return storage_host_errno(errno);
+    if(fileinfo) {
+        fileinfo->flags = S_ISDIR(st.st_mode) ? FSF_DIRECTORY : 0;
+        fileinfo->size = (uint64_t)st.st_size;
+    }
+    return FSE_OK;
+}
+
+FS_Error storage_common_timestamp(Storage* storage, const char* path, uint32_t* timestamp) {
+    UNUSED(storage);
+    char host_path[PATH_MAX];
+    if(!path || !storage_host_path(path, host_path, sizeof(host_path))) return FSE_INVALID_NAME;
+
+    struct stat st;
+    if(stat(host_path, &st) != 0) return storage_host_errno(errno);
+    if(timestamp) *timestamp = (uint32_t)st.st_mtime;
+    return FSE_OK;
+}
+
+FS_Error storage_common_remove(Storage* storage, const char* path) {
+    UNUSED(storage);
+    char host_path[PATH_MAX];
+    if(!path || !storage_host_path(path, host_path, sizeof(host_path))) return FSE_INVALID_NAME;
+    return (unlink(host_path) == 0 || rmdir(host_path) == 0) ? FSE_OK : storage_host_errno(errno);
+}
+
+bool storage_simply_mkdir(Storage* storage, const char* path) {
+    UNUSED(storage);
+    char host_path[PATH_MAX];
+    if(!path || !storage_host_path(path, host_path, sizeof(host_path))) return false;
+    return mkdir(host_path, 0755) == 0 || errno == EEXIST;
+}
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""
+Client for Entropy Lab pull mode (UART Format: Pull)
+
+The device keeps a reservoir of random bytes and only sends what is asked
+for. A request is a frame (see frame_decoder.py) whose payload is
+[command u8][count u16 LE]; the answer is count bytes in ordinary frames.
+
+    python3 pull_client.py /dev/ttyUSB0 -n 4096 -o random.bin
+    python3 pull_client.py /dev/ttyUSB0 -n 32 --repeat 100   # latency per request
+"""
+
+import argparse
+import os
+import select
+import struct
+import sys
+import termios
+import time
+import tty
+import zlib
+
+from frame_decoder import FrameDecoder, describe_flags, FLAGS_UNHEALTHY, FLAG_REJECTED
+
+COMMAND_READ = 0x01
+MAX_REQUEST = 0xFFFF
+
+BAUD_RATES = {
+    9600: termios.B9600,
+    19200: termios.B19200,
+    38400: termios.B38400,
+    57600: termios.B57600,
+    115200: termios.B115200,
+    230400: getattr(termios, "B230400", termios.B115200),
+    460800: getattr(termios, "B460800", termios.B115200),
+    921600: getattr(termios, "B921600", termios.B115200),
+    1000000: getattr(termios, "B1000000", termios.B115200),
+    2000000: getattr(termios, "B2000000", termios.B115200),
+    4000000: getattr(termios, "B4000000", termios.B115200),
+}
+
+
+def encode_request(seq, command, count):
+    """Request frame: the frame header, then [command][count]"""
+    body = struct.pack("<2sHHBBH", b"EL", seq & 0xFFFF, 3, 0, command, count)
+    return body + struct.pack("<I", zlib.crc32(body))
+
+
+class PullError(Exception):
+    pass
+
+
+class PullClient:
+    """Blocking pull-mode client, one request in flight at a time"""
+
+    def __init__(self, path, baud=115200, timeout=1.0, retries=3):
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        if os.isatty(self.fd):
+            # Raw 8N1: no echo, no line buffering, no CR/LF translation
+            tty.setraw(self.fd)
+            attrs = termios.tcgetattr(self.fd)
+            speed = BAUD_RATES.get(baud, termios.B115200)
+            attrs[4] = attrs[5] = speed
+            attrs[2] |= termios.CLOCAL | termios.CREAD
+            termios.tcsetattr(self.fd, termios.TCSANOW, attrs)
+            termios.tcflush(self.fd, termios.TCIOFLUSH)
+        self.timeout = timeout
+        self.retries = retries
+        self.decoder = FrameDecoder()
+        self.seq = 0
+        self.requests = 0
+        self.retried = 0
+        self.last_latency = 0.0
+        self.last_flags = 0
+
+    def close(self):
+        os.close(self.fd)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def _request(self, count):
+        os.write(self.fd, encode_request(self.seq, COMMAND_READ, count))
+        self.seq = (self.seq + 1) & 0xFFFF
+        self.requests += 1
+
+    def read(self, length):
+        """Return length random bytes; raises PullError if the device stops answering"""
+        data = bytearray()
+        flags = 0
+        retries = 0
+        start = time.monotonic()
+        while len(data) < length:
+            count = min(length - len(data), MAX_REQUEST)
+            target = len(data) + count
+            self._request(count)
+
+            # A lost frame only shows up as silence, so ask again for what is missing
+            while len(data) < target:
+                ready, _, _ = select.select([self.fd], [], [], self.timeout)
+                if not ready:
+                    break
+                chunk = os.read(self.fd, 4096)
+                if not chunk:
+                    raise PullError("device closed the connection")
+                for frame in self.decoder.feed(chunk):
+                    if frame.flags & FLAG_REJECTED:
+                        raise PullError("device rejected the request")
+                    # Late frames from a timed-out request can overshoot
+                    data.extend(frame.payload[:length - len(data)])
+                    flags |= frame.flags
+            if len(data) < target:
+                retries += 1
+                self.retried += 1
+                if retries > self.retries:
+                    raise PullError(f"timed out with {len(data)} of {length} bytes")
+
+        self.last_latency = time.monotonic() - start
+        self.last_flags = flags
+        return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Request random bytes from Entropy Lab in pull mode")
+    parser.add_argument("device", help="serial device (or pty from `entropylab_host pull`)")
+    parser.add_argument("-n", "--bytes", type=int, default=4096, help="bytes per request")
+    parser.add_argument("-r", "--repeat", type=int, default=1, help="number of requests")
+    parser.add_argument("-o", "--output", help="write the bytes here (default: latency report only)")
+    parser.add_argument("-b", "--baud", type=int, default=115200, help="serial baud rate")
+    args = parser.parse_args()
+
+    output = open(args.output, "wb") if args.output else None
+    latencies = []
+    try:
+        with PullClient(args.device, args.baud) as client:
+            for _ in range(args.repeat):
+                data = client.read(args.bytes)
+                latencies.append(client.last_latency)
+                if client.last_flags & FLAGS_UNHEALTHY:
+                    print(f"warning: {describe_flags(client.last_flags)}", file=sys.stderr)
+                if output:
+                    output.write(data)
+            decoder = client.decoder
+    except PullError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+    finally:
+        if output:
+            output.close()
+
+    latencies.sort()
+    total = args.bytes * len(latencies)
+    elapsed = sum(latencies)
+    print(f"{len(latencies)} requests of {args.bytes} bytes, {total / elapsed:.0f} B/s")
+    print(f"latency min {latencies[0] * 1000:.2f} ms, "
+          f"median {latencies[len(latencies) // 2] * 1000:.2f} ms, max {latencies[-1] * 1000:.2f} ms")
+    print(decoder.summary())
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
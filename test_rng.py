@@ -2,6 +2,8 @@
 """
 FlipperRNG Test Script
 Tests random data from FlipperRNG via USB CDC
+
+    python3 test_rng.py [socket]   # socket: read from entropy_server.py instead
 """
 
 import serial
@@ -86,8 +88,13 @@ def main():
     print("FlipperRNG Test Script")
     print("=====================")
 
-    # Find Flipper device
-    ser = find_flipper_device()
+    # With a socket path, share the device through entropy_server.py instead of opening it
+    if len(sys.argv) > 1:
+        from entropy_server import EntropyClient
+        print(f"Using entropy server at {sys.argv[1]}")
+        ser = EntropyClient(sys.argv[1])
+    else:
+        ser = find_flipper_device()
     if not ser:
         print("Error: Could not find Flipper device")
         print("Make sure:")
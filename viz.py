@@ -60,7 +60,7 @@ def pad_to_width(text, target_width):
         return pad_to_width(text, target_width)
     return text
 
-def smooth_emoji_art(port="/dev/ttyUSB0", baudrate=115200):
+def smooth_emoji_art(port="/dev/ttyUSB0", baudrate=115200, socket_path=None):
     """Smooth emoji art with no flickering"""
     
     # Get terminal size
@@ -114,11 +114,19 @@ def smooth_emoji_art(port="/dev/ttyUSB0", baudrate=115200):
     canvas_height = min(15, term_rows - 8)  # Leave space for UI
     
     print(f"🎨 Entropy Lab Visualizer")
-    print(f"📡 Connecting to {port} at {baudrate} baud...")
+    if socket_path:
+        print(f"📡 Connecting to entropy server at {socket_path}...")
+    else:
+        print(f"📡 Connecting to {port} at {baudrate} baud...")
     print(f"🖼️  Canvas: {canvas_width}x{canvas_height} (Terminal: {term_cols}x{term_rows})")
     
     try:
-        ser = serial.Serial(port, baudrate, timeout=2)
+        if socket_path:
+            # Shares the device with other tools through entropy_server.py
+            from entropy_server import EntropyClient
+            ser = EntropyClient(socket_path)
+        else:
+            ser = serial.Serial(port, baudrate, timeout=2)
         print(f"✅ Connected! Starting smooth emoji display...")
         time.sleep(2)
         
@@ -274,6 +282,7 @@ if __name__ == "__main__":
     parser = argparse.ArgumentParser(description="Entropy Lab - Visualize random data streams")
     parser.add_argument("--port", default="/dev/ttyUSB0", help="UART port")
     parser.add_argument("--baud", type=int, default=115200, help="Baud rate")
+    parser.add_argument("--socket", help="read from entropy_server.py at this socket instead of the UART")
     
     args = parser.parse_args()
     
@@ -284,4 +293,4 @@ if __name__ == "__main__":
     print("🎯 Smooth cursor-based updates")
     print("=" * 40)
     
-    sys.exit(smooth_emoji_art(args.port, args.baud))
+    sys.exit(smooth_emoji_art(args.port, args.baud, args.socket))